@@ -40,6 +40,10 @@ public class LayoutLensImporter : ModuleRules
 			{
 				"CoreUObject",
 				"Engine",
+				"MassEntity",
+				"MeshDescription",
+				"NavigationSystem",
+				"StaticMeshDescription",
 				"Slate",
 				"SlateCore",
 				// ... add private dependencies that you statically link with here ...	
@@ -47,6 +51,12 @@ public class LayoutLensImporter : ModuleRules
 			);
 		
 		
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("DerivedDataCache");
+		}
+
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
@@ -0,0 +1,267 @@
+#include "LayoutLensAabbTree.h"
+
+namespace
+{
+    const int32 MaxItemsPerLeaf = 4;
+}
+
+void FLayoutLensAabbTree::Reset()
+{
+    Nodes.Empty();
+    ItemIndices.Empty();
+}
+
+void FLayoutLensAabbTree::Build(const TArray<FBox2D>& ItemBounds)
+{
+    Reset();
+
+    if (ItemBounds.Num() == 0)
+    {
+        return;
+    }
+
+    ItemIndices.SetNumUninitialized(ItemBounds.Num());
+    for (int32 Item = 0; Item < ItemBounds.Num(); Item++)
+    {
+        ItemIndices[Item] = Item;
+    }
+
+    Nodes.Reserve(FMath::Max(4 * ItemBounds.Num() / MaxItemsPerLeaf, 1));
+    Nodes.AddDefaulted();
+    BuildNode(0, ItemBounds, 0, ItemBounds.Num());
+}
+
+void FLayoutLensAabbTree::BuildNode(int32 NodeIndex, const TArray<FBox2D>& ItemBounds, int32 FirstItem, int32 ItemCount)
+{
+    FBox2D Bounds(ForceInit);
+    FBox2D CentroidBounds(ForceInit);
+    for (int32 Offset = 0; Offset < ItemCount; Offset++)
+    {
+        const FBox2D& ItemBox = ItemBounds[ItemIndices[FirstItem + Offset]];
+        Bounds += ItemBox;
+        CentroidBounds += ItemBox.GetCenter();
+    }
+
+    Nodes[NodeIndex].Bounds = Bounds;
+    Nodes[NodeIndex].FirstItem = FirstItem;
+    Nodes[NodeIndex].ItemCount = ItemCount;
+
+    if (ItemCount <= MaxItemsPerLeaf)
+    {
+        return;
+    }
+
+    const FVector2D CentroidSize = CentroidBounds.GetSize();
+    const int32 Axis = CentroidSize.X >= CentroidSize.Y ? 0 : 1;
+
+    TArrayView<int32> Range(ItemIndices.GetData() + FirstItem, ItemCount);
+    Range.Sort([&ItemBounds, Axis](int32 A, int32 B)
+    {
+        return ItemBounds[A].GetCenter()[Axis] < ItemBounds[B].GetCenter()[Axis];
+    });
+
+    const int32 LeftCount = ItemCount / 2;
+
+    // Children are allocated as a pair so the second child is always FirstChild + 1.
+    const int32 FirstChild = Nodes.AddDefaulted(2);
+    Nodes[NodeIndex].FirstChild = FirstChild;
+
+    BuildNode(FirstChild, ItemBounds, FirstItem, LeftCount);
+    BuildNode(FirstChild + 1, ItemBounds, FirstItem + LeftCount, ItemCount - LeftCount);
+}
+
+void FLayoutLensAabbTree::QueryOverlaps(const FBox2D& Box, TArray<int32>& OutItems) const
+{
+    if (Nodes.Num() == 0)
+    {
+        return;
+    }
+
+    TArray<int32, TInlineAllocator<64>> Stack;
+    Stack.Add(0);
+
+    while (Stack.Num() > 0)
+    {
+        const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+
+        if (Node.Bounds.Min.X > Box.Max.X || Node.Bounds.Max.X < Box.Min.X ||
+            Node.Bounds.Min.Y > Box.Max.Y || Node.Bounds.Max.Y < Box.Min.Y)
+        {
+            continue;
+        }
+
+        if (Node.FirstChild == INDEX_NONE)
+        {
+            for (int32 Offset = 0; Offset < Node.ItemCount; Offset++)
+            {
+                OutItems.Add(ItemIndices[Node.FirstItem + Offset]);
+            }
+            continue;
+        }
+
+        Stack.Add(Node.FirstChild);
+        Stack.Add(Node.FirstChild + 1);
+    }
+}
+
+void FLayoutLensAabbTree::QueryPoint(const FVector2D& Point, TArray<int32>& OutItems) const
+{
+    QueryOverlaps(FBox2D(Point, Point), OutItems);
+}
+
+int32 FLayoutLensAabbTree::FindNearest(
+    const FVector2D& Point,
+    TFunctionRef<double(int32 Item)> DistanceSquared,
+    double& OutDistanceSquared) const
+{
+    int32 BestItem = INDEX_NONE;
+    OutDistanceSquared = TNumericLimits<double>::Max();
+
+    if (Nodes.Num() == 0)
+    {
+        return BestItem;
+    }
+
+    TArray<int32, TInlineAllocator<64>> Stack;
+    Stack.Add(0);
+
+    while (Stack.Num() > 0)
+    {
+        const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+
+        if (Node.Bounds.ComputeSquaredDistanceToPoint(Point) >= OutDistanceSquared)
+        {
+            continue;
+        }
+
+        if (Node.FirstChild == INDEX_NONE)
+        {
+            for (int32 Offset = 0; Offset < Node.ItemCount; Offset++)
+            {
+                const int32 Item = ItemIndices[Node.FirstItem + Offset];
+                const double ItemDistanceSquared = DistanceSquared(Item);
+                if (ItemDistanceSquared < OutDistanceSquared)
+                {
+                    OutDistanceSquared = ItemDistanceSquared;
+                    BestItem = Item;
+                }
+            }
+            continue;
+        }
+
+        // Push the farther child first so the nearer one is popped and tightens the bound before it.
+        const double FirstDistance = Nodes[Node.FirstChild].Bounds.ComputeSquaredDistanceToPoint(Point);
+        const double SecondDistance = Nodes[Node.FirstChild + 1].Bounds.ComputeSquaredDistanceToPoint(Point);
+        const bool bFirstNearer = FirstDistance <= SecondDistance;
+
+        Stack.Add(bFirstNearer ? Node.FirstChild + 1 : Node.FirstChild);
+        Stack.Add(bFirstNearer ? Node.FirstChild : Node.FirstChild + 1);
+    }
+
+    return BestItem;
+}
+
+bool FLayoutLensAabbTree::IntersectRay(const FBox2D& Box, const FVector& Origin, const FVector& Direction, double MaxT, double& OutEntryT)
+{
+    double EntryT = 0.0;
+    double ExitT = MaxT;
+
+    for (int32 Axis = 0; Axis < 2; Axis++)
+    {
+        const double AxisOrigin = Origin[Axis];
+        const double AxisDirection = Direction[Axis];
+
+        if (FMath::Abs(AxisDirection) < UE_DOUBLE_SMALL_NUMBER)
+        {
+            if (AxisOrigin < Box.Min[Axis] || AxisOrigin > Box.Max[Axis])
+            {
+                return false;
+            }
+            continue;
+        }
+
+        double NearT = (Box.Min[Axis] - AxisOrigin) / AxisDirection;
+        double FarT = (Box.Max[Axis] - AxisOrigin) / AxisDirection;
+        if (NearT > FarT)
+        {
+            Swap(NearT, FarT);
+        }
+
+        EntryT = FMath::Max(EntryT, NearT);
+        ExitT = FMath::Min(ExitT, FarT);
+        if (EntryT > ExitT)
+        {
+            return false;
+        }
+    }
+
+    OutEntryT = EntryT;
+    return true;
+}
+
+int32 FLayoutLensAabbTree::RayCast(
+    const FVector& Origin,
+    const FVector& Direction,
+    double MaxT,
+    TFunctionRef<double(int32 Item)> HitTest,
+    double& OutT) const
+{
+    int32 BestItem = INDEX_NONE;
+    OutT = MaxT;
+
+    if (Nodes.Num() == 0)
+    {
+        return BestItem;
+    }
+
+    TArray<int32, TInlineAllocator<64>> Stack;
+    Stack.Add(0);
+
+    while (Stack.Num() > 0)
+    {
+        const FNode& Node = Nodes[Stack.Pop(EAllowShrinking::No)];
+
+        double EntryT = 0.0;
+        if (!IntersectRay(Node.Bounds, Origin, Direction, OutT, EntryT))
+        {
+            continue;
+        }
+
+        if (Node.FirstChild == INDEX_NONE)
+        {
+            for (int32 Offset = 0; Offset < Node.ItemCount; Offset++)
+            {
+                const int32 Item = ItemIndices[Node.FirstItem + Offset];
+                const double HitT = HitTest(Item);
+                if (HitT >= 0.0 && HitT < OutT)
+                {
+                    OutT = HitT;
+                    BestItem = Item;
+                }
+            }
+            continue;
+        }
+
+        double FirstEntryT = 0.0;
+        double SecondEntryT = 0.0;
+        const bool bFirstHit = IntersectRay(Nodes[Node.FirstChild].Bounds, Origin, Direction, OutT, FirstEntryT);
+        const bool bSecondHit = IntersectRay(Nodes[Node.FirstChild + 1].Bounds, Origin, Direction, OutT, SecondEntryT);
+
+        if (bFirstHit && bSecondHit)
+        {
+            const bool bFirstNearer = FirstEntryT <= SecondEntryT;
+            Stack.Add(bFirstNearer ? Node.FirstChild + 1 : Node.FirstChild);
+            Stack.Add(bFirstNearer ? Node.FirstChild : Node.FirstChild + 1);
+        }
+        else if (bFirstHit)
+        {
+            Stack.Add(Node.FirstChild);
+        }
+        else if (bSecondHit)
+        {
+            Stack.Add(Node.FirstChild + 1);
+        }
+    }
+
+    return BestItem;
+}
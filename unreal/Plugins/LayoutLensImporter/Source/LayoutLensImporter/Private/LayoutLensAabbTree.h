@@ -0,0 +1,54 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Static bounding volume hierarchy over 2D item bounds (plan XY). Built top-down by median split on the
+ * longest centroid axis, leaves hold up to four items. Items are identified by their index in the array
+ * passed to Build; exact tests (footprints, segments, oriented boxes) are left to the caller's callbacks.
+ */
+class FLayoutLensAabbTree
+{
+public:
+    void Build(const TArray<FBox2D>& ItemBounds);
+    void Reset();
+
+    int32 GetItemCount() const { return ItemIndices.Num(); }
+
+    // Appends every item whose bounds overlap Box (touching counts).
+    void QueryOverlaps(const FBox2D& Box, TArray<int32>& OutItems) const;
+    void QueryPoint(const FVector2D& Point, TArray<int32>& OutItems) const;
+
+    // Item with the smallest DistanceSquared(Item), visiting nodes nearest-first. INDEX_NONE when empty.
+    int32 FindNearest(
+        const FVector2D& Point,
+        TFunctionRef<double(int32 Item)> DistanceSquared,
+        double& OutDistanceSquared) const;
+
+    // Nearest hit along Origin + T * Direction for T in [0, MaxT]; HitTest returns the item's hit T or a negative value.
+    // Only the XY part of the ray is tested against the tree, so a 3D ray can be passed as is.
+    int32 RayCast(
+        const FVector& Origin,
+        const FVector& Direction,
+        double MaxT,
+        TFunctionRef<double(int32 Item)> HitTest,
+        double& OutT) const;
+
+private:
+    struct FNode
+    {
+        FBox2D Bounds = FBox2D(ForceInit);
+        // Interior nodes: index of the first child, the second follows it. Leaves: INDEX_NONE.
+        int32 FirstChild = INDEX_NONE;
+        int32 FirstItem = 0;
+        int32 ItemCount = 0;
+    };
+
+    void BuildNode(int32 NodeIndex, const TArray<FBox2D>& ItemBounds, int32 FirstItem, int32 ItemCount);
+
+    static bool IntersectRay(const FBox2D& Box, const FVector& Origin, const FVector& Direction, double MaxT, double& OutEntryT);
+
+private:
+    TArray<FNode> Nodes;
+    TArray<int32> ItemIndices;
+};
@@ -0,0 +1,370 @@
+#include "LayoutLensBuildingActor.h"
+
+#include "LayoutLensPlanGeometry.h"
+#include "LayoutLensRoomPlanCache.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
+
+ALayoutLensBuildingActor::ALayoutLensBuildingActor()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    BuildingFilePath = TEXT("output/building.json");
+
+    Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+    SetRootComponent(Root);
+}
+
+void ALayoutLensBuildingActor::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Rooms saved into the level are loaded by the level (or World Partition) itself.
+    if (BuiltRoomActors.Num() > 0)
+    {
+        return;
+    }
+
+    if (LoadBuildingPlan())
+    {
+        GetWorldTimerManager().SetTimer(
+            StreamingTimerHandle, this, &ALayoutLensBuildingActor::UpdateStreaming,
+            FMath::Max(StreamUpdateIntervalSeconds, 0.05f), true, 0.0f);
+    }
+}
+
+void ALayoutLensBuildingActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    GetWorldTimerManager().ClearTimer(StreamingTimerHandle);
+    DestroyRuntimeRooms();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+int32 ALayoutLensBuildingActor::GetRoomCount() const
+{
+    return BuildingPlan.Rooms.Num();
+}
+
+int32 ALayoutLensBuildingActor::GetLoadedRoomCount() const
+{
+    int32 LoadedCount = 0;
+    for (const TObjectPtr<ALayoutLensVisualizerActor>& RoomActor : RuntimeRoomActors)
+    {
+        LoadedCount += RoomActor != nullptr ? 1 : 0;
+    }
+    return LoadedCount;
+}
+
+FString ALayoutLensBuildingActor::GetAbsoluteFilePath(const FString& AnyPath) const
+{
+    FString CleanPath = AnyPath;
+    CleanPath.TrimStartAndEndInline();
+
+    if (FPaths::IsRelative(CleanPath))
+    {
+        return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), CleanPath);
+    }
+
+    return CleanPath;
+}
+
+bool ALayoutLensBuildingActor::LoadBuildingPlan()
+{
+    // Bounds still being measured for the previous plan are dropped when they arrive.
+    Generation++;
+
+    DestroyRuntimeRooms();
+    BuildingPlan = FLayoutLensBuildingPlan();
+
+    const FString AbsolutePath = GetAbsoluteFilePath(BuildingFilePath);
+
+    FString JsonText;
+    if (!FFileHelper::LoadFileToString(JsonText, *AbsolutePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to load building file: %s"), *AbsolutePath);
+        return false;
+    }
+
+    FString ErrorText;
+    if (!FLayoutLensBuildingPlanJson::ParseBuildingPlan(JsonText, FPaths::GetPath(AbsolutePath), BuildingPlan, ErrorText))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to parse building file. %s"), *ErrorText);
+        return false;
+    }
+
+    MeasureRoomBounds();
+
+    RuntimeRoomActors.SetNum(BuildingPlan.Rooms.Num());
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Building has %d rooms."), BuildingPlan.Rooms.Num());
+    return true;
+}
+
+void ALayoutLensBuildingActor::MeasureRoomBounds()
+{
+    TArray<int32> RoomIndices;
+    TArray<FString> FilePaths;
+
+    for (int32 Index = 0; Index < BuildingPlan.Rooms.Num(); Index++)
+    {
+        if (!BuildingPlan.Rooms[Index].LocalBoundsMeters.bIsValid)
+        {
+            RoomIndices.Add(Index);
+            FilePaths.Add(BuildingPlan.Rooms[Index].FilePath);
+        }
+    }
+
+    if (RoomIndices.Num() == 0)
+    {
+        return;
+    }
+
+    const uint32 MeasureGeneration = Generation;
+    const TWeakObjectPtr<ALayoutLensBuildingActor> WeakThis(this);
+
+    // Through the parse cache, so the room actor spawned later finds the plan already parsed.
+    Async(EAsyncExecution::ThreadPool, [WeakThis, MeasureGeneration, RoomIndices = MoveTemp(RoomIndices), FilePaths = MoveTemp(FilePaths)]() mutable
+    {
+        TArray<FBox2D> LocalBoundsCm;
+        LocalBoundsCm.Init(FBox2D(ForceInit), FilePaths.Num());
+
+        ParallelFor(FilePaths.Num(), [&FilePaths, &LocalBoundsCm](int32 Index)
+        {
+            TSharedPtr<const FLayoutLensRoomPlan> Plan;
+            uint64 DocumentVersion = 0;
+            FString ErrorText;
+
+            if (FLayoutLensRoomPlanCache::Get().LoadRoomPlan(FilePaths[Index], Plan, DocumentVersion, ErrorText))
+            {
+                LocalBoundsCm[Index] = FLayoutLensPlanGeometry::ComputeBoundsCm(*Plan);
+            }
+        });
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, MeasureGeneration, RoomIndices = MoveTemp(RoomIndices), LocalBoundsCm = MoveTemp(LocalBoundsCm)]() mutable
+        {
+            if (ALayoutLensBuildingActor* Building = WeakThis.Get())
+            {
+                Building->OnRoomBoundsMeasured(MeasureGeneration, MoveTemp(RoomIndices), MoveTemp(LocalBoundsCm));
+            }
+        });
+    });
+}
+
+void ALayoutLensBuildingActor::OnRoomBoundsMeasured(uint32 MeasureGeneration, TArray<int32> RoomIndices, TArray<FBox2D> LocalBoundsCm)
+{
+    if (MeasureGeneration != Generation)
+    {
+        return;
+    }
+
+    int32 MeasuredRoomCount = 0;
+
+    for (int32 Index = 0; Index < RoomIndices.Num(); Index++)
+    {
+        FLayoutLensBuildingRoom& Room = BuildingPlan.Rooms[RoomIndices[Index]];
+
+        if (!LocalBoundsCm[Index].bIsValid)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("LayoutLens: Room '%s' has no bounds and its plan failed to load; it streams as a point."), *Room.Name);
+            continue;
+        }
+
+        Room.LocalBoundsMeters = FBox2D(LocalBoundsCm[Index].Min / 100.0f, LocalBoundsCm[Index].Max / 100.0f);
+        MeasuredRoomCount++;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Computed bounds of %d rooms from their plans; add \"bounds\" to the building file to skip this."),
+        MeasuredRoomCount);
+}
+
+FTransform ALayoutLensBuildingActor::GetRoomTransform(const FLayoutLensBuildingRoom& Room) const
+{
+    return Room.GetPlacementTransform() * FTransform(GetActorRotation(), GetActorLocation());
+}
+
+float ALayoutLensBuildingActor::GetDistanceToRoomCm(const FLayoutLensBuildingRoom& Room, const FVector& ViewerLocation) const
+{
+    const FVector LocalViewer = GetRoomTransform(Room).InverseTransformPosition(ViewerLocation);
+    const FVector2D LocalViewerMeters = FVector2D(LocalViewer.X, LocalViewer.Y) / 100.0f;
+
+    // Rooms whose bounds are still being measured, or whose plan failed to load, count as a point at their origin.
+    const FBox2D Bounds = Room.LocalBoundsMeters.bIsValid ? Room.LocalBoundsMeters : FBox2D(FVector2D::ZeroVector, FVector2D::ZeroVector);
+
+    return FMath::Sqrt(Bounds.ComputeSquaredDistanceToPoint(LocalViewerMeters)) * 100.0f;
+}
+
+bool ALayoutLensBuildingActor::GetViewerLocation(FVector& OutLocation) const
+{
+    const APlayerController* PlayerController = GetWorld() != nullptr ? GetWorld()->GetFirstPlayerController() : nullptr;
+    if (PlayerController == nullptr)
+    {
+        return false;
+    }
+
+    FRotator ViewRotation;
+    PlayerController->GetPlayerViewPoint(OutLocation, ViewRotation);
+    return true;
+}
+
+void ALayoutLensBuildingActor::UpdateStreaming()
+{
+    FVector ViewerLocation;
+    if (BuildingPlan.Rooms.Num() == 0 || !GetViewerLocation(ViewerLocation))
+    {
+        return;
+    }
+
+    const float StreamInCm = StreamInDistanceMeters * 100.0f;
+    const float StreamOutCm = FMath::Max(StreamOutDistanceMeters, StreamInDistanceMeters) * 100.0f;
+
+    TArray<TPair<float, int32>> SpawnCandidates;
+
+    for (int32 Index = 0; Index < BuildingPlan.Rooms.Num(); Index++)
+    {
+        const float DistanceCm = GetDistanceToRoomCm(BuildingPlan.Rooms[Index], ViewerLocation);
+        const bool bLoaded = RuntimeRoomActors[Index] != nullptr;
+
+        if (bLoaded && DistanceCm > StreamOutCm)
+        {
+            DestroyRuntimeRoom(Index);
+        }
+        else if (!bLoaded && DistanceCm <= StreamInCm)
+        {
+            SpawnCandidates.Emplace(DistanceCm, Index);
+        }
+    }
+
+    SpawnCandidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+
+    for (int32 Index = 0; Index < FMath::Min(SpawnCandidates.Num(), MaxRoomSpawnsPerUpdate); Index++)
+    {
+        SpawnRuntimeRoom(SpawnCandidates[Index].Value);
+    }
+}
+
+void ALayoutLensBuildingActor::SpawnRuntimeRoom(int32 RoomIndex)
+{
+    const FLayoutLensBuildingRoom& Room = BuildingPlan.Rooms[RoomIndex];
+
+    ALayoutLensVisualizerActor* RoomActor = GetWorld()->SpawnActorDeferred<ALayoutLensVisualizerActor>(
+        ALayoutLensVisualizerActor::StaticClass(), GetRoomTransform(Room), this, nullptr,
+        ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+    if (RoomActor == nullptr)
+    {
+        return;
+    }
+
+    RoomActor->InitializeAsBuildingRoom(Room.FilePath, RoomRepresentation);
+    RoomActor->FinishSpawning(GetRoomTransform(Room));
+
+    RuntimeRoomActors[RoomIndex] = RoomActor;
+}
+
+void ALayoutLensBuildingActor::DestroyRuntimeRoom(int32 RoomIndex)
+{
+    if (RuntimeRoomActors[RoomIndex] != nullptr)
+    {
+        RuntimeRoomActors[RoomIndex]->Destroy();
+        RuntimeRoomActors[RoomIndex] = nullptr;
+    }
+}
+
+void ALayoutLensBuildingActor::DestroyRuntimeRooms()
+{
+    for (int32 Index = 0; Index < RuntimeRoomActors.Num(); Index++)
+    {
+        DestroyRuntimeRoom(Index);
+    }
+    RuntimeRoomActors.Empty();
+}
+
+void ALayoutLensBuildingActor::BuildRoomActors()
+{
+#if WITH_EDITOR
+    ClearRoomActors();
+
+    if (BuiltRoomActors.Num() > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: Not building while %d unloaded room actors remain."), BuiltRoomActors.Num());
+        return;
+    }
+
+    if (!LoadBuildingPlan())
+    {
+        return;
+    }
+
+    UWorld* World = GetWorld();
+    if (World == nullptr)
+    {
+        return;
+    }
+
+    Modify();
+
+    const FName FolderPath = *FString::Printf(TEXT("%s_Rooms"), *GetActorLabel());
+
+    for (const FLayoutLensBuildingRoom& Room : BuildingPlan.Rooms)
+    {
+        const FTransform RoomTransform = GetRoomTransform(Room);
+
+        ALayoutLensVisualizerActor* RoomActor = World->SpawnActorDeferred<ALayoutLensVisualizerActor>(
+            ALayoutLensVisualizerActor::StaticClass(), RoomTransform, nullptr, nullptr,
+            ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+        if (RoomActor == nullptr)
+        {
+            continue;
+        }
+
+        RoomActor->InitializeAsBuildingRoom(Room.FilePath, RoomRepresentation);
+        RoomActor->FinishSpawning(RoomTransform);
+
+        RoomActor->SetActorLabel(FString::Printf(TEXT("LayoutLensRoom_%s"), *Room.Name));
+        RoomActor->SetFolderPath(FolderPath);
+        RoomActor->SetIsSpatiallyLoaded(true);
+
+        BuiltRoomActors.Add(RoomActor);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Built %d room actors%s."),
+        BuiltRoomActors.Num(), World->IsPartitionedWorld() ? TEXT(" (spatially loaded)") : TEXT(""));
+#endif
+}
+
+void ALayoutLensBuildingActor::ClearRoomActors()
+{
+#if WITH_EDITOR
+    Modify();
+
+    // Unloaded World Partition actors cannot be destroyed from here, so their references are kept for a later clear
+    // once their cells are loaded; dropping them would leave the actors in the level next to the rebuilt ones.
+    // Outside World Partition every room actor is loaded, so an unresolved reference is one deleted by hand.
+    const bool bPartitioned = GetWorld() != nullptr && GetWorld()->IsPartitionedWorld();
+
+    BuiltRoomActors.RemoveAll([bPartitioned](const TSoftObjectPtr<ALayoutLensVisualizerActor>& BuiltRoomActor)
+    {
+        ALayoutLensVisualizerActor* RoomActor = BuiltRoomActor.Get();
+        if (RoomActor == nullptr)
+        {
+            return BuiltRoomActor.IsNull() || !bPartitioned;
+        }
+
+        RoomActor->Destroy();
+        return true;
+    });
+
+    if (BuiltRoomActors.Num() > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: Kept %d unloaded room actors; load their cells and clear again."), BuiltRoomActors.Num());
+    }
+#endif
+}
@@ -0,0 +1,94 @@
+#include "LayoutLensBuildingPlan.h"
+
+#include "Json.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+    bool TryGetPoint(const TSharedPtr<FJsonObject>& Object, const TCHAR* FieldName, FVector2D& OutPoint)
+    {
+        const TSharedPtr<FJsonObject>* PointObjectPointer = nullptr;
+        if (!Object->TryGetObjectField(FieldName, PointObjectPointer) || PointObjectPointer == nullptr || !PointObjectPointer->IsValid())
+        {
+            return false;
+        }
+
+        OutPoint.X = (*PointObjectPointer)->GetNumberField(TEXT("x"));
+        OutPoint.Y = (*PointObjectPointer)->GetNumberField(TEXT("y"));
+        return true;
+    }
+}
+
+FTransform FLayoutLensBuildingRoom::GetPlacementTransform() const
+{
+    return FTransform(
+        FRotator(0.0f, YawDegrees, 0.0f),
+        FVector(OffsetMeters.X * 100.0f, OffsetMeters.Y * 100.0f, 0.0f));
+}
+
+bool FLayoutLensBuildingPlanJson::ParseBuildingPlan(const FString& JsonText, const FString& BaseDirectory, FLayoutLensBuildingPlan& OutPlan, FString& OutError)
+{
+    TSharedPtr<FJsonObject> RootObject;
+
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+    if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+    {
+        OutError = TEXT("FJsonSerializer::Deserialize failed.");
+        return false;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* RoomsArray = nullptr;
+    if (!RootObject->TryGetArrayField(TEXT("rooms"), RoomsArray) || RoomsArray == nullptr)
+    {
+        OutError = TEXT("Missing 'rooms' array.");
+        return false;
+    }
+
+    OutPlan.Rooms.Empty(RoomsArray->Num());
+
+    for (const TSharedPtr<FJsonValue>& RoomValue : *RoomsArray)
+    {
+        const TSharedPtr<FJsonObject> RoomObject = RoomValue->AsObject();
+        if (!RoomObject.IsValid())
+        {
+            continue;
+        }
+
+        FString RelativePath;
+        if (!RoomObject->TryGetStringField(TEXT("path"), RelativePath) || RelativePath.IsEmpty())
+        {
+            OutError = FString::Printf(TEXT("Room %d has no 'path'."), OutPlan.Rooms.Num());
+            return false;
+        }
+
+        FLayoutLensBuildingRoom& Room = OutPlan.Rooms.AddDefaulted_GetRef();
+        Room.FilePath = FPaths::IsRelative(RelativePath) ? FPaths::Combine(BaseDirectory, RelativePath) : RelativePath;
+        FPaths::NormalizeFilename(Room.FilePath);
+
+        if (!RoomObject->TryGetStringField(TEXT("name"), Room.Name))
+        {
+            Room.Name = FString::FromInt(OutPlan.Rooms.Num() - 1);
+        }
+
+        TryGetPoint(RoomObject, TEXT("offset"), Room.OffsetMeters);
+
+        double YawDegrees = 0.0;
+        if (RoomObject->TryGetNumberField(TEXT("yaw_deg"), YawDegrees))
+        {
+            Room.YawDegrees = (float)YawDegrees;
+        }
+
+        const TSharedPtr<FJsonObject>* BoundsObjectPointer = nullptr;
+        if (RoomObject->TryGetObjectField(TEXT("bounds"), BoundsObjectPointer) && BoundsObjectPointer != nullptr && BoundsObjectPointer->IsValid())
+        {
+            FVector2D BoundsMin;
+            FVector2D BoundsMax;
+            if (TryGetPoint(*BoundsObjectPointer, TEXT("min"), BoundsMin) && TryGetPoint(*BoundsObjectPointer, TEXT("max"), BoundsMax))
+            {
+                Room.LocalBoundsMeters = FBox2D(BoundsMin, BoundsMax);
+            }
+        }
+    }
+
+    return true;
+}
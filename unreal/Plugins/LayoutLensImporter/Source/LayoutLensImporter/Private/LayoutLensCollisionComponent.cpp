@@ -0,0 +1,78 @@
+#include "LayoutLensCollisionComponent.h"
+
+#include "Engine/CollisionProfile.h"
+#include "PhysicsEngine/BodySetup.h"
+
+ULayoutLensCollisionComponent::ULayoutLensCollisionComponent()
+{
+    SetCollisionProfileName(UCollisionProfile::BlockAll_ProfileName);
+    SetGenerateOverlapEvents(false);
+    // Navigation gets its own obstacles with door gaps; box tops would only add unreachable islands.
+    SetCanEverAffectNavigation(false);
+    bHiddenInGame = true;
+}
+
+void ULayoutLensCollisionComponent::BuildAggregate(const TArray<FLayoutLensBox>& Boxes, FKAggregateGeom& OutGeometry)
+{
+    OutGeometry.EmptyElements();
+    OutGeometry.BoxElems.Reserve(Boxes.Num());
+
+    for (const FLayoutLensBox& Box : Boxes)
+    {
+        FKBoxElem& BoxElem = OutGeometry.BoxElems.AddDefaulted_GetRef();
+        BoxElem.Center = Box.CenterCm;
+        BoxElem.Rotation = Box.Rotation;
+        BoxElem.X = FMath::Max(Box.SizeCm.X, 1.0f);
+        BoxElem.Y = FMath::Max(Box.SizeCm.Y, 1.0f);
+        BoxElem.Z = FMath::Max(Box.SizeCm.Z, 1.0f);
+    }
+}
+
+void ULayoutLensCollisionComponent::SetAggregate(FKAggregateGeom&& Geometry)
+{
+    // A fresh body setup rather than editing the live one under its body instance; the old one is collected.
+    UBodySetup* NewBodySetup = NewObject<UBodySetup>(this, NAME_None, RF_Transient);
+    NewBodySetup->BodySetupGuid = FGuid::NewGuid();
+    NewBodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
+    NewBodySetup->bGenerateMirroredCollision = false;
+    NewBodySetup->AggGeom = MoveTemp(Geometry);
+    NewBodySetup->CreatePhysicsMeshes();
+
+    BodySetup = NewBodySetup;
+
+    UpdateBounds();
+    RecreatePhysicsState();
+}
+
+void ULayoutLensCollisionComponent::ClearAggregate()
+{
+    if (BodySetup == nullptr)
+    {
+        return;
+    }
+
+    BodySetup = nullptr;
+
+    UpdateBounds();
+    RecreatePhysicsState();
+}
+
+int32 ULayoutLensCollisionComponent::GetBoxCount() const
+{
+    return BodySetup != nullptr ? BodySetup->AggGeom.BoxElems.Num() : 0;
+}
+
+UBodySetup* ULayoutLensCollisionComponent::GetBodySetup()
+{
+    return BodySetup;
+}
+
+FBoxSphereBounds ULayoutLensCollisionComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+    if (BodySetup == nullptr || BodySetup->AggGeom.GetElementCount() == 0)
+    {
+        return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0.0f);
+    }
+
+    return FBoxSphereBounds(BodySetup->AggGeom.CalcAABB(LocalToWorld));
+}
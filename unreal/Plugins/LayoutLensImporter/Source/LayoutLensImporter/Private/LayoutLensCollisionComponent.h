@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "LayoutLensPlanGeometry.h"
+#include "PhysicsEngine/AggregateGeom.h"
+#include "LayoutLensCollisionComponent.generated.h"
+
+/*
+ * Walkthrough collision for a whole room as one body: every wall piece and floor element is a box element of
+ * a single transient body setup. The physics scene sees one actor however many elements the plan has, and
+ * boxes need no cooking, so the aggregate can be assembled on a worker and swapped in on the game thread.
+ */
+UCLASS()
+class ULayoutLensCollisionComponent : public UPrimitiveComponent
+{
+    GENERATED_BODY()
+
+public:
+    ULayoutLensCollisionComponent();
+
+    // Component-space boxes to box elements; safe off the game thread.
+    static void BuildAggregate(const TArray<FLayoutLensBox>& Boxes, FKAggregateGeom& OutGeometry);
+
+    // Replaces the body with one made of Geometry and recreates the physics state.
+    void SetAggregate(FKAggregateGeom&& Geometry);
+    void ClearAggregate();
+
+    int32 GetBoxCount() const;
+
+    virtual class UBodySetup* GetBodySetup() override;
+    virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+
+private:
+    UPROPERTY(Transient)
+    TObjectPtr<class UBodySetup> BodySetup;
+};
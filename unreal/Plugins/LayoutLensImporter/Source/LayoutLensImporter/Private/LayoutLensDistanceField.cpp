@@ -0,0 +1,495 @@
+#include "LayoutLensDistanceField.h"
+
+#include "LayoutLensOccupancyGrid.h"
+#include "LayoutLensPlanGeometry.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+    const float NoSourceDistanceSquared = 1.0e20f;
+
+    // Non-negative IEEE floats sort like their bit patterns, so an integer CAS loop is a float min.
+    void AtomicMinNonNegative(int32* Target, float Value)
+    {
+        int32 ValueBits = 0;
+        FMemory::Memcpy(&ValueBits, &Value, sizeof(int32));
+
+        int32 OldBits = FPlatformAtomics::AtomicRead(Target);
+        while (ValueBits < OldBits)
+        {
+            const int32 SeenBits = FPlatformAtomics::InterlockedCompareExchange(Target, ValueBits, OldBits);
+            if (SeenBits == OldBits)
+            {
+                break;
+            }
+            OldBits = SeenBits;
+        }
+    }
+
+    FLayoutLensPoint2D MakePoint(float X, float Y)
+    {
+        FLayoutLensPoint2D Point;
+        Point.X = X;
+        Point.Y = Y;
+        return Point;
+    }
+
+    // A plain 4 x 3 m rectangle with a 0.5 m chair whose west face stands 0.5 m off the west wall.
+    FLayoutLensRoomPlan MakeSelfTestPlan()
+    {
+        FLayoutLensRoomPlan Plan;
+        Plan.RoomHeightMeters = 2.7f;
+        Plan.Boundary = { MakePoint(0.0f, 0.0f), MakePoint(4.0f, 0.0f), MakePoint(4.0f, 3.0f), MakePoint(0.0f, 3.0f) };
+
+        FLayoutLensElement& Chair = Plan.Elements.AddDefaulted_GetRef();
+        Chair.Id = TEXT("selftest_chair");
+        Chair.Label = TEXT("chair");
+        Chair.Placement = TEXT("floor");
+        Chair.WidthMeters = 0.5f;
+        Chair.DepthMeters = 0.5f;
+        Chair.HeightMeters = 0.9f;
+        Chair.Transform.X = 0.75f;
+        Chair.Transform.Y = 1.5f;
+
+        return Plan;
+    }
+
+    // Builds the grid and field for the synthetic room at a few cell sizes and checks the chair's wall gap.
+    void RunDistanceFieldSelfTest()
+    {
+        const FLayoutLensRoomPlan Plan = MakeSelfTestPlan();
+        const float ExpectedMeters = 0.5f;
+        const float CellSizes[] = { 0.25f, 0.1f, 0.05f };
+
+        bool bPassed = true;
+        for (const float CellSizeMeters : CellSizes)
+        {
+            FLayoutLensOccupancyGrid Grid;
+            Grid.Build(Plan, CellSizeMeters);
+
+            FLayoutLensDistanceField Field;
+            Field.Build(Plan, Grid);
+
+            // Measured between cell centres, so a cell either way is within the field's resolution.
+            const float WallMeters = Field.GetElementWallDistanceMeters(0);
+            const bool bCellPassed = WallMeters >= 0.0f && FMath::Abs(WallMeters - ExpectedMeters) <= CellSizeMeters + KINDA_SMALL_NUMBER;
+            bPassed &= bCellPassed;
+
+            UE_LOG(LogTemp, Display, TEXT("LayoutLens: Distance field self-test at %.2f m cells: chair to wall %.3f m (expected %.2f m) %s."),
+                CellSizeMeters, WallMeters, ExpectedMeters, bCellPassed ? TEXT("ok") : TEXT("FAILED"));
+        }
+
+        if (bPassed)
+        {
+            UE_LOG(LogTemp, Display, TEXT("LayoutLens: Distance field self-test passed."));
+        }
+        else
+        {
+            UE_LOG(LogTemp, Error, TEXT("LayoutLens: Distance field self-test failed."));
+        }
+    }
+
+    FAutoConsoleCommand DistanceFieldSelfTestCommand(
+        TEXT("LayoutLens.Analysis.SelfTest"),
+        TEXT("Checks the distance field's wall gap for a chair 0.5 m off the wall of a rectangular room."),
+        FConsoleCommandDelegate::CreateStatic(&RunDistanceFieldSelfTest));
+}
+
+void FLayoutLensDistanceField::Reset()
+{
+    Width = 0;
+    Height = 0;
+    MaxDistanceCells = 0.0f;
+    CellOwner.Empty();
+    SignedDistanceCells.Empty();
+    NearestOwner.Empty();
+    ElementCells.Empty();
+    ElementWallDistanceCells.Empty();
+    ElementClearanceCells.Empty();
+}
+
+void FLayoutLensDistanceField::Build(const FLayoutLensRoomPlan& Plan, const FLayoutLensOccupancyGrid& Grid)
+{
+    Reset();
+
+    if (!Grid.IsValid())
+    {
+        return;
+    }
+
+    Width = Grid.GetWidth();
+    Height = Grid.GetHeight();
+    CellSizeMeters = Grid.GetCellSizeMeters();
+    OriginMeters = Grid.GetOriginMeters();
+
+    RasterizeOwners(Plan, Grid);
+
+    const int32 CellCount = Width * Height;
+
+    TArray<uint8> IsBlocked;
+    TArray<uint8> IsFree;
+    TArray<uint8> IsWall;
+    IsBlocked.SetNumUninitialized(CellCount);
+    IsFree.SetNumUninitialized(CellCount);
+    IsWall.SetNumUninitialized(CellCount);
+
+    for (int32 Cell = 0; Cell < CellCount; Cell++)
+    {
+        IsBlocked[Cell] = CellOwner[Cell] != FreeOwner ? 1 : 0;
+        IsFree[Cell] = 1 - IsBlocked[Cell];
+        IsWall[Cell] = CellOwner[Cell] == WallOwner ? 1 : 0;
+    }
+
+    TArray<float> OutsideDistanceSquared;
+    TArray<float> InsideDistanceSquared;
+    TArray<float> WallDistanceSquared;
+    TArray<int32> NearestBlockedCell;
+
+    ComputeDistanceTransform(Width, Height, IsBlocked, OutsideDistanceSquared, &NearestBlockedCell);
+    ComputeDistanceTransform(Width, Height, IsFree, InsideDistanceSquared, nullptr);
+    ComputeDistanceTransform(Width, Height, IsWall, WallDistanceSquared, nullptr);
+
+    SignedDistanceCells.SetNumUninitialized(CellCount);
+    NearestOwner.SetNumUninitialized(CellCount);
+
+    ParallelFor(Height, [&](int32 Y)
+    {
+        for (int32 Cell = Y * Width; Cell < (Y + 1) * Width; Cell++)
+        {
+            if (IsBlocked[Cell] != 0)
+            {
+                SignedDistanceCells[Cell] = -FMath::Sqrt(InsideDistanceSquared[Cell]);
+                NearestOwner[Cell] = CellOwner[Cell];
+            }
+            else
+            {
+                SignedDistanceCells[Cell] = FMath::Sqrt(OutsideDistanceSquared[Cell]);
+                NearestOwner[Cell] = NearestBlockedCell[Cell] != INDEX_NONE ? CellOwner[NearestBlockedCell[Cell]] : FreeOwner;
+            }
+        }
+    });
+
+    for (int32 Cell = 0; Cell < CellCount; Cell++)
+    {
+        if (IsBlocked[Cell] == 0 && NearestBlockedCell[Cell] != INDEX_NONE)
+        {
+            MaxDistanceCells = FMath::Max(MaxDistanceCells, SignedDistanceCells[Cell]);
+        }
+    }
+
+    ComputeElementDistances(Plan, WallDistanceSquared);
+}
+
+void FLayoutLensDistanceField::RasterizeOwners(const FLayoutLensRoomPlan& Plan, const FLayoutLensOccupancyGrid& Grid)
+{
+    CellOwner.SetNumUninitialized(Width * Height);
+
+    ParallelFor(Height, [&](int32 Y)
+    {
+        for (int32 X = 0; X < Width; X++)
+        {
+            CellOwner[Y * Width + X] = Grid.IsInside(X, Y) ? FreeOwner : WallOwner;
+        }
+    });
+
+    ElementCells.SetNum(Plan.Elements.Num());
+
+    // Serial so overlapping footprints resolve deterministically: the later element owns the shared cells.
+    TArray<FVector2D> Footprint;
+    for (int32 ElementIndex = 0; ElementIndex < Plan.Elements.Num(); ElementIndex++)
+    {
+        const FLayoutLensElement& Element = Plan.Elements[ElementIndex];
+        if (!FLayoutLensPlanGeometry::IsFloorElement(Element))
+        {
+            continue;
+        }
+
+        FLayoutLensPlanGeometry::BuildElementFootprint(Element, Footprint);
+
+        const FBox2D FootprintBounds(Footprint);
+
+        int32 FirstRow = 0;
+        int32 LastRow = -1;
+        Grid.GetRowRange(FootprintBounds.Min.Y, FootprintBounds.Max.Y, FirstRow, LastRow);
+
+        FElementCells& Cells = ElementCells[ElementIndex];
+        Cells.MinX = Width;
+        Cells.MinY = Height;
+
+        for (int32 Row = FirstRow; Row <= LastRow; Row++)
+        {
+            const double RowY = OriginMeters.Y + (Row + 0.5) * CellSizeMeters;
+
+            FLayoutLensOccupancyGrid::ForEachRowSpan(Footprint, RowY, OriginMeters.X, CellSizeMeters, Width, [&](int32 FirstCell, int32 LastCell)
+            {
+                for (int32 X = FirstCell; X <= LastCell; X++)
+                {
+                    int32& Owner = CellOwner[Row * Width + X];
+                    if (Owner != WallOwner)
+                    {
+                        Owner = ElementIndex;
+                    }
+                }
+
+                Cells.MinX = FMath::Min(Cells.MinX, FirstCell);
+                Cells.MaxX = FMath::Max(Cells.MaxX, LastCell);
+                Cells.MinY = FMath::Min(Cells.MinY, Row);
+                Cells.MaxY = FMath::Max(Cells.MaxY, Row);
+            });
+        }
+    }
+}
+
+void FLayoutLensDistanceField::ComputeElementDistances(const FLayoutLensRoomPlan& Plan, const TArray<float>& WallDistanceSquared)
+{
+    const int32 ElementCount = Plan.Elements.Num();
+
+    ElementWallDistanceCells.Init(-1.0f, ElementCount);
+
+    // Free cells between the footprint and the nearest wall cell, from the closest owned cell.
+    ParallelFor(ElementCount, [&](int32 ElementIndex)
+    {
+        const FElementCells& Cells = ElementCells[ElementIndex];
+
+        float BestDistanceSquared = NoSourceDistanceSquared;
+        for (int32 Y = Cells.MinY; Y <= Cells.MaxY; Y++)
+        {
+            for (int32 X = Cells.MinX; X <= Cells.MaxX; X++)
+            {
+                if (CellOwner[Y * Width + X] == ElementIndex)
+                {
+                    BestDistanceSquared = FMath::Min(BestDistanceSquared, WallDistanceSquared[Y * Width + X]);
+                }
+            }
+        }
+
+        if (BestDistanceSquared < NoSourceDistanceSquared)
+        {
+            ElementWallDistanceCells[ElementIndex] = FMath::Max(FMath::Sqrt(BestDistanceSquared) - 1.0f, 0.0f);
+        }
+    });
+
+    // Across every edge where the nearest owner changes, the free cells on both sides add up to the gap between the two owners.
+    TArray<int32> ClearanceBits;
+    {
+        const float NoClearance = NoSourceDistanceSquared;
+        int32 NoClearanceBits = 0;
+        FMemory::Memcpy(&NoClearanceBits, &NoClearance, sizeof(int32));
+        ClearanceBits.Init(NoClearanceBits, ElementCount);
+    }
+
+    ParallelFor(Height, [&](int32 Y)
+    {
+        for (int32 X = 0; X < Width; X++)
+        {
+            const int32 Cell = Y * Width + X;
+            const int32 Owner = NearestOwner[Cell];
+            const float Gap = FMath::Max(SignedDistanceCells[Cell], 0.0f);
+
+            const int32 NeighbourCells[2] = { X + 1 < Width ? Cell + 1 : INDEX_NONE, Y + 1 < Height ? Cell + Width : INDEX_NONE };
+
+            for (const int32 NeighbourCell : NeighbourCells)
+            {
+                if (NeighbourCell == INDEX_NONE)
+                {
+                    continue;
+                }
+
+                const int32 NeighbourOwner = NearestOwner[NeighbourCell];
+                if (NeighbourOwner == Owner || NeighbourOwner == FreeOwner || Owner == FreeOwner)
+                {
+                    continue;
+                }
+
+                const float PairGap = Gap + FMath::Max(SignedDistanceCells[NeighbourCell], 0.0f);
+
+                if (Owner >= 0)
+                {
+                    AtomicMinNonNegative(&ClearanceBits[Owner], PairGap);
+                }
+                if (NeighbourOwner >= 0)
+                {
+                    AtomicMinNonNegative(&ClearanceBits[NeighbourOwner], PairGap);
+                }
+            }
+        }
+    });
+
+    ElementClearanceCells.SetNumUninitialized(ElementCount);
+    for (int32 ElementIndex = 0; ElementIndex < ElementCount; ElementIndex++)
+    {
+        float Clearance = 0.0f;
+        FMemory::Memcpy(&Clearance, &ClearanceBits[ElementIndex], sizeof(float));
+        ElementClearanceCells[ElementIndex] = Clearance < NoSourceDistanceSquared ? Clearance : -1.0f;
+    }
+}
+
+void FLayoutLensDistanceField::ComputeDistanceTransform(
+    int32 GridWidth,
+    int32 GridHeight,
+    const TArray<uint8>& IsSource,
+    TArray<float>& OutDistanceSquared,
+    TArray<int32>* OutNearestSource)
+{
+    const int32 CellCount = GridWidth * GridHeight;
+
+    // Columns: squared vertical distance to the nearest source in the same column, and that source's row.
+    TArray<float> ColumnDistanceSquared;
+    TArray<int32> ColumnSourceRow;
+    ColumnDistanceSquared.SetNumUninitialized(CellCount);
+    ColumnSourceRow.SetNumUninitialized(CellCount);
+
+    ParallelFor(GridWidth, [&](int32 X)
+    {
+        int32 LastSourceRow = INDEX_NONE;
+        for (int32 Y = 0; Y < GridHeight; Y++)
+        {
+            if (IsSource[Y * GridWidth + X] != 0)
+            {
+                LastSourceRow = Y;
+            }
+            ColumnSourceRow[Y * GridWidth + X] = LastSourceRow;
+        }
+
+        LastSourceRow = INDEX_NONE;
+        for (int32 Y = GridHeight - 1; Y >= 0; Y--)
+        {
+            const int32 Cell = Y * GridWidth + X;
+            if (IsSource[Cell] != 0)
+            {
+                LastSourceRow = Y;
+            }
+
+            if (LastSourceRow != INDEX_NONE && (ColumnSourceRow[Cell] == INDEX_NONE || LastSourceRow - Y < Y - ColumnSourceRow[Cell]))
+            {
+                ColumnSourceRow[Cell] = LastSourceRow;
+            }
+
+            ColumnDistanceSquared[Cell] = ColumnSourceRow[Cell] != INDEX_NONE
+                ? FMath::Square((float)(Y - ColumnSourceRow[Cell]))
+                : NoSourceDistanceSquared;
+        }
+    });
+
+    OutDistanceSquared.SetNumUninitialized(CellCount);
+    if (OutNearestSource != nullptr)
+    {
+        OutNearestSource->SetNumUninitialized(CellCount);
+    }
+
+    // Rows: lower envelope of the parabolas (X - Q)^2 + ColumnDistanceSquared(Q) over every column Q that has a source.
+    ParallelFor(GridHeight, [&](int32 Y)
+    {
+        const float* RowValues = &ColumnDistanceSquared[Y * GridWidth];
+
+        TArray<int32> ParabolaColumns;
+        TArray<float> Boundaries;
+        ParabolaColumns.SetNumUninitialized(GridWidth);
+        Boundaries.SetNumUninitialized(GridWidth + 1);
+
+        int32 Top = -1;
+
+        for (int32 Q = 0; Q < GridWidth; Q++)
+        {
+            if (RowValues[Q] >= NoSourceDistanceSquared)
+            {
+                continue;
+            }
+
+            float Intersection = 0.0f;
+            while (Top >= 0)
+            {
+                const int32 V = ParabolaColumns[Top];
+                Intersection = ((RowValues[Q] + Q * Q) - (RowValues[V] + V * V)) / (2.0f * (Q - V));
+                if (Intersection > Boundaries[Top])
+                {
+                    break;
+                }
+                Top--;
+            }
+
+            Top++;
+            ParabolaColumns[Top] = Q;
+            Boundaries[Top] = Top == 0 ? -MAX_flt : Intersection;
+            Boundaries[Top + 1] = MAX_flt;
+        }
+
+        int32 Parabola = 0;
+        for (int32 X = 0; X < GridWidth; X++)
+        {
+            const int32 Cell = Y * GridWidth + X;
+
+            if (Top < 0)
+            {
+                OutDistanceSquared[Cell] = NoSourceDistanceSquared;
+                if (OutNearestSource != nullptr)
+                {
+                    (*OutNearestSource)[Cell] = INDEX_NONE;
+                }
+                continue;
+            }
+
+            while (Boundaries[Parabola + 1] < X)
+            {
+                Parabola++;
+            }
+
+            const int32 SourceColumn = ParabolaColumns[Parabola];
+            OutDistanceSquared[Cell] = FMath::Square((float)(X - SourceColumn)) + RowValues[SourceColumn];
+
+            if (OutNearestSource != nullptr)
+            {
+                (*OutNearestSource)[Cell] = ColumnSourceRow[Y * GridWidth + SourceColumn] * GridWidth + SourceColumn;
+            }
+        }
+    });
+}
+
+float FLayoutLensDistanceField::GetSignedDistanceMeters(int32 X, int32 Y) const
+{
+    if (X < 0 || Y < 0 || X >= Width || Y >= Height)
+    {
+        return -CellSizeMeters;
+    }
+
+    return SignedDistanceCells[Y * Width + X] * CellSizeMeters;
+}
+
+float FLayoutLensDistanceField::SampleSignedDistanceMeters(const FVector2D& PointMeters) const
+{
+    const int32 X = FMath::FloorToInt((PointMeters.X - OriginMeters.X) / CellSizeMeters);
+    const int32 Y = FMath::FloorToInt((PointMeters.Y - OriginMeters.Y) / CellSizeMeters);
+    return GetSignedDistanceMeters(X, Y);
+}
+
+int32 FLayoutLensDistanceField::GetNearestOwner(int32 X, int32 Y) const
+{
+    if (X < 0 || Y < 0 || X >= Width || Y >= Height)
+    {
+        return WallOwner;
+    }
+
+    return NearestOwner[Y * Width + X];
+}
+
+float FLayoutLensDistanceField::GetElementWallDistanceMeters(int32 ElementIndex) const
+{
+    if (!ElementWallDistanceCells.IsValidIndex(ElementIndex) || ElementWallDistanceCells[ElementIndex] < 0.0f)
+    {
+        return -1.0f;
+    }
+
+    return ElementWallDistanceCells[ElementIndex] * CellSizeMeters;
+}
+
+float FLayoutLensDistanceField::GetElementClearanceMeters(int32 ElementIndex) const
+{
+    if (!ElementClearanceCells.IsValidIndex(ElementIndex) || ElementClearanceCells[ElementIndex] < 0.0f)
+    {
+        return -1.0f;
+    }
+
+    return ElementClearanceCells[ElementIndex] * CellSizeMeters;
+}
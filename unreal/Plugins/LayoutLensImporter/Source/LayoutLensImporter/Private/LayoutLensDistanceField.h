@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensRoomPlanTypes.h"
+
+class FLayoutLensOccupancyGrid;
+
+/*
+ * Exact 2D Euclidean distance transform (Felzenszwalb & Huttenlocher: a column sweep, then a lower envelope
+ * of parabolas per row, both ParallelFor) over the cells of an occupancy grid. Walls are every cell outside
+ * the boundary, which includes the grid's border ring; elements own the cells their footprint covers.
+ *
+ * - Signed distance: positive from free cells to the nearest wall or element cell, negative from blocked
+ *   cells to the nearest free cell, measured between cell centres.
+ * - Owner: the wall or element that nearest blocked cell belongs to.
+ * - Per element: the free gap to the nearest wall (what GeometryService gets from boundary.distance) and
+ *   to the nearest wall or other element, both precomputed so lookups are O(1).
+ */
+class FLayoutLensDistanceField
+{
+public:
+    static constexpr int32 FreeOwner = -1;
+    static constexpr int32 WallOwner = -2;
+
+    void Build(const FLayoutLensRoomPlan& Plan, const FLayoutLensOccupancyGrid& Grid);
+    void Reset();
+
+    bool IsValid() const { return Width > 0 && Height > 0; }
+
+    float GetSignedDistanceMeters(int32 X, int32 Y) const;
+    float SampleSignedDistanceMeters(const FVector2D& PointMeters) const;
+
+    // Element index, WallOwner, or FreeOwner when the grid has no blocked cell.
+    int32 GetNearestOwner(int32 X, int32 Y) const;
+
+    // -1 when the element covers no cell centre (smaller than a cell) or nothing bounds it.
+    float GetElementWallDistanceMeters(int32 ElementIndex) const;
+    float GetElementClearanceMeters(int32 ElementIndex) const;
+
+    float GetMaxDistanceMeters() const { return MaxDistanceCells * CellSizeMeters; }
+
+private:
+    void RasterizeOwners(const FLayoutLensRoomPlan& Plan, const FLayoutLensOccupancyGrid& Grid);
+    void ComputeElementDistances(const FLayoutLensRoomPlan& Plan, const TArray<float>& WallDistanceSquared);
+
+    static void ComputeDistanceTransform(
+        int32 GridWidth,
+        int32 GridHeight,
+        const TArray<uint8>& IsSource,
+        TArray<float>& OutDistanceSquared,
+        TArray<int32>* OutNearestSource);
+
+private:
+    struct FElementCells
+    {
+        int32 MinX = 0;
+        int32 MinY = 0;
+        int32 MaxX = -1;
+        int32 MaxY = -1;
+    };
+
+    int32 Width = 0;
+    int32 Height = 0;
+    float CellSizeMeters = 0.25f;
+    FVector2D OriginMeters = FVector2D::ZeroVector;
+    float MaxDistanceCells = 0.0f;
+
+    TArray<int32> CellOwner;
+    TArray<float> SignedDistanceCells;
+    TArray<int32> NearestOwner;
+
+    TArray<FElementCells> ElementCells;
+    TArray<float> ElementWallDistanceCells;
+    TArray<float> ElementClearanceCells;
+};
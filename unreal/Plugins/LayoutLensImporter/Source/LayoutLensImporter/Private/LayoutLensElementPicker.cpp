@@ -0,0 +1,96 @@
+#include "LayoutLensElementPicker.h"
+
+#include "LayoutLensPlanGeometry.h"
+
+void FLayoutLensElementPicker::Reset()
+{
+    PickBoxes.Empty();
+    Tree.Reset();
+}
+
+void FLayoutLensElementPicker::Build(const TArray<FLayoutLensBox>& Boxes, const TArray<int32>& ElementIndices)
+{
+    check(Boxes.Num() == ElementIndices.Num());
+
+    Reset();
+
+    PickBoxes.Reserve(Boxes.Num());
+    TArray<FBox2D> ItemBounds;
+    ItemBounds.Reserve(Boxes.Num());
+
+    for (int32 BoxIndex = 0; BoxIndex < Boxes.Num(); BoxIndex++)
+    {
+        const FLayoutLensBox& Box = Boxes[BoxIndex];
+
+        FPickBox& PickBox = PickBoxes.AddDefaulted_GetRef();
+        PickBox.CenterCm = Box.CenterCm;
+        PickBox.Rotation = Box.Rotation.Quaternion();
+        PickBox.HalfSizeCm = Box.SizeCm * 0.5;
+        PickBox.ElementIndex = ElementIndices[BoxIndex];
+
+        const FBox WorldBounds = FBox(-PickBox.HalfSizeCm, PickBox.HalfSizeCm).TransformBy(FTransform(PickBox.Rotation, PickBox.CenterCm));
+        ItemBounds.Add(FBox2D(FVector2D(WorldBounds.Min), FVector2D(WorldBounds.Max)));
+    }
+
+    Tree.Build(ItemBounds);
+}
+
+double FLayoutLensElementPicker::IntersectBox(const FPickBox& Box, const FVector& OriginCm, const FVector& Direction, double MaxDistanceCm)
+{
+    const FVector LocalOrigin = Box.Rotation.UnrotateVector(OriginCm - Box.CenterCm);
+    const FVector LocalDirection = Box.Rotation.UnrotateVector(Direction);
+
+    double EntryT = 0.0;
+    double ExitT = MaxDistanceCm;
+
+    for (int32 Axis = 0; Axis < 3; Axis++)
+    {
+        const double HalfSize = Box.HalfSizeCm[Axis];
+
+        if (FMath::Abs(LocalDirection[Axis]) < UE_DOUBLE_SMALL_NUMBER)
+        {
+            if (FMath::Abs(LocalOrigin[Axis]) > HalfSize)
+            {
+                return -1.0;
+            }
+            continue;
+        }
+
+        const double InverseDirection = 1.0 / LocalDirection[Axis];
+        double NearT = (-HalfSize - LocalOrigin[Axis]) * InverseDirection;
+        double FarT = (HalfSize - LocalOrigin[Axis]) * InverseDirection;
+        if (NearT > FarT)
+        {
+            Swap(NearT, FarT);
+        }
+
+        EntryT = FMath::Max(EntryT, NearT);
+        ExitT = FMath::Min(ExitT, FarT);
+        if (EntryT > ExitT)
+        {
+            return -1.0;
+        }
+    }
+
+    return EntryT;
+}
+
+int32 FLayoutLensElementPicker::RayCast(const FVector& OriginCm, const FVector& Direction, double MaxDistanceCm, double& OutDistanceCm) const
+{
+    OutDistanceCm = MaxDistanceCm;
+
+    const FVector UnitDirection = Direction.GetSafeNormal();
+    if (UnitDirection.IsZero() || PickBoxes.Num() == 0)
+    {
+        return INDEX_NONE;
+    }
+
+    const int32 Item = Tree.RayCast(OriginCm, UnitDirection, MaxDistanceCm,
+        [this, &OriginCm, &UnitDirection, MaxDistanceCm](int32 Candidate)
+        {
+            return IntersectBox(PickBoxes[Candidate], OriginCm, UnitDirection, MaxDistanceCm);
+        },
+        OutDistanceCm);
+
+    return Item != INDEX_NONE ? PickBoxes[Item].ElementIndex : INDEX_NONE;
+}
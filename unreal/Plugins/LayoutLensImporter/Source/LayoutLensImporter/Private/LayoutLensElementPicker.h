@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensAabbTree.h"
+
+struct FLayoutLensBox;
+
+/*
+ * Ray picking over oriented element boxes without any collision. The XY bounds of every box go into an
+ * FLayoutLensAabbTree; leaf candidates get an exact slab test in the box's local frame, nearest node first,
+ * so a pick touches O(log n) nodes and a handful of boxes even on 50k element plans.
+ */
+class FLayoutLensElementPicker
+{
+public:
+    // Boxes in world centimetres; ElementIndices[i] is what a hit on Boxes[i] returns.
+    void Build(const TArray<FLayoutLensBox>& Boxes, const TArray<int32>& ElementIndices);
+    void Reset();
+
+    int32 GetBoxCount() const { return PickBoxes.Num(); }
+
+    // Element index of the nearest box along the ray within MaxDistanceCm, or INDEX_NONE.
+    int32 RayCast(const FVector& OriginCm, const FVector& Direction, double MaxDistanceCm, double& OutDistanceCm) const;
+
+private:
+    struct FPickBox
+    {
+        FVector CenterCm = FVector::ZeroVector;
+        FQuat Rotation = FQuat::Identity;
+        FVector HalfSizeCm = FVector::ZeroVector;
+        int32 ElementIndex = INDEX_NONE;
+    };
+
+    // Entry distance along the ray, 0 when the origin is inside, negative on a miss.
+    static double IntersectBox(const FPickBox& Box, const FVector& OriginCm, const FVector& Direction, double MaxDistanceCm);
+
+private:
+    TArray<FPickBox> PickBoxes;
+    FLayoutLensAabbTree Tree;
+};
@@ -0,0 +1,294 @@
+#include "LayoutLensFurnitureMesh.h"
+
+#include "Engine/StaticMesh.h"
+#include "HAL/IConsoleManager.h"
+#include "LayoutLensProxyMesh.h"
+#include "UObject/Package.h"
+
+namespace
+{
+    TAutoConsoleVariable<int32> CVarFurnitureCacheMaxMeshes(
+        TEXT("LayoutLens.FurnitureCache.MaxMeshes"),
+        512,
+        TEXT("Number of generated furniture meshes the LayoutLens furniture cache keeps. Takes effect on the next mesh built."));
+
+    // Built meshes are renamed with it, so they are recognised after the cache has dropped them.
+    const TCHAR* GeneratedMeshPrefix = TEXT("LayoutLensFurniture");
+
+    const int32 MaxCachedMeshesLimit = 65536;
+
+    void AddPart(TArray<FLayoutLensBox>& Parts, const FVector& CenterCm, const FVector& SizeCm)
+    {
+        FLayoutLensBox& Part = Parts.AddDefaulted_GetRef();
+        Part.CenterCm = CenterCm;
+        Part.SizeCm = SizeCm;
+    }
+
+    void BuildTable(const FVector& SizeCm, TArray<FLayoutLensBox>& Parts)
+    {
+        const FVector Half = SizeCm * 0.5;
+        const double TopCm = FMath::Min(FMath::Clamp(SizeCm.Z * 0.06, 2.0, 5.0), SizeCm.Z * 0.5);
+        const double LegCm = FMath::Clamp(FMath::Min(SizeCm.X, SizeCm.Y) * 0.08, 3.0, 8.0);
+        const double LegHeightCm = SizeCm.Z - TopCm;
+
+        AddPart(Parts, FVector(0.0, 0.0, Half.Z - TopCm * 0.5), FVector(SizeCm.X, SizeCm.Y, TopCm));
+
+        for (const double SignX : { -1.0, 1.0 })
+        {
+            for (const double SignY : { -1.0, 1.0 })
+            {
+                AddPart(Parts,
+                    FVector(SignX * (Half.X - LegCm * 0.5), SignY * (Half.Y - LegCm * 0.5), -Half.Z + LegHeightCm * 0.5),
+                    FVector(LegCm, LegCm, LegHeightCm));
+            }
+        }
+    }
+
+    void BuildShelf(const FVector& SizeCm, TArray<FLayoutLensBox>& Parts)
+    {
+        const FVector Half = SizeCm * 0.5;
+        const double SideCm = FMath::Clamp(SizeCm.X * 0.03, 1.5, 4.0);
+        const double BackCm = FMath::Clamp(SizeCm.Y * 0.03, 1.0, 2.0);
+        const double BoardCm = FMath::Clamp(SizeCm.Z * 0.02, 1.5, 3.0);
+        const double InnerWidthCm = FMath::Max(SizeCm.X - SideCm * 2.0, 1.0);
+
+        // Roughly one board every 40 cm, bottom and top included.
+        const int32 BoardCount = FMath::Clamp(FMath::RoundToInt(SizeCm.Z / 40.0) + 1, 2, 8);
+
+        for (const double SignX : { -1.0, 1.0 })
+        {
+            AddPart(Parts, FVector(SignX * (Half.X - SideCm * 0.5), 0.0, 0.0), FVector(SideCm, SizeCm.Y, SizeCm.Z));
+        }
+
+        AddPart(Parts, FVector(0.0, -Half.Y + BackCm * 0.5, 0.0), FVector(InnerWidthCm, BackCm, SizeCm.Z));
+
+        for (int32 Board = 0; Board < BoardCount; Board++)
+        {
+            const double BoardZ = -Half.Z + BoardCm * 0.5 + (SizeCm.Z - BoardCm) * Board / (BoardCount - 1);
+            AddPart(Parts, FVector(0.0, BackCm * 0.5, BoardZ), FVector(InnerWidthCm, SizeCm.Y - BackCm, BoardCm));
+        }
+    }
+
+    void BuildBed(const FVector& SizeCm, TArray<FLayoutLensBox>& Parts)
+    {
+        // Built along Y and turned when the bed is longer along X.
+        const bool bLongAlongX = SizeCm.X > SizeCm.Y;
+        const double WidthCm = bLongAlongX ? SizeCm.Y : SizeCm.X;
+        const double LengthCm = bLongAlongX ? SizeCm.X : SizeCm.Y;
+        const double HalfLength = LengthCm * 0.5;
+        const double HalfHeight = SizeCm.Z * 0.5;
+
+        const double HeadboardCm = FMath::Clamp(LengthCm * 0.04, 4.0, 8.0);
+        const double FrameHeightCm = SizeCm.Z * 0.3;
+        const double MattressHeightCm = SizeCm.Z * 0.25;
+        const double MattressInsetCm = FMath::Min(2.0, WidthCm * 0.05);
+        const double BodyLengthCm = LengthCm - HeadboardCm;
+        const double BodyCenter = HeadboardCm * 0.5;
+
+        TArray<FLayoutLensBox> BedParts;
+        AddPart(BedParts, FVector(0.0, -HalfLength + HeadboardCm * 0.5, 0.0), FVector(WidthCm, HeadboardCm, SizeCm.Z));
+        AddPart(BedParts, FVector(0.0, BodyCenter, -HalfHeight + FrameHeightCm * 0.5), FVector(WidthCm, BodyLengthCm, FrameHeightCm));
+        AddPart(BedParts,
+            FVector(0.0, BodyCenter, -HalfHeight + FrameHeightCm + MattressHeightCm * 0.5),
+            FVector(WidthCm - MattressInsetCm * 2.0, BodyLengthCm - MattressInsetCm * 2.0, MattressHeightCm));
+
+        const double PillowLengthCm = FMath::Min(BodyLengthCm * 0.15, 40.0);
+        const double PillowHeightCm = SizeCm.Z * 0.1;
+        AddPart(BedParts,
+            FVector(0.0, -HalfLength + HeadboardCm + MattressInsetCm + PillowLengthCm * 0.5, -HalfHeight + FrameHeightCm + MattressHeightCm + PillowHeightCm * 0.5),
+            FVector(WidthCm * 0.7, PillowLengthCm, PillowHeightCm));
+
+        for (FLayoutLensBox& Part : BedParts)
+        {
+            if (bLongAlongX)
+            {
+                Part.CenterCm = FVector(Part.CenterCm.Y, Part.CenterCm.X, Part.CenterCm.Z);
+                Part.SizeCm = FVector(Part.SizeCm.Y, Part.SizeCm.X, Part.SizeCm.Z);
+            }
+            Parts.Add(Part);
+        }
+    }
+
+    void BuildSeat(const FVector& SizeCm, TArray<FLayoutLensBox>& Parts)
+    {
+        const FVector Half = SizeCm * 0.5;
+        const double SeatHeightCm = SizeCm.Z * 0.45;
+        const double SeatCm = FMath::Min(FMath::Clamp(SizeCm.Z * 0.06, 3.0, 8.0), SeatHeightCm);
+        const double BackCm = FMath::Clamp(SizeCm.Y * 0.1, 3.0, 12.0);
+        const double LegCm = FMath::Clamp(FMath::Min(SizeCm.X, SizeCm.Y) * 0.08, 3.0, 6.0);
+        const double LegHeightCm = SeatHeightCm - SeatCm;
+
+        AddPart(Parts, FVector(0.0, -Half.Y + BackCm * 0.5, 0.0), FVector(SizeCm.X, BackCm, SizeCm.Z));
+        AddPart(Parts,
+            FVector(0.0, BackCm * 0.5, -Half.Z + SeatHeightCm - SeatCm * 0.5),
+            FVector(SizeCm.X, SizeCm.Y - BackCm, SeatCm));
+
+        if (LegHeightCm <= 0.0)
+        {
+            return;
+        }
+
+        for (const double SignX : { -1.0, 1.0 })
+        {
+            for (const double LegY : { -Half.Y + BackCm + LegCm * 0.5, Half.Y - LegCm * 0.5 })
+            {
+                AddPart(Parts,
+                    FVector(SignX * (Half.X - LegCm * 0.5), LegY, -Half.Z + LegHeightCm * 0.5),
+                    FVector(LegCm, LegCm, LegHeightCm));
+            }
+        }
+    }
+}
+
+ELayoutLensFurnitureKind FLayoutLensFurnitureMesh::ClassifyLabel(const FString& Label)
+{
+    static const TCHAR* Delimiters[] = { TEXT(" "), TEXT("_"), TEXT("-") };
+
+    TArray<FString> Words;
+    Label.ToLower().ParseIntoArray(Words, Delimiters, UE_ARRAY_COUNT(Delimiters));
+    if (Words.Num() == 0)
+    {
+        return ELayoutLensFurnitureKind::None;
+    }
+
+    const FString& HeadWord = Words.Last();
+
+    auto ContainsAny = [&HeadWord](std::initializer_list<const TCHAR*> Keywords)
+    {
+        for (const TCHAR* Keyword : Keywords)
+        {
+            if (HeadWord.Contains(Keyword))
+            {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Table first so "workbench" is not taken for a seat.
+    if (ContainsAny({ TEXT("table"), TEXT("desk"), TEXT("counter"), TEXT("workbench"), TEXT("nightstand") }))
+    {
+        return ELayoutLensFurnitureKind::Table;
+    }
+    if (ContainsAny({ TEXT("shel"), TEXT("rack"), TEXT("bookcase") }))
+    {
+        return ELayoutLensFurnitureKind::Shelf;
+    }
+    if (ContainsAny({ TEXT("bed"), TEXT("crib") }))
+    {
+        return ELayoutLensFurnitureKind::Bed;
+    }
+    if (ContainsAny({ TEXT("chair"), TEXT("sofa"), TEXT("couch"), TEXT("bench"), TEXT("pew"), TEXT("seat") }))
+    {
+        return ELayoutLensFurnitureKind::Seat;
+    }
+
+    return ELayoutLensFurnitureKind::None;
+}
+
+void FLayoutLensFurnitureMesh::BuildParts(ELayoutLensFurnitureKind Kind, const FVector& SizeCm, TArray<FLayoutLensBox>& OutParts)
+{
+    OutParts.Reset();
+
+    const FVector SafeSizeCm = SizeCm.ComponentMax(FVector(1.0));
+
+    switch (Kind)
+    {
+    case ELayoutLensFurnitureKind::Table:
+        BuildTable(SafeSizeCm, OutParts);
+        break;
+    case ELayoutLensFurnitureKind::Shelf:
+        BuildShelf(SafeSizeCm, OutParts);
+        break;
+    case ELayoutLensFurnitureKind::Bed:
+        BuildBed(SafeSizeCm, OutParts);
+        break;
+    case ELayoutLensFurnitureKind::Seat:
+        BuildSeat(SafeSizeCm, OutParts);
+        break;
+    default:
+        break;
+    }
+}
+
+FLayoutLensFurnitureMeshCache& FLayoutLensFurnitureMeshCache::Get()
+{
+    // Never destroyed: a static FGCObject would unregister after the garbage collector has shut down.
+    static FLayoutLensFurnitureMeshCache* Instance = new FLayoutLensFurnitureMeshCache();
+    return *Instance;
+}
+
+FLayoutLensFurnitureMeshCache::FLayoutLensFurnitureMeshCache()
+    : Meshes(MaxCachedMeshesLimit)
+{
+}
+
+UStaticMesh* FLayoutLensFurnitureMeshCache::FindOrBuild(ELayoutLensFurnitureKind Kind, const FVector& SizeCm, float StepCm, FTransform& OutRelativeTransform)
+{
+    if (Kind == ELayoutLensFurnitureKind::None)
+    {
+        return nullptr;
+    }
+
+    const double SafeStepCm = FMath::Max(StepCm, 1.0f);
+    const FVector SafeSizeCm = SizeCm.ComponentMax(FVector(1.0));
+
+    FKey Key;
+    Key.Kind = Kind;
+    Key.StepMm = FMath::RoundToInt(SafeStepCm * 10.0);
+    Key.SizeSteps = FIntVector(
+        FMath::Max(1, FMath::RoundToInt(SafeSizeCm.X / SafeStepCm)),
+        FMath::Max(1, FMath::RoundToInt(SafeSizeCm.Y / SafeStepCm)),
+        FMath::Max(1, FMath::RoundToInt(SafeSizeCm.Z / SafeStepCm)));
+
+    const FVector MeshSizeCm = FVector(Key.SizeSteps) * SafeStepCm;
+
+    UStaticMesh* Mesh = nullptr;
+
+    if (const TObjectPtr<UStaticMesh>* CachedMesh = Meshes.FindAndTouch(Key))
+    {
+        Mesh = *CachedMesh;
+    }
+    else
+    {
+        TArray<FLayoutLensBox> Parts;
+        FLayoutLensFurnitureMesh::BuildParts(Kind, MeshSizeCm, Parts);
+        Mesh = FLayoutLensProxyMesh::BuildMergedBoxMesh(GetTransientPackage(), Parts,
+            MakeUniqueObjectName(GetTransientPackage(), UStaticMesh::StaticClass(), GeneratedMeshPrefix));
+
+        if (Mesh == nullptr)
+        {
+            return nullptr;
+        }
+
+        // Dropped meshes are only unreferenced here; instances that still draw one keep it alive.
+        const int32 MaxMeshes = FMath::Clamp(CVarFurnitureCacheMaxMeshes.GetValueOnGameThread(), 1, MaxCachedMeshesLimit);
+        while (Meshes.Num() >= MaxMeshes)
+        {
+            Meshes.RemoveLeastRecent();
+        }
+
+        Meshes.Add(Key, Mesh);
+    }
+
+    OutRelativeTransform = FTransform(FQuat::Identity, FVector::ZeroVector, SafeSizeCm / MeshSizeCm);
+    return Mesh;
+}
+
+bool FLayoutLensFurnitureMeshCache::IsGeneratedMesh(const UStaticMesh* Mesh)
+{
+    return Mesh != nullptr && Mesh->GetName().StartsWith(GeneratedMeshPrefix);
+}
+
+void FLayoutLensFurnitureMeshCache::AddReferencedObjects(FReferenceCollector& Collector)
+{
+    for (TLruCache<FKey, TObjectPtr<UStaticMesh>>::TIterator It(Meshes); It; ++It)
+    {
+        Collector.AddReferencedObject(It.Value());
+    }
+}
+
+FString FLayoutLensFurnitureMeshCache::GetReferencerName() const
+{
+    return TEXT("FLayoutLensFurnitureMeshCache");
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "LayoutLensPlanGeometry.h"
+#include "UObject/GCObject.h"
+
+class UStaticMesh;
+
+enum class ELayoutLensFurnitureKind : uint8
+{
+    None,
+    Table,
+    Shelf,
+    Bed,
+    Seat
+};
+
+struct FLayoutLensFurnitureMesh
+{
+    // Matches the label's last word ("desk chair" is a seat, "bedside table" a table).
+    static ELayoutLensFurnitureKind ClassifyLabel(const FString& Label);
+
+    // Parts centred on the origin inside a SizeCm box. Shelf and seat backs face -Y; a bed's head is the
+    // negative end of its longer side.
+    static void BuildParts(ELayoutLensFurnitureKind Kind, const FVector& SizeCm, TArray<FLayoutLensBox>& OutParts);
+};
+
+/*
+ * Process-wide cache of generated furniture meshes keyed by kind and size rounded to a step. Instances stretch
+ * the shared mesh over the few centimetres left, so a warehouse of 5,000 racks builds one mesh per distinct
+ * rack size instead of one per rack. At most LayoutLens.FurnitureCache.MaxMeshes meshes are kept; the least
+ * recently used one is dropped first and stays alive only while components still draw it. Game thread only.
+ */
+class FLayoutLensFurnitureMeshCache : public FGCObject
+{
+public:
+    static FLayoutLensFurnitureMeshCache& Get();
+
+    // nullptr for ELayoutLensFurnitureKind::None. OutRelativeTransform fits the mesh onto the exact box.
+    UStaticMesh* FindOrBuild(ELayoutLensFurnitureKind Kind, const FVector& SizeCm, float StepCm, FTransform& OutRelativeTransform);
+
+    // Whether the mesh was built here, including meshes the cache has since dropped.
+    static bool IsGeneratedMesh(const UStaticMesh* Mesh);
+    int32 GetMeshCount() const { return Meshes.Num(); }
+
+    virtual void AddReferencedObjects(FReferenceCollector& Collector) override;
+    virtual FString GetReferencerName() const override;
+
+private:
+    FLayoutLensFurnitureMeshCache();
+
+    struct FKey
+    {
+        ELayoutLensFurnitureKind Kind = ELayoutLensFurnitureKind::None;
+        FIntVector SizeSteps = FIntVector::ZeroValue;
+        int32 StepMm = 0;
+
+        bool operator==(const FKey& Other) const
+        {
+            return Kind == Other.Kind && SizeSteps == Other.SizeSteps && StepMm == Other.StepMm;
+        }
+
+        friend uint32 GetTypeHash(const FKey& Key)
+        {
+            return HashCombine(HashCombine(GetTypeHash((uint8)Key.Kind), GetTypeHash(Key.SizeSteps)), GetTypeHash(Key.StepMm));
+        }
+    };
+
+private:
+    TLruCache<FKey, TObjectPtr<UStaticMesh>> Meshes;
+};
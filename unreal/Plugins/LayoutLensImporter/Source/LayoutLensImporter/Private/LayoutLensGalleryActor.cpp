@@ -0,0 +1,360 @@
+#include "LayoutLensGalleryActor.h"
+
+#include "LayoutLensPlacementIndex.h"
+#include "LayoutLensPlanGeometry.h"
+#include "LayoutLensRoomPlanCache.h"
+
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "TimerManager.h"
+#include "UObject/ConstructorHelpers.h"
+
+ALayoutLensGalleryActor::ALayoutLensGalleryActor()
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    OutputDirectoryPath = TEXT("output");
+    RoomPlanFileName = TEXT("room_plan.json");
+
+    Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+    SetRootComponent(Root);
+
+    ElementInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("ElementInstances"));
+    ElementInstances->SetupAttachment(Root);
+    ElementInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+    WallInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("WallInstances"));
+    WallInstances->SetupAttachment(Root);
+    WallInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMeshFinder(TEXT("/Engine/BasicShapes/Cube.Cube"));
+    if (CubeMeshFinder.Succeeded())
+    {
+        ElementInstances->SetStaticMesh(CubeMeshFinder.Object);
+        WallInstances->SetStaticMesh(CubeMeshFinder.Object);
+    }
+}
+
+void ALayoutLensGalleryActor::BeginPlay()
+{
+    Super::BeginPlay();
+
+    ElementPool.Initialize(ElementInstances);
+    WallPool.Initialize(WallInstances);
+
+    GetWorldTimerManager().SetTimer(
+        StreamingTimerHandle, this, &ALayoutLensGalleryActor::UpdateStreaming,
+        FMath::Max(StreamUpdateIntervalSeconds, 0.05f), true);
+
+    if (AutoScanOnBeginPlay)
+    {
+        ScanOutputDirectory();
+    }
+}
+
+void ALayoutLensGalleryActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    GetWorldTimerManager().ClearTimer(StreamingTimerHandle);
+    ClearRooms();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+int32 ALayoutLensGalleryActor::GetRoomCount() const
+{
+    return Rooms.Num();
+}
+
+int32 ALayoutLensGalleryActor::GetLoadedRoomCount() const
+{
+    int32 LoadedCount = 0;
+    for (const FLayoutLensGalleryRoom& Room : Rooms)
+    {
+        LoadedCount += Room.bLoaded ? 1 : 0;
+    }
+    return LoadedCount;
+}
+
+FString ALayoutLensGalleryActor::GetAbsoluteDirectoryPath() const
+{
+    FString CleanPath = OutputDirectoryPath;
+    CleanPath.TrimStartAndEndInline();
+
+    if (FPaths::IsRelative(CleanPath))
+    {
+        return FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), CleanPath);
+    }
+
+    return CleanPath;
+}
+
+void ALayoutLensGalleryActor::ClearRooms()
+{
+    // Results of in-flight loads from the previous generation are dropped when they arrive.
+    Generation++;
+    LoadsInFlight = 0;
+
+    Rooms.Empty();
+    ElementPool.Reset();
+    WallPool.Reset();
+}
+
+void ALayoutLensGalleryActor::ScanOutputDirectory()
+{
+    ClearRooms();
+
+    const FString DirectoryPath = GetAbsoluteDirectoryPath();
+
+    TArray<FString> FilePaths;
+    IFileManager::Get().FindFilesRecursive(FilePaths, *DirectoryPath, *RoomPlanFileName, true, false);
+    FilePaths.Sort();
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Gallery found %d plans under %s"), FilePaths.Num(), *DirectoryPath);
+
+    const uint32 ScanGeneration = Generation;
+    const TWeakObjectPtr<ALayoutLensGalleryActor> WeakThis(this);
+
+    Async(EAsyncExecution::ThreadPool, [WeakThis, ScanGeneration, FilePaths = MoveTemp(FilePaths)]() mutable
+    {
+        TArray<FBox2D> LocalBoundsCm;
+        LocalBoundsCm.Init(FBox2D(ForceInit), FilePaths.Num());
+
+        ParallelFor(FilePaths.Num(), [&FilePaths, &LocalBoundsCm](int32 Index)
+        {
+            TSharedPtr<const FLayoutLensRoomPlan> Plan;
+            uint64 DocumentVersion = 0;
+            FString ErrorText;
+
+            if (FLayoutLensRoomPlanCache::Get().LoadRoomPlan(FilePaths[Index], Plan, DocumentVersion, ErrorText))
+            {
+                LocalBoundsCm[Index] = FLayoutLensPlanGeometry::ComputeBoundsCm(*Plan);
+            }
+        });
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, ScanGeneration, FilePaths = MoveTemp(FilePaths), LocalBoundsCm = MoveTemp(LocalBoundsCm)]() mutable
+        {
+            if (ALayoutLensGalleryActor* Gallery = WeakThis.Get())
+            {
+                Gallery->OnScanComplete(ScanGeneration, MoveTemp(FilePaths), MoveTemp(LocalBoundsCm));
+            }
+        });
+    });
+}
+
+void ALayoutLensGalleryActor::OnScanComplete(uint32 ScanGeneration, TArray<FString> FilePaths, TArray<FBox2D> LocalBoundsCm)
+{
+    if (ScanGeneration != Generation)
+    {
+        return;
+    }
+
+    Rooms.Empty(FilePaths.Num());
+
+    for (int32 Index = 0; Index < FilePaths.Num(); Index++)
+    {
+        if (!LocalBoundsCm[Index].bIsValid)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("LayoutLens: Gallery skipped unreadable plan %s"), *FilePaths[Index]);
+            continue;
+        }
+
+        FLayoutLensGalleryRoom Room;
+        Room.FilePath = MoveTemp(FilePaths[Index]);
+        Room.LocalBoundsCm = LocalBoundsCm[Index];
+        Rooms.Add(MoveTemp(Room));
+    }
+
+    LayoutGrid();
+    UpdateStreaming();
+}
+
+void ALayoutLensGalleryActor::LayoutGrid()
+{
+    if (Rooms.Num() == 0)
+    {
+        return;
+    }
+
+    FVector2D CellSizeCm = FVector2D::ZeroVector;
+    for (const FLayoutLensGalleryRoom& Room : Rooms)
+    {
+        CellSizeCm = FVector2D::Max(CellSizeCm, Room.LocalBoundsCm.GetSize());
+    }
+    CellSizeCm += FVector2D(CellPaddingMeters * 100.0f);
+
+    const int32 ColumnCount = GridColumns > 0
+        ? GridColumns
+        : FMath::Max(1, FMath::CeilToInt(FMath::Sqrt((float)Rooms.Num())));
+
+    for (int32 Index = 0; Index < Rooms.Num(); Index++)
+    {
+        FLayoutLensGalleryRoom& Room = Rooms[Index];
+
+        const FVector2D CellMinCm = FVector2D((Index % ColumnCount) * CellSizeCm.X, (Index / ColumnCount) * CellSizeCm.Y);
+        const FVector2D CenteringCm = (CellSizeCm - Room.LocalBoundsCm.GetSize()) * 0.5f;
+
+        Room.OffsetCm = CellMinCm + CenteringCm - Room.LocalBoundsCm.Min;
+    }
+}
+
+bool ALayoutLensGalleryActor::GetViewerLocation(FVector& OutLocation) const
+{
+    const APlayerController* PlayerController = GetWorld() != nullptr ? GetWorld()->GetFirstPlayerController() : nullptr;
+    if (PlayerController == nullptr)
+    {
+        return false;
+    }
+
+    FRotator ViewRotation;
+    PlayerController->GetPlayerViewPoint(OutLocation, ViewRotation);
+    return true;
+}
+
+float ALayoutLensGalleryActor::GetDistanceToRoomCm(const FLayoutLensGalleryRoom& Room, const FVector& ViewerLocation) const
+{
+    const FVector LocalViewer = GetActorTransform().InverseTransformPosition(ViewerLocation);
+    const FBox2D PlacedBounds = Room.LocalBoundsCm.ShiftBy(Room.OffsetCm);
+
+    return FMath::Sqrt(PlacedBounds.ComputeSquaredDistanceToPoint(FVector2D(LocalViewer.X, LocalViewer.Y)));
+}
+
+void ALayoutLensGalleryActor::UpdateStreaming()
+{
+    FVector ViewerLocation;
+    if (Rooms.Num() == 0 || !GetViewerLocation(ViewerLocation))
+    {
+        return;
+    }
+
+    const float StreamInCm = StreamInDistanceMeters * 100.0f;
+    const float StreamOutCm = FMath::Max(StreamOutDistanceMeters, StreamInDistanceMeters) * 100.0f;
+
+    TArray<TPair<float, int32>> LoadCandidates;
+
+    for (int32 Index = 0; Index < Rooms.Num(); Index++)
+    {
+        const FLayoutLensGalleryRoom& Room = Rooms[Index];
+        const float DistanceCm = GetDistanceToRoomCm(Room, ViewerLocation);
+
+        if (Room.bLoaded && DistanceCm > StreamOutCm)
+        {
+            UnloadRoom(Index);
+        }
+        else if (!Room.bLoaded && !Room.bLoading && DistanceCm <= StreamInCm)
+        {
+            LoadCandidates.Emplace(DistanceCm, Index);
+        }
+    }
+
+    LoadCandidates.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; });
+
+    for (const TPair<float, int32>& Candidate : LoadCandidates)
+    {
+        if (LoadsInFlight >= MaxConcurrentLoads)
+        {
+            break;
+        }
+        RequestRoomLoad(Candidate.Value);
+    }
+}
+
+void ALayoutLensGalleryActor::RequestRoomLoad(int32 RoomIndex)
+{
+    FLayoutLensGalleryRoom& Room = Rooms[RoomIndex];
+    Room.bLoading = true;
+    LoadsInFlight++;
+
+    const uint32 ScanGeneration = Generation;
+    const TWeakObjectPtr<ALayoutLensGalleryActor> WeakThis(this);
+    const FString FilePath = Room.FilePath;
+    const FVector OffsetCm = FVector(Room.OffsetCm.X, Room.OffsetCm.Y, 0.0f);
+    const float WallThickness = WallThicknessCm;
+
+    Async(EAsyncExecution::ThreadPool, [WeakThis, ScanGeneration, RoomIndex, FilePath, OffsetCm, WallThickness]()
+    {
+        TArray<FTransform> ElementTransforms;
+        TArray<FTransform> WallTransforms;
+
+        TSharedPtr<const FLayoutLensRoomPlan> CachedPlan;
+        uint64 DocumentVersion = 0;
+        FString ErrorText;
+
+        const bool bSucceeded = FLayoutLensRoomPlanCache::Get().LoadRoomPlan(FilePath, CachedPlan, DocumentVersion, ErrorText);
+        if (bSucceeded)
+        {
+            const FLayoutLensRoomPlan& Plan = *CachedPlan;
+
+            FLayoutLensPlacementIndex Placement;
+            Placement.Build(Plan, WallThickness);
+
+            ElementTransforms.Reserve(Plan.Elements.Num());
+            for (const FLayoutLensElement& Element : Plan.Elements)
+            {
+                if (FLayoutLensPlanGeometry::IsPlacedElement(Element))
+                {
+                    FLayoutLensBox Box = Placement.MakeElementBox(Element);
+                    Box.CenterCm += OffsetCm;
+                    ElementTransforms.Add(Box.ToCubeTransform());
+                }
+            }
+
+            TArray<FLayoutLensBox> WallBoxes;
+            FLayoutLensPlanGeometry::BuildWallBoxes(Plan, WallThickness, WallBoxes);
+
+            WallTransforms.Reserve(WallBoxes.Num());
+            for (FLayoutLensBox& WallBox : WallBoxes)
+            {
+                WallBox.CenterCm += OffsetCm;
+                WallTransforms.Add(WallBox.ToCubeTransform());
+            }
+        }
+
+        AsyncTask(ENamedThreads::GameThread,
+            [WeakThis, ScanGeneration, RoomIndex, bSucceeded, ErrorText = MoveTemp(ErrorText), ElementTransforms = MoveTemp(ElementTransforms), WallTransforms = MoveTemp(WallTransforms)]() mutable
+        {
+            if (ALayoutLensGalleryActor* Gallery = WeakThis.Get())
+            {
+                Gallery->OnRoomLoaded(ScanGeneration, RoomIndex, bSucceeded, ErrorText, MoveTemp(ElementTransforms), MoveTemp(WallTransforms));
+            }
+        });
+    });
+}
+
+void ALayoutLensGalleryActor::OnRoomLoaded(uint32 ScanGeneration, int32 RoomIndex, bool bSucceeded, const FString& ErrorText, TArray<FTransform> ElementTransforms, TArray<FTransform> WallTransforms)
+{
+    if (ScanGeneration != Generation || !Rooms.IsValidIndex(RoomIndex))
+    {
+        return;
+    }
+
+    LoadsInFlight = FMath::Max(LoadsInFlight - 1, 0);
+
+    FLayoutLensGalleryRoom& Room = Rooms[RoomIndex];
+    Room.bLoading = false;
+
+    if (!bSucceeded)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: Gallery failed to load %s. %s"), *Room.FilePath, *ErrorText);
+        return;
+    }
+
+    Room.bLoaded = true;
+
+    ElementPool.Acquire(ElementTransforms, Room.ElementSlots);
+    WallPool.Acquire(WallTransforms, Room.WallSlots);
+}
+
+void ALayoutLensGalleryActor::UnloadRoom(int32 RoomIndex)
+{
+    FLayoutLensGalleryRoom& Room = Rooms[RoomIndex];
+
+    ElementPool.Release(Room.ElementSlots);
+    WallPool.Release(Room.WallSlots);
+
+    Room.bLoaded = false;
+}
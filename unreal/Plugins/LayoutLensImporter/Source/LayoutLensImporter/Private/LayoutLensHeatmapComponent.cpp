@@ -0,0 +1,92 @@
+#include "LayoutLensHeatmapComponent.h"
+
+#include "Engine/StaticMesh.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "UObject/ConstructorHelpers.h"
+
+namespace
+{
+    // Keeps the plane just above the floor so it does not z-fight with it.
+    const float HeatmapHeightCm = 2.0f;
+
+    // The engine plane is 100 cm square and centred on its origin.
+    const float PlaneSizeCm = 100.0f;
+}
+
+ULayoutLensHeatmapComponent::ULayoutLensHeatmapComponent()
+{
+    SetUsingAbsoluteLocation(true);
+    SetUsingAbsoluteRotation(true);
+    SetUsingAbsoluteScale(true);
+    SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    SetCastShadow(false);
+    SetVisibility(false);
+
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> PlaneMeshFinder(TEXT("/Engine/BasicShapes/Plane.Plane"));
+    if (PlaneMeshFinder.Succeeded())
+    {
+        SetStaticMesh(PlaneMeshFinder.Object);
+    }
+
+    static ConstructorHelpers::FObjectFinder<UMaterialInterface> MaterialFinder(
+        TEXT("/Engine/EngineMaterials/Widget3DPassThrough_Translucent.Widget3DPassThrough_Translucent"));
+    if (MaterialFinder.Succeeded())
+    {
+        BaseMaterial = MaterialFinder.Object;
+    }
+}
+
+void ULayoutLensHeatmapComponent::SetCells(
+    int32 Width,
+    int32 Height,
+    const FVector2D& OriginCm,
+    float CellSizeCm,
+    const TArray<FColor>& Colors,
+    const FTransform& PlanToWorld)
+{
+    if (Width <= 0 || Height <= 0 || Colors.Num() != Width * Height)
+    {
+        ClearCells();
+        return;
+    }
+
+    if (CellTexture == nullptr || CellTexture->GetSizeX() != Width || CellTexture->GetSizeY() != Height)
+    {
+        CellTexture = UTexture2D::CreateTransient(Width, Height, PF_B8G8R8A8);
+        CellTexture->Filter = TF_Nearest;
+        CellTexture->AddressX = TA_Clamp;
+        CellTexture->AddressY = TA_Clamp;
+    }
+
+    FTexture2DMipMap& Mip = CellTexture->GetPlatformData()->Mips[0];
+    void* MipData = Mip.BulkData.Lock(LOCK_READ_WRITE);
+    FMemory::Memcpy(MipData, Colors.GetData(), Colors.Num() * sizeof(FColor));
+    Mip.BulkData.Unlock();
+    CellTexture->UpdateResource();
+
+    if (CellMaterial == nullptr && BaseMaterial != nullptr)
+    {
+        CellMaterial = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+        SetMaterial(0, CellMaterial);
+    }
+
+    if (CellMaterial != nullptr)
+    {
+        CellMaterial->SetTextureParameterValue(TEXT("SlateUI"), CellTexture);
+    }
+
+    const FVector2D SizeCm = FVector2D(Width, Height) * CellSizeCm;
+    const FVector2D CenterCm = OriginCm + SizeCm * 0.5f;
+
+    SetWorldLocationAndRotation(
+        PlanToWorld.TransformPosition(FVector(CenterCm.X, CenterCm.Y, HeatmapHeightCm)),
+        PlanToWorld.GetRotation());
+    SetWorldScale3D(FVector(SizeCm.X / PlaneSizeCm, SizeCm.Y / PlaneSizeCm, 1.0f));
+    SetVisibility(true);
+}
+
+void ULayoutLensHeatmapComponent::ClearCells()
+{
+    SetVisibility(false);
+}
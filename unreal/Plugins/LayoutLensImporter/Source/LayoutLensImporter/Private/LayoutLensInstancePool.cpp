@@ -0,0 +1,84 @@
+#include "LayoutLensInstancePool.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+
+void FLayoutLensInstancePool::Initialize(UInstancedStaticMeshComponent* InComponent, bool bInWorldSpaceTransforms)
+{
+    Component = InComponent;
+    FreeSlots.Empty();
+    bWorldSpaceTransforms = bInWorldSpaceTransforms;
+}
+
+void FLayoutLensInstancePool::Reset()
+{
+    if (UInstancedStaticMeshComponent* InstanceComponent = Component.Get())
+    {
+        InstanceComponent->ClearInstances();
+    }
+    FreeSlots.Empty();
+}
+
+void FLayoutLensInstancePool::Acquire(const TArray<FTransform>& Transforms, TArray<int32>& OutSlots)
+{
+    UInstancedStaticMeshComponent* InstanceComponent = Component.Get();
+    if (InstanceComponent == nullptr || Transforms.Num() == 0)
+    {
+        return;
+    }
+
+    OutSlots.Reserve(OutSlots.Num() + Transforms.Num());
+
+    const int32 ReusedCount = FMath::Min(FreeSlots.Num(), Transforms.Num());
+    for (int32 Index = 0; Index < ReusedCount; Index++)
+    {
+        const int32 Slot = FreeSlots.Pop(EAllowShrinking::No);
+        InstanceComponent->UpdateInstanceTransform(Slot, Transforms[Index], bWorldSpaceTransforms, false, true);
+        OutSlots.Add(Slot);
+    }
+
+    if (ReusedCount < Transforms.Num())
+    {
+        const TArray<FTransform> NewTransforms(Transforms.GetData() + ReusedCount, Transforms.Num() - ReusedCount);
+        OutSlots.Append(InstanceComponent->AddInstances(NewTransforms, true, bWorldSpaceTransforms, false));
+    }
+
+    InstanceComponent->MarkRenderStateDirty();
+}
+
+void FLayoutLensInstancePool::Release(TArray<int32>& InOutSlots)
+{
+    UInstancedStaticMeshComponent* InstanceComponent = Component.Get();
+    if (InstanceComponent != nullptr && InOutSlots.Num() > 0)
+    {
+        const FTransform Hidden(FRotator::ZeroRotator, FVector::ZeroVector, FVector::ZeroVector);
+
+        for (const int32 Slot : InOutSlots)
+        {
+            InstanceComponent->UpdateInstanceTransform(Slot, Hidden, false, false, true);
+        }
+
+        InstanceComponent->MarkRenderStateDirty();
+        FreeSlots.Append(InOutSlots);
+    }
+
+    InOutSlots.Empty();
+}
+
+void FLayoutLensInstancePool::Update(int32 Slot, const FTransform& Transform)
+{
+    if (UInstancedStaticMeshComponent* InstanceComponent = Component.Get())
+    {
+        InstanceComponent->UpdateInstanceTransform(Slot, Transform, bWorldSpaceTransforms, true, true);
+    }
+}
+
+int32 FLayoutLensInstancePool::GetUsedCount() const
+{
+    return GetCapacity() - FreeSlots.Num();
+}
+
+int32 FLayoutLensInstancePool::GetCapacity() const
+{
+    const UInstancedStaticMeshComponent* InstanceComponent = Component.Get();
+    return InstanceComponent != nullptr ? InstanceComponent->GetInstanceCount() : 0;
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "LayoutLensMassFragments.generated.h"
+
+USTRUCT()
+struct FLayoutLensTransformFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    FVector CenterCm = FVector::ZeroVector;
+    FRotator Rotation = FRotator::ZeroRotator;
+};
+
+USTRUCT()
+struct FLayoutLensFootprintFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    FVector SizeCm = FVector(100.0f);
+};
+
+USTRUCT()
+struct FLayoutLensMetadataFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    FString Id;
+    FString Label;
+};
+
+// LOD the entity is currently drawn at and the instance slot backing it (INDEX_NONE while culled).
+USTRUCT()
+struct FLayoutLensRenderFragment : public FMassFragment
+{
+    GENERATED_BODY()
+
+    int32 InstanceSlot = INDEX_NONE;
+    uint8 LodLevel = 2;
+};
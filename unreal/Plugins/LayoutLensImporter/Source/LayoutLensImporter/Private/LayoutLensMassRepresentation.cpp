@@ -0,0 +1,272 @@
+#include "LayoutLensMassRepresentation.h"
+
+#include "LayoutLensMassFragments.h"
+#include "LayoutLensPlacementIndex.h"
+#include "LayoutLensPlanGeometry.h"
+
+#include "Engine/World.h"
+#include "MassEntityManager.h"
+#include "MassEntitySubsystem.h"
+#include "MassExecutionContext.h"
+
+bool FLayoutLensMassRepresentation::Initialize(UWorld* World, UInstancedStaticMeshComponent* InstanceComponent)
+{
+    UMassEntitySubsystem* EntitySubsystem = World != nullptr ? World->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+    if (EntitySubsystem == nullptr)
+    {
+        return false;
+    }
+
+    EntityManager = EntitySubsystem->GetMutableEntityManager().AsShared();
+
+    Archetype = EntityManager->CreateArchetype(
+        {
+            FLayoutLensTransformFragment::StaticStruct(),
+            FLayoutLensFootprintFragment::StaticStruct(),
+            FLayoutLensMetadataFragment::StaticStruct(),
+            FLayoutLensRenderFragment::StaticStruct()
+        });
+
+    LodQuery = FMassEntityQuery(EntityManager.ToSharedRef());
+    LodQuery.AddRequirement<FLayoutLensTransformFragment>(EMassFragmentAccess::ReadOnly);
+    LodQuery.AddRequirement<FLayoutLensFootprintFragment>(EMassFragmentAccess::ReadOnly);
+    LodQuery.AddRequirement<FLayoutLensRenderFragment>(EMassFragmentAccess::ReadWrite);
+
+    Pool.Initialize(InstanceComponent);
+    return true;
+}
+
+void FLayoutLensMassRepresentation::Reset()
+{
+    if (EntityManager.IsValid() && EntityById.Num() > 0)
+    {
+        TArray<FMassEntityHandle> Entities;
+        EntityById.GenerateValueArray(Entities);
+        EntityManager->BatchDestroyEntities(Entities);
+    }
+
+    EntityById.Empty();
+    Pool.Reset();
+}
+
+FTransform FLayoutLensMassRepresentation::MakeInstanceTransform(const FVector& CenterCm, const FRotator& Rotation, const FVector& SizeCm, uint8 LodLevel)
+{
+    FLayoutLensBox Box;
+    Box.CenterCm = CenterCm;
+    Box.Rotation = Rotation;
+    Box.SizeCm = SizeCm;
+
+    if (LodLevel == LodFootprint)
+    {
+        const float FootprintHeightCm = 2.0f;
+        Box.CenterCm.Z -= (SizeCm.Z - FootprintHeightCm) * 0.5f;
+        Box.SizeCm.Z = FootprintHeightCm;
+    }
+
+    return Box.ToCubeTransform();
+}
+
+void FLayoutLensMassRepresentation::WriteElementFragments(const FMassEntityHandle& Entity, const FLayoutLensElement& Element, const FLayoutLensPlacementIndex& Placement)
+{
+    const FLayoutLensBox Box = Placement.MakeElementBox(Element);
+
+    FLayoutLensTransformFragment& Transform = EntityManager->GetFragmentDataChecked<FLayoutLensTransformFragment>(Entity);
+    Transform.CenterCm = PlanToWorld.TransformPosition(Box.CenterCm);
+    Transform.Rotation = (PlanToWorld.GetRotation() * Box.Rotation.Quaternion()).Rotator();
+
+    EntityManager->GetFragmentDataChecked<FLayoutLensFootprintFragment>(Entity).SizeCm = Box.SizeCm;
+
+    FLayoutLensMetadataFragment& Metadata = EntityManager->GetFragmentDataChecked<FLayoutLensMetadataFragment>(Entity);
+    Metadata.Id = Element.Id;
+    Metadata.Label = Element.Label;
+}
+
+void FLayoutLensMassRepresentation::SyncElements(const TArray<FLayoutLensElement>& Elements, const FLayoutLensPlacementIndex& Placement)
+{
+    if (!EntityManager.IsValid())
+    {
+        return;
+    }
+
+    TArray<const FLayoutLensElement*> NewElements;
+    NewElements.Reserve(Elements.Num());
+
+    for (const FLayoutLensElement& Element : Elements)
+    {
+        if (!FLayoutLensPlanGeometry::IsPlacedElement(Element))
+        {
+            RemoveElement(Element.Id);
+        }
+        else if (EntityById.Contains(Element.Id))
+        {
+            SetElement(Element, Placement);
+        }
+        else
+        {
+            NewElements.Add(&Element);
+        }
+    }
+
+    if (NewElements.Num() == 0)
+    {
+        return;
+    }
+
+    // New entities start culled; the next UpdateLod gives the nearby ones instance slots.
+    TArray<FMassEntityHandle> NewEntities;
+    EntityManager->BatchCreateEntities(Archetype, FMassArchetypeSharedFragmentValues(), NewElements.Num(), NewEntities);
+
+    EntityById.Reserve(EntityById.Num() + NewEntities.Num());
+
+    for (int32 Index = 0; Index < NewEntities.Num(); Index++)
+    {
+        WriteElementFragments(NewEntities[Index], *NewElements[Index], Placement);
+        EntityById.Add(NewElements[Index]->Id, NewEntities[Index]);
+    }
+}
+
+void FLayoutLensMassRepresentation::SetElement(const FLayoutLensElement& Element, const FLayoutLensPlacementIndex& Placement)
+{
+    if (!EntityManager.IsValid())
+    {
+        return;
+    }
+
+    if (!FLayoutLensPlanGeometry::IsPlacedElement(Element))
+    {
+        RemoveElement(Element.Id);
+        return;
+    }
+
+    const FMassEntityHandle* ExistingEntity = EntityById.Find(Element.Id);
+    if (ExistingEntity == nullptr)
+    {
+        const FMassEntityHandle NewEntity = EntityManager->CreateEntity(Archetype);
+        WriteElementFragments(NewEntity, Element, Placement);
+        EntityById.Add(Element.Id, NewEntity);
+        return;
+    }
+
+    WriteElementFragments(*ExistingEntity, Element, Placement);
+
+    const FLayoutLensRenderFragment& Render = EntityManager->GetFragmentDataChecked<FLayoutLensRenderFragment>(*ExistingEntity);
+    if (Render.InstanceSlot != INDEX_NONE)
+    {
+        const FLayoutLensTransformFragment& Transform = EntityManager->GetFragmentDataChecked<FLayoutLensTransformFragment>(*ExistingEntity);
+        const FLayoutLensFootprintFragment& Footprint = EntityManager->GetFragmentDataChecked<FLayoutLensFootprintFragment>(*ExistingEntity);
+        Pool.Update(Render.InstanceSlot, MakeInstanceTransform(Transform.CenterCm, Transform.Rotation, Footprint.SizeCm, Render.LodLevel));
+    }
+}
+
+void FLayoutLensMassRepresentation::RemoveElement(const FString& ElementId)
+{
+    FMassEntityHandle Entity;
+    if (!EntityManager.IsValid() || !EntityById.RemoveAndCopyValue(ElementId, Entity))
+    {
+        return;
+    }
+
+    const FLayoutLensRenderFragment& Render = EntityManager->GetFragmentDataChecked<FLayoutLensRenderFragment>(Entity);
+    if (Render.InstanceSlot != INDEX_NONE)
+    {
+        TArray<int32> ReleasedSlots = { Render.InstanceSlot };
+        Pool.Release(ReleasedSlots);
+    }
+
+    EntityManager->DestroyEntity(Entity);
+}
+
+void FLayoutLensMassRepresentation::UpdateLod(const FVector& ViewLocationCm, float FullDetailDistanceCm, float CullDistanceCm, int32 MaxLodChangesPerUpdate)
+{
+    if (!EntityManager.IsValid() || EntityById.Num() == 0)
+    {
+        return;
+    }
+
+    const float FullDetailDistanceSquared = FMath::Square(FullDetailDistanceCm);
+    const float CullDistanceSquared = FMath::Square(CullDistanceCm);
+    int32 RemainingChanges = MaxLodChangesPerUpdate;
+
+    TArray<FTransform> ShownTransforms;
+    TArray<int32> ShownEntityIndices;
+    TArray<int32> ShownSlots;
+    TArray<int32> HiddenSlots;
+
+    FMassExecutionContext ExecutionContext(*EntityManager);
+
+    LodQuery.ForEachEntityChunk(ExecutionContext, [&](FMassExecutionContext& Context)
+    {
+        if (RemainingChanges <= 0)
+        {
+            return;
+        }
+
+        const TConstArrayView<FLayoutLensTransformFragment> Transforms = Context.GetFragmentView<FLayoutLensTransformFragment>();
+        const TConstArrayView<FLayoutLensFootprintFragment> Footprints = Context.GetFragmentView<FLayoutLensFootprintFragment>();
+        const TArrayView<FLayoutLensRenderFragment> Renders = Context.GetMutableFragmentView<FLayoutLensRenderFragment>();
+
+        ShownTransforms.Reset();
+        ShownEntityIndices.Reset();
+
+        for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities() && RemainingChanges > 0; EntityIndex++)
+        {
+            const FLayoutLensTransformFragment& Transform = Transforms[EntityIndex];
+            FLayoutLensRenderFragment& Render = Renders[EntityIndex];
+
+            const float DistanceSquared = FVector::DistSquared(Transform.CenterCm, ViewLocationCm);
+            const uint8 DesiredLod =
+                DistanceSquared <= FullDetailDistanceSquared ? LodFull :
+                DistanceSquared <= CullDistanceSquared ? LodFootprint : LodCulled;
+
+            if (DesiredLod == Render.LodLevel)
+            {
+                continue;
+            }
+
+            RemainingChanges--;
+            Render.LodLevel = DesiredLod;
+
+            if (DesiredLod == LodCulled)
+            {
+                HiddenSlots.Add(Render.InstanceSlot);
+                Render.InstanceSlot = INDEX_NONE;
+                continue;
+            }
+
+            const FTransform InstanceTransform = MakeInstanceTransform(Transform.CenterCm, Transform.Rotation, Footprints[EntityIndex].SizeCm, DesiredLod);
+
+            if (Render.InstanceSlot != INDEX_NONE)
+            {
+                Pool.Update(Render.InstanceSlot, InstanceTransform);
+            }
+            else
+            {
+                ShownTransforms.Add(InstanceTransform);
+                ShownEntityIndices.Add(EntityIndex);
+            }
+        }
+
+        ShownSlots.Reset();
+        Pool.Acquire(ShownTransforms, ShownSlots);
+
+        for (int32 Index = 0; Index < ShownSlots.Num(); Index++)
+        {
+            Renders[ShownEntityIndices[Index]].InstanceSlot = ShownSlots[Index];
+        }
+    });
+
+    Pool.Release(HiddenSlots);
+}
+
+bool FLayoutLensMassRepresentation::FindElement(const FString& ElementId, FVector& OutCenterCm, FVector& OutSizeCm) const
+{
+    const FMassEntityHandle* Entity = EntityById.Find(ElementId);
+    if (!EntityManager.IsValid() || Entity == nullptr)
+    {
+        return false;
+    }
+
+    OutCenterCm = EntityManager->GetFragmentDataChecked<FLayoutLensTransformFragment>(*Entity).CenterCm;
+    OutSizeCm = EntityManager->GetFragmentDataChecked<FLayoutLensFootprintFragment>(*Entity).SizeCm;
+    return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensInstancePool.h"
+#include "LayoutLensRoomPlanTypes.h"
+#include "MassEntityQuery.h"
+
+struct FMassEntityManager;
+class FLayoutLensPlacementIndex;
+class UInstancedStaticMeshComponent;
+
+/*
+ * Element representation for very large plans: each placed element is a Mass entity with transform,
+ * footprint, metadata and render fragments, boxed by the visualizer's placement index so "on" and "wall"
+ * elements sit where the other representations put them. UpdateLod walks the entities chunk by chunk and maps them
+ * to instance slots of one ISM: full box up close, a flat footprint further out, nothing beyond that.
+ * At most MaxLodChangesPerUpdate entities change LOD per call, so large loads fill in over a few updates.
+ */
+class FLayoutLensMassRepresentation
+{
+public:
+    enum : uint8
+    {
+        LodFull = 0,
+        LodFootprint = 1,
+        LodCulled = 2
+    };
+
+    bool Initialize(UWorld* World, UInstancedStaticMeshComponent* InstanceComponent);
+    void Reset();
+
+    // Applied to element boxes written from now on.
+    void SetPlanToWorld(const FTransform& InPlanToWorld) { PlanToWorld = InPlanToWorld; }
+
+    void SyncElements(const TArray<FLayoutLensElement>& Elements, const FLayoutLensPlacementIndex& Placement);
+    void SetElement(const FLayoutLensElement& Element, const FLayoutLensPlacementIndex& Placement);
+    void RemoveElement(const FString& ElementId);
+
+    void UpdateLod(const FVector& ViewLocationCm, float FullDetailDistanceCm, float CullDistanceCm, int32 MaxLodChangesPerUpdate);
+
+    bool FindElement(const FString& ElementId, FVector& OutCenterCm, FVector& OutSizeCm) const;
+    int32 GetEntityCount() const { return EntityById.Num(); }
+    int32 GetVisibleCount() const { return Pool.GetUsedCount(); }
+
+private:
+    static FTransform MakeInstanceTransform(const FVector& CenterCm, const FRotator& Rotation, const FVector& SizeCm, uint8 LodLevel);
+
+    void WriteElementFragments(const FMassEntityHandle& Entity, const FLayoutLensElement& Element, const FLayoutLensPlacementIndex& Placement);
+
+private:
+    TSharedPtr<FMassEntityManager> EntityManager;
+    FMassArchetypeHandle Archetype;
+    FMassEntityQuery LodQuery;
+
+    FLayoutLensInstancePool Pool;
+    FTransform PlanToWorld = FTransform::Identity;
+    TMap<FString, FMassEntityHandle> EntityById;
+};
@@ -0,0 +1,63 @@
+#include "LayoutLensMeshCatalog.h"
+
+#include "Engine/StaticMesh.h"
+
+const FLayoutLensMeshCatalogEntry* ULayoutLensMeshCatalog::FindEntry(const FString& Label) const
+{
+    if (!bEntryIndexBuilt)
+    {
+        EntryIndexByLabel.Empty();
+
+        for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
+        {
+            for (const FString& EntryLabel : Entries[EntryIndex].Labels)
+            {
+                // First entry wins so reordering the list is how duplicates are resolved.
+                if (!EntryLabel.IsEmpty() && !EntryIndexByLabel.Contains(EntryLabel.ToLower()))
+                {
+                    EntryIndexByLabel.Add(EntryLabel.ToLower(), EntryIndex);
+                }
+            }
+        }
+
+        bEntryIndexBuilt = true;
+    }
+
+    const int32* EntryIndex = EntryIndexByLabel.Find(Label.ToLower());
+    return EntryIndex != nullptr ? &Entries[*EntryIndex] : nullptr;
+}
+
+FTransform ULayoutLensMeshCatalog::FitMeshToBox(const FLayoutLensMeshCatalogEntry& Entry, const UStaticMesh& Mesh, const FVector& BoxSizeCm)
+{
+    const FQuat YawOffset(FRotator(0.0f, Entry.YawOffsetDeg, 0.0f));
+    const FBox TurnedBounds = Mesh.GetBoundingBox().TransformBy(FTransform(YawOffset));
+    const FVector TurnedSizeCm = TurnedBounds.GetSize().ComponentMax(FVector(1.0));
+
+    FVector BoxScale = FVector::OneVector;
+
+    if (Entry.Fit == ELayoutLensMeshFit::Stretch)
+    {
+        BoxScale = BoxSizeCm / TurnedSizeCm;
+    }
+    else if (Entry.Fit == ELayoutLensMeshFit::Uniform)
+    {
+        BoxScale = FVector((BoxSizeCm / TurnedSizeCm).GetMin());
+    }
+
+    // The scale is meant along the box axes; turned back into mesh axes it is applied before the yaw.
+    const FVector MeshScale = YawOffset.UnrotateVector(BoxScale).GetAbs();
+
+    const FVector ScaledCenter = TurnedBounds.GetCenter() * BoxScale;
+    const FVector Offset(-ScaledCenter.X, -ScaledCenter.Y, -BoxSizeCm.Z * 0.5 - TurnedBounds.Min.Z * BoxScale.Z);
+
+    return FTransform(YawOffset, Offset, MeshScale);
+}
+
+#if WITH_EDITOR
+void ULayoutLensMeshCatalog::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    bEntryIndexBuilt = false;
+}
+#endif
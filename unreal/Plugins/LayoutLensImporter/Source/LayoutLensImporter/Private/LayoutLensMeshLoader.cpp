@@ -0,0 +1,135 @@
+#include "LayoutLensMeshLoader.h"
+
+#include "Containers/Ticker.h"
+#include "Engine/StaticMesh.h"
+
+FLayoutLensMeshLoader& FLayoutLensMeshLoader::Get()
+{
+    // Never destroyed: FStreamableManager is an FGCObject, which must not unregister after the garbage collector has shut down.
+    static FLayoutLensMeshLoader* Instance = new FLayoutLensMeshLoader();
+    return *Instance;
+}
+
+UStaticMesh* FLayoutLensMeshLoader::RequestMesh(const TSoftObjectPtr<UStaticMesh>& Mesh, TFunction<void(UStaticMesh*)> OnLoaded)
+{
+    if (UStaticMesh* LoadedMesh = Mesh.Get())
+    {
+        return LoadedMesh;
+    }
+
+    const FSoftObjectPath Path = Mesh.ToSoftObjectPath();
+    if (Path.IsNull())
+    {
+        return nullptr;
+    }
+
+    TArray<TFunction<void(UStaticMesh*)>>* Callbacks = CallbacksByPath.Find(Path);
+    if (Callbacks == nullptr)
+    {
+        Callbacks = &CallbacksByPath.Add(Path);
+        QueuedPaths.Add(Path);
+
+        if (!bFlushScheduled)
+        {
+            bFlushScheduled = true;
+            FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float)
+            {
+                FLayoutLensMeshLoader::Get().FlushQueuedPaths();
+                return false;
+            }));
+        }
+    }
+
+    Callbacks->Add(MoveTemp(OnLoaded));
+    return nullptr;
+}
+
+void FLayoutLensMeshLoader::FlushQueuedPaths()
+{
+    bFlushScheduled = false;
+
+    if (QueuedPaths.Num() == 0)
+    {
+        return;
+    }
+
+    const int32 BatchId = NextBatchId++;
+    FBatch& Batch = Batches.Add(BatchId);
+    Batch.OutstandingPaths = QueuedPaths;
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: streaming %d catalogue meshes"), QueuedPaths.Num());
+
+    // Paths already in memory can complete inside RequestAsyncLoad, so the batch is registered first.
+    TSharedPtr<FStreamableHandle> Handle = StreamableManager.RequestAsyncLoad(
+        MoveTemp(QueuedPaths),
+        FStreamableDelegate::CreateRaw(this, &FLayoutLensMeshLoader::NotifyLoadedPaths, BatchId, true));
+    QueuedPaths.Reset();
+
+    if (!Handle.IsValid())
+    {
+        NotifyLoadedPaths(BatchId, true);
+        return;
+    }
+
+    // A batch that completed inside RequestAsyncLoad has run its callbacks already, so its handle can go.
+    if (FBatch* PendingBatch = Batches.Find(BatchId))
+    {
+        PendingBatch->Handle = Handle;
+        Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateLambda([this, BatchId](TSharedRef<FStreamableHandle>)
+        {
+            NotifyLoadedPaths(BatchId, false);
+        }));
+    }
+}
+
+void FLayoutLensMeshLoader::NotifyLoadedPaths(int32 BatchId, bool bBatchComplete)
+{
+    FBatch* Batch = Batches.Find(BatchId);
+    if (Batch == nullptr)
+    {
+        return;
+    }
+
+    TArray<TPair<UStaticMesh*, TArray<TFunction<void(UStaticMesh*)>>>> Ready;
+
+    for (int32 PathIndex = Batch->OutstandingPaths.Num() - 1; PathIndex >= 0; PathIndex--)
+    {
+        const FSoftObjectPath& Path = Batch->OutstandingPaths[PathIndex];
+        UObject* LoadedObject = Path.ResolveObject();
+
+        if (LoadedObject == nullptr && !bBatchComplete)
+        {
+            continue;
+        }
+
+        UStaticMesh* LoadedMesh = Cast<UStaticMesh>(LoadedObject);
+        if (LoadedMesh == nullptr)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("LayoutLens: catalogue mesh %s did not load as a static mesh"), *Path.ToString());
+        }
+
+        TPair<UStaticMesh*, TArray<TFunction<void(UStaticMesh*)>>>& Entry = Ready.AddDefaulted_GetRef();
+        Entry.Key = LoadedMesh;
+        CallbacksByPath.RemoveAndCopyValue(Path, Entry.Value);
+
+        Batch->OutstandingPaths.RemoveAtSwap(PathIndex, EAllowShrinking::No);
+    }
+
+    // Held until the callbacks have had their chance to put the meshes to use; released when this returns.
+    TSharedPtr<FStreamableHandle> CompletedHandle;
+
+    if (bBatchComplete)
+    {
+        CompletedHandle = MoveTemp(Batch->Handle);
+        Batches.Remove(BatchId);
+    }
+
+    // Callbacks run last because they may queue further requests.
+    for (TPair<UStaticMesh*, TArray<TFunction<void(UStaticMesh*)>>>& Entry : Ready)
+    {
+        for (TFunction<void(UStaticMesh*)>& Callback : Entry.Value)
+        {
+            Callback(Entry.Key);
+        }
+    }
+}
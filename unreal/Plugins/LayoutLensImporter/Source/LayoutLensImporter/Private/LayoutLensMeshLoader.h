@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/StreamableManager.h"
+
+class UStaticMesh;
+
+/*
+ * Process-wide async loader for catalogue meshes. Requests for the same path share one load, and every path
+ * requested during a frame goes out next tick as a single FStreamableManager batch. Requesters hear back as
+ * soon as their own mesh is in rather than when the whole batch is, so one slow package never holds up the
+ * rest. A batch's handle is released once its callbacks have run: requesters keep a mesh alive by using it
+ * (an ISM or mesh component references it), and a mesh nothing uses any more can be collected and is loaded
+ * again on the next request. Game thread only.
+ */
+class FLayoutLensMeshLoader
+{
+public:
+    static FLayoutLensMeshLoader& Get();
+
+    // The mesh if it is already in memory. Otherwise nullptr, and OnLoaded runs once the load ends
+    // (with nullptr when the path does not resolve to a static mesh).
+    UStaticMesh* RequestMesh(const TSoftObjectPtr<UStaticMesh>& Mesh, TFunction<void(UStaticMesh*)> OnLoaded);
+
+    int32 GetPendingCount() const { return CallbacksByPath.Num(); }
+
+private:
+    FLayoutLensMeshLoader() = default;
+
+    struct FBatch
+    {
+        TSharedPtr<FStreamableHandle> Handle;
+        TArray<FSoftObjectPath> OutstandingPaths;
+    };
+
+    void FlushQueuedPaths();
+    void NotifyLoadedPaths(int32 BatchId, bool bBatchComplete);
+
+private:
+    FStreamableManager StreamableManager;
+
+    TMap<FSoftObjectPath, TArray<TFunction<void(UStaticMesh*)>>> CallbacksByPath;
+    TArray<FSoftObjectPath> QueuedPaths;
+    bool bFlushScheduled = false;
+
+    TMap<int32, FBatch> Batches;
+    int32 NextBatchId = 0;
+};
@@ -0,0 +1,265 @@
+#include "LayoutLensMeshSubstitution.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "LayoutLensFurnitureMesh.h"
+#include "LayoutLensMeshCatalog.h"
+#include "LayoutLensMeshLoader.h"
+#include "LayoutLensPlanGeometry.h"
+
+void FLayoutLensMeshSubstitution::Initialize(const ULayoutLensMeshCatalog* InCatalog, float InFurnitureStepCm, FCreateComponent InCreateComponent, FOnMeshReady InOnMeshReady)
+{
+    Reset();
+
+    Catalog = InCatalog;
+    FurnitureStepCm = InFurnitureStepCm;
+    CreateComponent = MoveTemp(InCreateComponent);
+    OnMeshReady = MoveTemp(InOnMeshReady);
+    FailedPaths.Empty();
+}
+
+void FLayoutLensMeshSubstitution::Reset()
+{
+    for (TPair<TObjectKey<UStaticMesh>, FMeshInstances>& Pair : InstancesByMesh)
+    {
+        Pair.Value.Pool.Reset();
+    }
+
+    PlacedById.Empty();
+    ElementsAwaitingPath.Empty();
+}
+
+UStaticMesh* FLayoutLensMeshSubstitution::ResolveMesh(const FLayoutLensElement& Element, const FVector& BoxSizeCm, FTransform& OutRelativeTransform)
+{
+    bool bGenerated = false;
+    return ResolveMesh(Element, BoxSizeCm, OutRelativeTransform, bGenerated);
+}
+
+UStaticMesh* FLayoutLensMeshSubstitution::ResolveMesh(const FLayoutLensElement& Element, const FVector& BoxSizeCm, FTransform& OutRelativeTransform, bool& bOutGenerated)
+{
+    const ULayoutLensMeshCatalog* MeshCatalog = Catalog.Get();
+    const FLayoutLensMeshCatalogEntry* Entry = MeshCatalog != nullptr ? MeshCatalog->FindEntry(Element.Label) : nullptr;
+
+    bOutGenerated = false;
+
+    if (Entry == nullptr || Entry->Mesh.IsNull())
+    {
+        if (FurnitureStepCm <= 0.0f)
+        {
+            return nullptr;
+        }
+
+        bOutGenerated = true;
+        return FLayoutLensFurnitureMeshCache::Get().FindOrBuild(
+            FLayoutLensFurnitureMesh::ClassifyLabel(Element.Label), BoxSizeCm, FurnitureStepCm, OutRelativeTransform);
+    }
+
+    UStaticMesh* Mesh = FindOrRequestMesh(Entry->Mesh, Element.Id);
+    if (Mesh != nullptr)
+    {
+        OutRelativeTransform = ULayoutLensMeshCatalog::FitMeshToBox(*Entry, *Mesh, BoxSizeCm);
+    }
+
+    return Mesh;
+}
+
+bool FLayoutLensMeshSubstitution::SetInstance(const FLayoutLensElement& Element, const FLayoutLensBox& WorldBox)
+{
+    FTransform RelativeTransform;
+    bool bGenerated = false;
+    UStaticMesh* Mesh = ResolveMesh(Element, WorldBox.SizeCm, RelativeTransform, bGenerated);
+
+    FPlacedInstance* Placed = PlacedById.Find(Element.Id);
+
+    if (Placed != nullptr && Placed->Mesh != TObjectKey<UStaticMesh>(Mesh))
+    {
+        RemoveElement(Element.Id);
+        Placed = nullptr;
+    }
+
+    if (Mesh == nullptr)
+    {
+        return false;
+    }
+
+    const FTransform InstanceTransform = RelativeTransform * FTransform(WorldBox.Rotation, WorldBox.CenterCm);
+
+    if (Placed != nullptr)
+    {
+        InstancesByMesh[Placed->Mesh].Pool.Update(Placed->Slot, InstanceTransform);
+        return true;
+    }
+
+    FMeshInstances* Instances = FindOrCreateInstances(Mesh, bGenerated);
+    if (Instances == nullptr)
+    {
+        return false;
+    }
+
+    TArray<int32> Slots;
+    Instances->Pool.Acquire({ InstanceTransform }, Slots);
+    if (Slots.Num() != 1)
+    {
+        return false;
+    }
+
+    FPlacedInstance& NewPlaced = PlacedById.Add(Element.Id);
+    NewPlaced.Mesh = Mesh;
+    NewPlaced.Slot = Slots[0];
+    return true;
+}
+
+void FLayoutLensMeshSubstitution::RemoveElement(const FString& ElementId)
+{
+    FPlacedInstance Placed;
+    if (!PlacedById.RemoveAndCopyValue(ElementId, Placed))
+    {
+        return;
+    }
+
+    if (FMeshInstances* Instances = InstancesByMesh.Find(Placed.Mesh))
+    {
+        TArray<int32> Slots = { Placed.Slot };
+        Instances->Pool.Release(Slots);
+    }
+}
+
+void FLayoutLensMeshSubstitution::SetCustomData(const FString& ElementId, TArrayView<const float> CustomData)
+{
+    int32 Slot = INDEX_NONE;
+    if (UInstancedStaticMeshComponent* Component = FindPlacedComponent(ElementId, Slot))
+    {
+        Component->SetCustomData(Slot, CustomData, false);
+    }
+}
+
+void FLayoutLensMeshSubstitution::SetCustomDataValue(const FString& ElementId, int32 CustomDataIndex, float Value)
+{
+    int32 Slot = INDEX_NONE;
+    if (UInstancedStaticMeshComponent* Component = FindPlacedComponent(ElementId, Slot))
+    {
+        Component->SetCustomDataValue(Slot, CustomDataIndex, Value, true);
+    }
+}
+
+void FLayoutLensMeshSubstitution::MarkRenderStateDirty()
+{
+    for (const TPair<TObjectKey<UStaticMesh>, FMeshInstances>& Pair : InstancesByMesh)
+    {
+        if (UInstancedStaticMeshComponent* Component = Pair.Value.Component.Get())
+        {
+            Component->MarkRenderStateDirty();
+        }
+    }
+}
+
+void FLayoutLensMeshSubstitution::SetVisibility(bool bInVisible)
+{
+    bVisible = bInVisible;
+
+    for (const TPair<TObjectKey<UStaticMesh>, FMeshInstances>& Pair : InstancesByMesh)
+    {
+        if (UInstancedStaticMeshComponent* Component = Pair.Value.Component.Get())
+        {
+            Component->SetVisibility(bVisible);
+        }
+    }
+}
+
+int32 FLayoutLensMeshSubstitution::GetAwaitingCount() const
+{
+    int32 AwaitingCount = 0;
+    for (const TPair<FSoftObjectPath, TSet<FString>>& Pair : ElementsAwaitingPath)
+    {
+        AwaitingCount += Pair.Value.Num();
+    }
+    return AwaitingCount;
+}
+
+UStaticMesh* FLayoutLensMeshSubstitution::FindOrRequestMesh(const TSoftObjectPtr<UStaticMesh>& Mesh, const FString& ElementId)
+{
+    if (UStaticMesh* LoadedMesh = Mesh.Get())
+    {
+        return LoadedMesh;
+    }
+
+    const FSoftObjectPath Path = Mesh.ToSoftObjectPath();
+    if (FailedPaths.Contains(Path))
+    {
+        return nullptr;
+    }
+
+    if (TSet<FString>* Awaiting = ElementsAwaitingPath.Find(Path))
+    {
+        Awaiting->Add(ElementId);
+        return nullptr;
+    }
+
+    ElementsAwaitingPath.Add(Path).Add(ElementId);
+
+    TWeakPtr<FLayoutLensMeshSubstitution> WeakThis = AsShared();
+    return FLayoutLensMeshLoader::Get().RequestMesh(Mesh, [WeakThis, Path](UStaticMesh* LoadedMesh)
+    {
+        if (TSharedPtr<FLayoutLensMeshSubstitution> Substitution = WeakThis.Pin())
+        {
+            Substitution->HandleMeshLoaded(Path, LoadedMesh);
+        }
+    });
+}
+
+void FLayoutLensMeshSubstitution::HandleMeshLoaded(const FSoftObjectPath& Path, UStaticMesh* Mesh)
+{
+    TSet<FString> ElementIds;
+    ElementsAwaitingPath.RemoveAndCopyValue(Path, ElementIds);
+
+    if (Mesh == nullptr)
+    {
+        FailedPaths.Add(Path);
+        return;
+    }
+
+    if (OnMeshReady)
+    {
+        for (const FString& ElementId : ElementIds)
+        {
+            OnMeshReady(ElementId);
+        }
+    }
+}
+
+FLayoutLensMeshSubstitution::FMeshInstances* FLayoutLensMeshSubstitution::FindOrCreateInstances(UStaticMesh* Mesh, bool bGenerated)
+{
+    FMeshInstances* Instances = InstancesByMesh.Find(Mesh);
+    if (Instances != nullptr && Instances->Component.IsValid())
+    {
+        return Instances;
+    }
+
+    UInstancedStaticMeshComponent* Component = CreateComponent ? CreateComponent(Mesh, bGenerated) : nullptr;
+    if (Component == nullptr)
+    {
+        return nullptr;
+    }
+
+    Component->SetVisibility(bVisible);
+
+    Instances = &InstancesByMesh.Add(Mesh);
+    Instances->Component = Component;
+    // Boxes arrive in world space whether or not the owner's components follow its actor.
+    Instances->Pool.Initialize(Component, true);
+    return Instances;
+}
+
+UInstancedStaticMeshComponent* FLayoutLensMeshSubstitution::FindPlacedComponent(const FString& ElementId, int32& OutSlot) const
+{
+    const FPlacedInstance* Placed = PlacedById.Find(ElementId);
+    const FMeshInstances* Instances = Placed != nullptr ? InstancesByMesh.Find(Placed->Mesh) : nullptr;
+
+    if (Instances == nullptr)
+    {
+        return nullptr;
+    }
+
+    OutSlot = Placed->Slot;
+    return Instances->Component.Get();
+}
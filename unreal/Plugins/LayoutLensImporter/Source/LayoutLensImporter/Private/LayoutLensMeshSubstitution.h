@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensInstancePool.h"
+#include "UObject/ObjectKey.h"
+
+class UInstancedStaticMeshComponent;
+class ULayoutLensMeshCatalog;
+class UStaticMesh;
+struct FLayoutLensBox;
+struct FLayoutLensElement;
+
+/*
+ * Swaps placeholder cubes for the meshes a ULayoutLensMeshCatalog assigns to element labels, or for generated
+ * furniture when a label has no catalogue mesh. The instanced
+ * representation gets one pooled ISM per mesh; actors are handed the mesh and its fit. An element whose mesh
+ * is still streaming keeps its cube, and is reported through the ready callback once the mesh arrives so the
+ * owner can update it again.
+ */
+class FLayoutLensMeshSubstitution : public TSharedFromThis<FLayoutLensMeshSubstitution>
+{
+public:
+    // Creates and registers an ISM for one mesh; the owner keeps it alive. bGenerated marks furniture meshes.
+    using FCreateComponent = TFunction<UInstancedStaticMeshComponent*(UStaticMesh*, bool bGenerated)>;
+    using FOnMeshReady = TFunction<void(const FString& ElementId)>;
+
+    // FurnitureStepCm is the size rounding of generated meshes; 0 turns generation off.
+    void Initialize(const ULayoutLensMeshCatalog* InCatalog, float InFurnitureStepCm, FCreateComponent InCreateComponent, FOnMeshReady InOnMeshReady);
+    void Reset();
+
+    // Loaded or generated mesh for the element and its box-relative transform; nullptr while streaming or
+    // when the element stays a box.
+    UStaticMesh* ResolveMesh(const FLayoutLensElement& Element, const FVector& BoxSizeCm, FTransform& OutRelativeTransform);
+
+    // Places or moves the element's catalogue instance. False means the cube should stay visible.
+    bool SetInstance(const FLayoutLensElement& Element, const FLayoutLensBox& WorldBox);
+    void RemoveElement(const FString& ElementId);
+
+    // Mirrors the cube slot's per-instance custom data onto the element's catalogue instance.
+    void SetCustomData(const FString& ElementId, TArrayView<const float> CustomData);
+    void SetCustomDataValue(const FString& ElementId, int32 CustomDataIndex, float Value);
+    void MarkRenderStateDirty();
+
+    void SetVisibility(bool bVisible);
+
+    int32 GetPlacedCount() const { return PlacedById.Num(); }
+    int32 GetAwaitingCount() const;
+
+private:
+    struct FMeshInstances
+    {
+        TWeakObjectPtr<UInstancedStaticMeshComponent> Component;
+        FLayoutLensInstancePool Pool;
+    };
+
+    struct FPlacedInstance
+    {
+        TObjectKey<UStaticMesh> Mesh;
+        int32 Slot = INDEX_NONE;
+    };
+
+    UStaticMesh* ResolveMesh(const FLayoutLensElement& Element, const FVector& BoxSizeCm, FTransform& OutRelativeTransform, bool& bOutGenerated);
+    UStaticMesh* FindOrRequestMesh(const TSoftObjectPtr<UStaticMesh>& Mesh, const FString& ElementId);
+    void HandleMeshLoaded(const FSoftObjectPath& Path, UStaticMesh* Mesh);
+    FMeshInstances* FindOrCreateInstances(UStaticMesh* Mesh, bool bGenerated);
+    UInstancedStaticMeshComponent* FindPlacedComponent(const FString& ElementId, int32& OutSlot) const;
+
+private:
+    TWeakObjectPtr<const ULayoutLensMeshCatalog> Catalog;
+    float FurnitureStepCm = 0.0f;
+    FCreateComponent CreateComponent;
+    FOnMeshReady OnMeshReady;
+
+    TMap<TObjectKey<UStaticMesh>, FMeshInstances> InstancesByMesh;
+    TMap<FString, FPlacedInstance> PlacedById;
+
+    // Only the first element to need a path asks the loader; the rest wait here.
+    TMap<FSoftObjectPath, TSet<FString>> ElementsAwaitingPath;
+    TSet<FSoftObjectPath> FailedPaths;
+
+    bool bVisible = true;
+};
@@ -0,0 +1,226 @@
+#include "LayoutLensNavObstacleComponent.h"
+
+#include "AI/Navigation/NavigationRelevantData.h"
+#include "AI/NavigationModifier.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "NavAreas/NavArea_Null.h"
+#include "NavigationData.h"
+#include "NavigationPath.h"
+#include "NavigationSystem.h"
+
+namespace
+{
+    FLayoutLensPoint2D MakePoint(float X, float Y)
+    {
+        FLayoutLensPoint2D Point;
+        Point.X = X;
+        Point.Y = Y;
+        return Point;
+    }
+
+    // A 10 x 6 m room with a door near the west end of its south wall and a 1 x 5 m rack standing out from
+    // that wall at x = 5 m, so a walk from one side of the rack to the other has to go round its free end.
+    FLayoutLensRoomPlan MakeSelfTestPlan()
+    {
+        FLayoutLensRoomPlan Plan;
+        Plan.RoomHeightMeters = 2.7f;
+        Plan.Boundary = { MakePoint(0.0f, 0.0f), MakePoint(10.0f, 0.0f), MakePoint(10.0f, 6.0f), MakePoint(0.0f, 6.0f) };
+
+        FLayoutLensOpening& Door = Plan.Openings.AddDefaulted_GetRef();
+        Door.Kind = TEXT("door");
+        Door.EdgeIndex = 0;
+        Door.Center01 = 0.2f;
+        Door.WidthMeters = 1.2f;
+
+        FLayoutLensElement& Rack = Plan.Elements.AddDefaulted_GetRef();
+        Rack.Id = TEXT("selftest_rack");
+        Rack.Label = TEXT("rack");
+        Rack.Placement = TEXT("floor");
+        Rack.WidthMeters = 1.0f;
+        Rack.DepthMeters = 5.0f;
+        Rack.HeightMeters = 2.0f;
+        Rack.Transform.X = 5.0f;
+        Rack.Transform.Y = 2.5f;
+
+        return Plan;
+    }
+
+    bool FindSelfTestPath(UNavigationSystemV1& NavSys, UWorld& World, const FVector& FromCm, const FVector& ToCm, float& OutLengthCm)
+    {
+        const FVector QueryExtent(50.0f, 50.0f, 250.0f);
+
+        FNavLocation From;
+        FNavLocation To;
+        if (!NavSys.ProjectPointToNavigation(FromCm, From, QueryExtent) || !NavSys.ProjectPointToNavigation(ToCm, To, QueryExtent))
+        {
+            return false;
+        }
+
+        const UNavigationPath* Path = NavSys.FindPathToLocationSynchronously(&World, From.Location, To.Location);
+        if (Path == nullptr || !Path->IsValid() || Path->IsPartial())
+        {
+            return false;
+        }
+
+        OutLengthCm = Path->GetPathLength();
+        return true;
+    }
+
+    // Registers the synthetic plan's obstacles on a throwaway actor, builds the navmesh synchronously and checks
+    // a few queries against it. Args: optional plan origin in world centimetres (X Y Z).
+    void RunNavigationSelfTest(const TArray<FString>& Args, UWorld* World)
+    {
+        UNavigationSystemV1* NavSys = World != nullptr ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(World) : nullptr;
+        if (NavSys == nullptr || NavSys->GetDefaultNavDataInstance() == nullptr)
+        {
+            UE_LOG(LogTemp, Error, TEXT("LayoutLens: Navigation self-test needs a navigation system and a NavMeshBoundsVolume in the level."));
+            return;
+        }
+
+        const ANavigationData* NavData = NavSys->GetDefaultNavDataInstance();
+        if (World->IsGameWorld() && NavData->GetRuntimeGenerationMode() == ERuntimeGenerationType::Static)
+        {
+            UE_LOG(LogTemp, Error, TEXT("LayoutLens: Navigation self-test needs Runtime Generation set to Dynamic or Dynamic Modifiers Only."));
+            return;
+        }
+
+        FVector OriginCm = FVector::ZeroVector;
+        if (Args.Num() >= 3)
+        {
+            OriginCm = FVector(FCString::Atof(*Args[0]), FCString::Atof(*Args[1]), FCString::Atof(*Args[2]));
+        }
+
+        const FLayoutLensRoomPlan Plan = MakeSelfTestPlan();
+
+        TArray<FLayoutLensBox> Boxes;
+        FLayoutLensPlanGeometry::BuildWallBoxesWithDoorGaps(Plan, 20.0f, Boxes);
+        for (const FLayoutLensElement& Element : Plan.Elements)
+        {
+            Boxes.Add(FLayoutLensPlanGeometry::MakeElementBox(Element));
+        }
+
+        for (FLayoutLensBox& Box : Boxes)
+        {
+            Box.CenterCm += OriginCm;
+        }
+
+        FActorSpawnParameters SpawnParameters;
+        SpawnParameters.ObjectFlags = RF_Transient;
+        AActor* Holder = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform(OriginCm), SpawnParameters);
+        if (Holder == nullptr)
+        {
+            return;
+        }
+
+        // Small cells so the room spreads over several components, as a large plan would.
+        TMap<FIntPoint, TArray<FLayoutLensBox>> Cells;
+        ULayoutLensNavObstacleComponent::BucketObstacles(Boxes, 500.0f, Cells);
+
+        for (TPair<FIntPoint, TArray<FLayoutLensBox>>& Cell : Cells)
+        {
+            ULayoutLensNavObstacleComponent* Component = NewObject<ULayoutLensNavObstacleComponent>(Holder, NAME_None, RF_Transient);
+            const uint64 CellHash = FLayoutLensPlanGeometry::HashBoxes(Cell.Value);
+            Component->SetObstacles(MoveTemp(Cell.Value), CellHash);
+            Component->RegisterComponent();
+        }
+
+        const double StartSeconds = FPlatformTime::Seconds();
+        NavSys->Build();
+        const double BuildMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+        // West of the rack to east of it: the straight line is 4 m, round the rack's free end is about 11 m.
+        const FVector WestCm = OriginCm + FVector(300.0f, 150.0f, 0.0f);
+        const FVector EastCm = OriginCm + FVector(700.0f, 150.0f, 0.0f);
+        // Out through the door on the south wall.
+        const FVector OutsideCm = OriginCm + FVector(200.0f, -200.0f, 0.0f);
+
+        float AroundRackCm = 0.0f;
+        float ThroughDoorCm = 0.0f;
+        const bool bAroundRack = FindSelfTestPath(*NavSys, *World, WestCm, EastCm, AroundRackCm) && AroundRackCm > 800.0f;
+        const bool bThroughDoor = FindSelfTestPath(*NavSys, *World, WestCm, OutsideCm, ThroughDoorCm);
+
+        FNavLocation Unused;
+        const bool bRackBlocked = !NavSys->ProjectPointToNavigation(OriginCm + FVector(500.0f, 250.0f, 0.0f), Unused, FVector(10.0f, 10.0f, 250.0f));
+
+        Holder->Destroy();
+
+        const bool bPassed = bAroundRack && bThroughDoor && bRackBlocked;
+        UE_LOG(LogTemp, Display, TEXT("LayoutLens: Navigation self-test %s. %d boxes in %d cells, build %.1f ms; round the rack %s (%.0f cm), through the door %s (%.0f cm), rack footprint %s."),
+            bPassed ? TEXT("passed") : TEXT("FAILED"),
+            Boxes.Num(), Cells.Num(), BuildMs,
+            bAroundRack ? TEXT("ok") : TEXT("failed"), AroundRackCm,
+            bThroughDoor ? TEXT("ok") : TEXT("failed"), ThroughDoorCm,
+            bRackBlocked ? TEXT("blocked") : TEXT("walkable"));
+
+        if (!bPassed)
+        {
+            UE_LOG(LogTemp, Error, TEXT("LayoutLens: Navigation self-test failed; the paths need walkable floor under the plan origin."));
+        }
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs NavigationSelfTestCommand(
+        TEXT("LayoutLens.Nav.SelfTest"),
+        TEXT("Builds navigation over a synthetic room with a door and a rack and checks paths round them. Optional plan origin: X Y Z in cm."),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunNavigationSelfTest));
+}
+
+ULayoutLensNavObstacleComponent::ULayoutLensNavObstacleComponent()
+{
+    // Each cell is its own octree entry; attached to the owner's root they would all dirty together.
+    bAttachToOwnersRoot = false;
+}
+
+bool ULayoutLensNavObstacleComponent::SetObstacles(TArray<FLayoutLensBox>&& InObstacles, uint64 ContentHash)
+{
+    if (ContentHash == ObstacleHash && Obstacles.Num() == InObstacles.Num())
+    {
+        return false;
+    }
+
+    Obstacles = MoveTemp(InObstacles);
+    ObstacleHash = ContentHash;
+
+    if (IsRegistered())
+    {
+        RefreshNavigationModifiers();
+    }
+    return true;
+}
+
+void ULayoutLensNavObstacleComponent::BucketObstacles(const TArray<FLayoutLensBox>& Boxes, float CellSizeCm, TMap<FIntPoint, TArray<FLayoutLensBox>>& OutCells)
+{
+    OutCells.Reset();
+
+    const float SafeCellSizeCm = FMath::Max(CellSizeCm, 1.0f);
+
+    for (const FLayoutLensBox& Box : Boxes)
+    {
+        const FIntPoint Cell(FMath::FloorToInt(Box.CenterCm.X / SafeCellSizeCm), FMath::FloorToInt(Box.CenterCm.Y / SafeCellSizeCm));
+        OutCells.FindOrAdd(Cell).Add(Box);
+    }
+}
+
+void ULayoutLensNavObstacleComponent::GetNavigationData(FNavigationRelevantData& Data) const
+{
+    Super::GetNavigationData(Data);
+
+    for (const FLayoutLensBox& Box : Obstacles)
+    {
+        const FVector HalfSizeCm = Box.SizeCm * 0.5;
+        Data.Modifiers.Add(FAreaNavModifier(FBox(-HalfSizeCm, HalfSizeCm), FTransform(Box.Rotation, Box.CenterCm), UNavArea_Null::StaticClass()));
+    }
+}
+
+void ULayoutLensNavObstacleComponent::CalcAndCacheBounds() const
+{
+    Bounds = FBox(ForceInit);
+
+    for (const FLayoutLensBox& Box : Obstacles)
+    {
+        const FVector HalfSizeCm = Box.SizeCm * 0.5;
+        Bounds += FBox(-HalfSizeCm, HalfSizeCm).TransformBy(FTransform(Box.Rotation, Box.CenterCm));
+    }
+
+    bBoundsInitialized = true;
+}
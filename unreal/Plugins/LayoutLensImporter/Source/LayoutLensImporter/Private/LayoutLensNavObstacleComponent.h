@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensPlanGeometry.h"
+#include "NavRelevantComponent.h"
+#include "LayoutLensNavObstacleComponent.generated.h"
+
+/*
+ * Null-area navigation modifiers for the walls and floor elements that fall in one cell of a room. The
+ * visualizer keeps one component per occupied cell and only re-registers cells whose boxes changed, so a
+ * dynamic navmesh rebuilds the tiles under those cells and leaves the rest of the room alone.
+ */
+UCLASS()
+class ULayoutLensNavObstacleComponent : public UNavRelevantComponent
+{
+    GENERATED_BODY()
+
+public:
+    ULayoutLensNavObstacleComponent();
+
+    // World-space boxes. Returns false without touching navigation when ContentHash matches the current boxes.
+    bool SetObstacles(TArray<FLayoutLensBox>&& InObstacles, uint64 ContentHash);
+    int32 GetObstacleCount() const { return Obstacles.Num(); }
+
+    // Sorts boxes into square cells by their centres.
+    static void BucketObstacles(const TArray<FLayoutLensBox>& Boxes, float CellSizeCm, TMap<FIntPoint, TArray<FLayoutLensBox>>& OutCells);
+
+    virtual void GetNavigationData(FNavigationRelevantData& Data) const override;
+    virtual void CalcAndCacheBounds() const override;
+
+private:
+    TArray<FLayoutLensBox> Obstacles;
+    uint64 ObstacleHash = 0;
+};
@@ -0,0 +1,232 @@
+#include "LayoutLensOccupancyGrid.h"
+
+#include "LayoutLensPlanGeometry.h"
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    struct FScanPolygon
+    {
+        TArray<FVector2D> Points;
+        int32 FirstRow = 0;
+        int32 LastRow = -1;
+    };
+
+    void FillPolygonRow(
+        const TArray<FVector2D>& Points,
+        double RowY,
+        double OriginX,
+        double CellSize,
+        int32 Width,
+        uint64* RowWords)
+    {
+        FLayoutLensOccupancyGrid::ForEachRowSpan(Points, RowY, OriginX, CellSize, Width, [RowWords](int32 FirstCell, int32 LastCell)
+        {
+            FLayoutLensOccupancyGrid::FillSpan(RowWords, FirstCell, LastCell);
+        });
+    }
+}
+
+void FLayoutLensOccupancyGrid::Reset()
+{
+    Width = 0;
+    Height = 0;
+    WordsPerRow = 0;
+    InsideBits.Empty();
+    OccupiedBits.Empty();
+}
+
+void FLayoutLensOccupancyGrid::FillSpan(uint64* RowWords, int32 FirstCell, int32 LastCell)
+{
+    const int32 FirstWord = FirstCell >> 6;
+    const int32 LastWord = LastCell >> 6;
+    const uint64 FirstMask = ~0ull << (FirstCell & 63);
+    const uint64 LastMask = ~0ull >> (63 - (LastCell & 63));
+
+    if (FirstWord == LastWord)
+    {
+        RowWords[FirstWord] |= FirstMask & LastMask;
+        return;
+    }
+
+    RowWords[FirstWord] |= FirstMask;
+    for (int32 Word = FirstWord + 1; Word < LastWord; Word++)
+    {
+        RowWords[Word] = ~0ull;
+    }
+    RowWords[LastWord] |= LastMask;
+}
+
+void FLayoutLensOccupancyGrid::Build(const FLayoutLensRoomPlan& Plan, float InCellSizeMeters)
+{
+    Reset();
+
+    CellSizeMeters = FMath::Max(InCellSizeMeters, 0.01f);
+
+    if (Plan.Boundary.Num() < 3)
+    {
+        return;
+    }
+
+    TArray<FVector2D> BoundaryPoints;
+    BoundaryPoints.Reserve(Plan.Boundary.Num());
+
+    FBox2D BoundsMeters(ForceInit);
+    for (const FLayoutLensPoint2D& Point : Plan.Boundary)
+    {
+        BoundaryPoints.Add(FVector2D(Point.X, Point.Y));
+        BoundsMeters += BoundaryPoints.Last();
+    }
+
+    // One cell of outside on every side, so even a rectangle filling its bounds has wall cells around it.
+    OriginMeters = BoundsMeters.Min - FVector2D(CellSizeMeters, CellSizeMeters);
+    Width = FMath::Max(FMath::CeilToInt(BoundsMeters.GetSize().X / CellSizeMeters), 1) + 2;
+    Height = FMath::Max(FMath::CeilToInt(BoundsMeters.GetSize().Y / CellSizeMeters), 1) + 2;
+    WordsPerRow = (Width + 63) >> 6;
+
+    InsideBits.SetNumZeroed(WordsPerRow * Height);
+    OccupiedBits.SetNumZeroed(WordsPerRow * Height);
+
+    // Footprints are bucketed by the rows their centres cover (CSR layout) so each row only scans its own.
+    TArray<FScanPolygon> Footprints;
+    Footprints.Reserve(Plan.Elements.Num());
+
+    TArray<int32> RowFootprintStart;
+    RowFootprintStart.SetNumZeroed(Height + 1);
+
+    for (const FLayoutLensElement& Element : Plan.Elements)
+    {
+        if (!FLayoutLensPlanGeometry::IsFloorElement(Element))
+        {
+            continue;
+        }
+
+        FScanPolygon& Footprint = Footprints.AddDefaulted_GetRef();
+        FLayoutLensPlanGeometry::BuildElementFootprint(Element, Footprint.Points);
+
+        double MinY = Footprint.Points[0].Y;
+        double MaxY = Footprint.Points[0].Y;
+        for (const FVector2D& Point : Footprint.Points)
+        {
+            MinY = FMath::Min(MinY, Point.Y);
+            MaxY = FMath::Max(MaxY, Point.Y);
+        }
+
+        GetRowRange(MinY, MaxY, Footprint.FirstRow, Footprint.LastRow);
+
+        for (int32 Row = Footprint.FirstRow; Row <= Footprint.LastRow; Row++)
+        {
+            RowFootprintStart[Row + 1]++;
+        }
+    }
+
+    for (int32 Row = 0; Row < Height; Row++)
+    {
+        RowFootprintStart[Row + 1] += RowFootprintStart[Row];
+    }
+
+    TArray<int32> RowFootprints;
+    RowFootprints.SetNumUninitialized(RowFootprintStart[Height]);
+
+    TArray<int32> RowFill = RowFootprintStart;
+    for (int32 FootprintIndex = 0; FootprintIndex < Footprints.Num(); FootprintIndex++)
+    {
+        for (int32 Row = Footprints[FootprintIndex].FirstRow; Row <= Footprints[FootprintIndex].LastRow; Row++)
+        {
+            RowFootprints[RowFill[Row]++] = FootprintIndex;
+        }
+    }
+
+    ParallelFor(Height, [&](int32 Row)
+    {
+        const double RowY = OriginMeters.Y + (Row + 0.5) * CellSizeMeters;
+
+        FillPolygonRow(BoundaryPoints, RowY, OriginMeters.X, CellSizeMeters, Width, &InsideBits[Row * WordsPerRow]);
+
+        for (int32 Entry = RowFootprintStart[Row]; Entry < RowFootprintStart[Row + 1]; Entry++)
+        {
+            FillPolygonRow(Footprints[RowFootprints[Entry]].Points, RowY, OriginMeters.X, CellSizeMeters, Width, &OccupiedBits[Row * WordsPerRow]);
+        }
+    });
+}
+
+void FLayoutLensOccupancyGrid::GetRowRange(double MinY, double MaxY, int32& OutFirstRow, int32& OutLastRow) const
+{
+    OutFirstRow = FMath::Max(FMath::CeilToInt((MinY - OriginMeters.Y) / CellSizeMeters - 0.5), 0);
+    OutLastRow = FMath::Min(FMath::CeilToInt((MaxY - OriginMeters.Y) / CellSizeMeters - 0.5) - 1, Height - 1);
+}
+
+bool FLayoutLensOccupancyGrid::PointToCell(const FVector2D& PointMeters, int32& OutX, int32& OutY) const
+{
+    OutX = FMath::FloorToInt((PointMeters.X - OriginMeters.X) / CellSizeMeters);
+    OutY = FMath::FloorToInt((PointMeters.Y - OriginMeters.Y) / CellSizeMeters);
+    return OutX >= 0 && OutY >= 0 && OutX < Width && OutY < Height;
+}
+
+FVector2D FLayoutLensOccupancyGrid::GetCellCenterMeters(int32 X, int32 Y) const
+{
+    return OriginMeters + FVector2D(X + 0.5f, Y + 0.5f) * CellSizeMeters;
+}
+
+bool FLayoutLensOccupancyGrid::IsRectFree(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY) const
+{
+    if (MinX < 0 || MinY < 0 || MaxX >= Width || MaxY >= Height || MinX > MaxX || MinY > MaxY)
+    {
+        return false;
+    }
+
+    const int32 FirstWord = MinX >> 6;
+    const int32 LastWord = MaxX >> 6;
+
+    for (int32 Row = MinY; Row <= MaxY; Row++)
+    {
+        const int32 RowOffset = Row * WordsPerRow;
+
+        for (int32 Word = FirstWord; Word <= LastWord; Word++)
+        {
+            uint64 Mask = ~0ull;
+            if (Word == FirstWord)
+            {
+                Mask &= ~0ull << (MinX & 63);
+            }
+            if (Word == LastWord)
+            {
+                Mask &= ~0ull >> (63 - (MaxX & 63));
+            }
+
+            if ((InsideBits[RowOffset + Word] & Mask) != Mask || (OccupiedBits[RowOffset + Word] & Mask) != 0)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+int64 FLayoutLensOccupancyGrid::CountInsideCells() const
+{
+    int64 Count = 0;
+    for (const uint64 Word : InsideBits)
+    {
+        Count += FMath::CountBits(Word);
+    }
+    return Count;
+}
+
+int64 FLayoutLensOccupancyGrid::CountOccupiedCells() const
+{
+    int64 Count = 0;
+    for (int32 Index = 0; Index < InsideBits.Num(); Index++)
+    {
+        Count += FMath::CountBits(InsideBits[Index] & OccupiedBits[Index]);
+    }
+    return Count;
+}
+
+float FLayoutLensOccupancyGrid::GetCoverage() const
+{
+    const int64 InsideCount = CountInsideCells();
+    return InsideCount > 0 ? (float)CountOccupiedCells() / (float)InsideCount : 0.0f;
+}
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensRoomPlanTypes.h"
+
+/*
+ * Bit-packed occupancy raster of a room plan. Two layers share one layout (row-major, 64 cells per word,
+ * cell X at bit X & 63 of word X >> 6): Inside holds the boundary polygon, Occupied every floor footprint.
+ * A cell belongs to a polygon when its centre does (even-odd, half-open edges). Rows are filled
+ * independently with scanline spans written a word at a time, so Build runs one row per ParallelFor task.
+ * The grid reaches one cell past the boundary's bounds on every side, so the room is always ringed by
+ * outside cells.
+ */
+class FLayoutLensOccupancyGrid
+{
+public:
+    void Build(const FLayoutLensRoomPlan& Plan, float CellSizeMeters);
+    void Reset();
+
+    bool IsValid() const { return Width > 0 && Height > 0; }
+
+    int32 GetWidth() const { return Width; }
+    int32 GetHeight() const { return Height; }
+    int32 GetWordsPerRow() const { return WordsPerRow; }
+    float GetCellSizeMeters() const { return CellSizeMeters; }
+    FVector2D GetOriginMeters() const { return OriginMeters; }
+
+    bool PointToCell(const FVector2D& PointMeters, int32& OutX, int32& OutY) const;
+    FVector2D GetCellCenterMeters(int32 X, int32 Y) const;
+
+    bool IsInside(int32 X, int32 Y) const { return TestBit(InsideBits, X, Y); }
+    bool IsOccupied(int32 X, int32 Y) const { return TestBit(OccupiedBits, X, Y); }
+    bool IsFree(int32 X, int32 Y) const { return IsInside(X, Y) && !IsOccupied(X, Y); }
+
+    // True when every cell of the inclusive rectangle is inside the room and unoccupied.
+    bool IsRectFree(int32 MinX, int32 MinY, int32 MaxX, int32 MaxY) const;
+
+    int64 CountInsideCells() const;
+    int64 CountOccupiedCells() const;
+    int64 CountFreeCells() const { return CountInsideCells() - CountOccupiedCells(); }
+
+    // Occupied share of the room floor, 0..1.
+    float GetCoverage() const;
+
+    const TArray<uint64>& GetInsideBits() const { return InsideBits; }
+    const TArray<uint64>& GetOccupiedBits() const { return OccupiedBits; }
+
+    static void FillSpan(uint64* RowWords, int32 FirstCell, int32 LastCell);
+
+    // Calls SpanFunc(FirstCell, LastCell) for every run of cells on the row at RowY whose centres lie inside Points.
+    template <typename SpanFuncType>
+    static void ForEachRowSpan(
+        const TArray<FVector2D>& Points,
+        double RowY,
+        double OriginX,
+        double CellSize,
+        int32 RowWidth,
+        SpanFuncType&& SpanFunc)
+    {
+        TArray<double, TInlineAllocator<32>> Crossings;
+
+        const int32 PointCount = Points.Num();
+        for (int32 Index = 0; Index < PointCount; Index++)
+        {
+            const FVector2D& A = Points[Index];
+            const FVector2D& B = Points[(Index + 1) % PointCount];
+
+            if ((A.Y <= RowY) != (B.Y <= RowY))
+            {
+                Crossings.Add(A.X + (RowY - A.Y) * (B.X - A.X) / (B.Y - A.Y));
+            }
+        }
+
+        Crossings.Sort();
+
+        for (int32 Index = 0; Index + 1 < Crossings.Num(); Index += 2)
+        {
+            const int32 FirstCell = FMath::Max(FMath::CeilToInt((Crossings[Index] - OriginX) / CellSize - 0.5), 0);
+            const int32 LastCell = FMath::Min(FMath::CeilToInt((Crossings[Index + 1] - OriginX) / CellSize - 0.5) - 1, RowWidth - 1);
+
+            if (FirstCell <= LastCell)
+            {
+                SpanFunc(FirstCell, LastCell);
+            }
+        }
+    }
+
+    // Inclusive rows whose centres fall between MinY and MaxY.
+    void GetRowRange(double MinY, double MaxY, int32& OutFirstRow, int32& OutLastRow) const;
+
+private:
+    bool TestBit(const TArray<uint64>& Bits, int32 X, int32 Y) const
+    {
+        return X >= 0 && Y >= 0 && X < Width && Y < Height &&
+            (Bits[Y * WordsPerRow + (X >> 6)] & (1ull << (X & 63))) != 0;
+    }
+
+private:
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 WordsPerRow = 0;
+    float CellSizeMeters = 0.25f;
+    FVector2D OriginMeters = FVector2D::ZeroVector;
+
+    TArray<uint64> InsideBits;
+    TArray<uint64> OccupiedBits;
+};
@@ -0,0 +1,287 @@
+#include "LayoutLensOverlapResolver.h"
+
+#include "LayoutLensAabbTree.h"
+#include "LayoutLensPlanGeometry.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/ThreadSafeCounter.h"
+
+namespace
+{
+    const double MovedThresholdMeters = 0.001;
+
+    bool IsPointInPolygon(const TArray<FVector2D>& Polygon, const FVector2D& Point)
+    {
+        bool bInside = false;
+        for (int32 Index = 0, Previous = Polygon.Num() - 1; Index < Polygon.Num(); Previous = Index++)
+        {
+            const FVector2D& A = Polygon[Index];
+            const FVector2D& B = Polygon[Previous];
+
+            if ((A.Y > Point.Y) != (B.Y > Point.Y) &&
+                Point.X < (B.X - A.X) * (Point.Y - A.Y) / (B.Y - A.Y) + A.X)
+            {
+                bInside = !bInside;
+            }
+        }
+        return bInside;
+    }
+
+    FVector2D FindClosestBoundaryPoint(const TArray<FVector2D>& Polygon, const FVector2D& Point)
+    {
+        FVector2D BestPoint = Polygon[0];
+        double BestDistanceSquared = TNumericLimits<double>::Max();
+
+        for (int32 Index = 0; Index < Polygon.Num(); Index++)
+        {
+            const FVector2D& A = Polygon[Index];
+            const FVector2D& B = Polygon[(Index + 1) % Polygon.Num()];
+
+            const FVector2D Closest = FMath::ClosestPointOnSegment2D(Point, A, B);
+            const double DistanceSquared = FVector2D::DistSquared(Point, Closest);
+            if (DistanceSquared < BestDistanceSquared)
+            {
+                BestDistanceSquared = DistanceSquared;
+                BestPoint = Closest;
+            }
+        }
+
+        return BestPoint;
+    }
+
+    // Combines pushes so several neighbours on the same side do not add up: the largest push each way wins.
+    struct FPushAccumulator
+    {
+        FVector2D Positive = FVector2D::ZeroVector;
+        FVector2D Negative = FVector2D::ZeroVector;
+
+        void Add(const FVector2D& Push)
+        {
+            Positive.X = FMath::Max(Positive.X, Push.X);
+            Positive.Y = FMath::Max(Positive.Y, Push.Y);
+            Negative.X = FMath::Min(Negative.X, Push.X);
+            Negative.Y = FMath::Min(Negative.Y, Push.Y);
+        }
+
+        FVector2D Get() const { return Positive + Negative; }
+    };
+}
+
+bool FLayoutLensOverlapResolver::Resolve(
+    FLayoutLensRoomPlan& Plan,
+    const FLayoutLensOverlapResolveSettings& Settings,
+    FLayoutLensOverlapResolveResult& OutResult)
+{
+    OutResult = FLayoutLensOverlapResolveResult();
+
+    TArray<FVector2D> Boundary;
+    for (const FLayoutLensPoint2D& Point : Plan.Boundary)
+    {
+        Boundary.Add(FVector2D(Point.X, Point.Y));
+    }
+
+    TArray<int32> FloorElementIndices;
+    TArray<FVector2D> Centers;
+    TArray<FBox2D> LocalBounds;
+    TArray<TArray<FVector2D>> LocalFootprints;
+
+    for (int32 ElementIndex = 0; ElementIndex < Plan.Elements.Num(); ElementIndex++)
+    {
+        const FLayoutLensElement& Element = Plan.Elements[ElementIndex];
+        if (!FLayoutLensPlanGeometry::IsFloorElement(Element))
+        {
+            continue;
+        }
+
+        const FVector2D Center(Element.Transform.X, Element.Transform.Y);
+
+        TArray<FVector2D>& Footprint = LocalFootprints.AddDefaulted_GetRef();
+        FLayoutLensPlanGeometry::BuildElementFootprint(Element, Footprint);
+        for (FVector2D& Point : Footprint)
+        {
+            Point -= Center;
+        }
+
+        FloorElementIndices.Add(ElementIndex);
+        Centers.Add(Center);
+        LocalBounds.Add(FBox2D(Footprint));
+    }
+
+    const int32 FloorCount = FloorElementIndices.Num();
+    const TArray<FVector2D> StartCenters = Centers;
+
+    TArray<FBox2D> WorldBounds;
+    WorldBounds.SetNumUninitialized(FloorCount);
+
+    FLayoutLensAabbTree Tree;
+    TArray<FVector2D> Deltas;
+    Deltas.SetNumZeroed(FloorCount);
+
+    const bool bHasBoundary = Boundary.Num() >= 3;
+
+    for (int32 Iteration = 0; Iteration < Settings.MaxIterations; Iteration++)
+    {
+        for (int32 Floor = 0; Floor < FloorCount; Floor++)
+        {
+            WorldBounds[Floor] = LocalBounds[Floor].ShiftBy(Centers[Floor]);
+        }
+        Tree.Build(WorldBounds);
+
+        FThreadSafeCounter OverlapCounter;
+        FThreadSafeCounter OutsideCounter;
+
+        ParallelFor(FloorCount, [&](int32 Floor)
+        {
+            const FBox2D& Bounds = WorldBounds[Floor];
+
+            TArray<int32> Neighbours;
+            Tree.QueryOverlaps(Bounds, Neighbours);
+
+            FPushAccumulator OverlapPush;
+
+            for (const int32 Other : Neighbours)
+            {
+                if (Other == Floor)
+                {
+                    continue;
+                }
+
+                const FBox2D& OtherBounds = WorldBounds[Other];
+                const double OverlapX = FMath::Min(Bounds.Max.X, OtherBounds.Max.X) - FMath::Max(Bounds.Min.X, OtherBounds.Min.X);
+                const double OverlapY = FMath::Min(Bounds.Max.Y, OtherBounds.Max.Y) - FMath::Max(Bounds.Min.Y, OtherBounds.Min.Y);
+
+                if (OverlapX <= 0.0 || OverlapY <= 0.0 || OverlapX * OverlapY <= Settings.OverlapAreaToleranceSquareMeters)
+                {
+                    continue;
+                }
+
+                if (Other > Floor)
+                {
+                    OverlapCounter.Increment();
+                }
+
+                // Coincident centres split by index so the pair still moves apart.
+                const FVector2D Offset = Bounds.GetCenter() - OtherBounds.GetCenter();
+                const int32 Axis = OverlapX <= OverlapY ? 0 : 1;
+                const double Direction = Offset[Axis] != 0.0 ? FMath::Sign(Offset[Axis]) : (Floor < Other ? -1.0 : 1.0);
+                const double Distance = ((Axis == 0 ? OverlapX : OverlapY) + Settings.SeparationMarginMeters) * 0.5;
+
+                FVector2D Push = FVector2D::ZeroVector;
+                Push[Axis] = Direction * Distance;
+                OverlapPush.Add(Push);
+            }
+
+            FVector2D Delta = OverlapPush.Get();
+
+            if (bHasBoundary)
+            {
+                FPushAccumulator BoundaryPush;
+                bool bOutside = false;
+
+                for (const FVector2D& LocalPoint : LocalFootprints[Floor])
+                {
+                    const FVector2D Point = Centers[Floor] + Delta + LocalPoint;
+                    if (IsPointInPolygon(Boundary, Point))
+                    {
+                        continue;
+                    }
+
+                    const FVector2D Closest = FindClosestBoundaryPoint(Boundary, Point);
+                    const FVector2D Inward = Closest - Point;
+                    const double OutsideDistance = Inward.Size();
+
+                    if (OutsideDistance <= Settings.BoundaryToleranceMeters)
+                    {
+                        continue;
+                    }
+
+                    bOutside = true;
+                    BoundaryPush.Add(Inward / OutsideDistance * (OutsideDistance + Settings.BoundaryMarginMeters));
+                }
+
+                if (bOutside)
+                {
+                    OutsideCounter.Increment();
+                    Delta += BoundaryPush.Get();
+                }
+            }
+
+            Deltas[Floor] = Delta;
+        });
+
+        OutResult.Iterations = Iteration + 1;
+        OutResult.RemainingOverlapCount = OverlapCounter.GetValue();
+        OutResult.RemainingOutsideCount = OutsideCounter.GetValue();
+
+        if (OutResult.RemainingOverlapCount == 0 && OutResult.RemainingOutsideCount == 0)
+        {
+            break;
+        }
+
+        for (int32 Floor = 0; Floor < FloorCount; Floor++)
+        {
+            Centers[Floor] += Deltas[Floor];
+        }
+    }
+
+    // Each "on" element follows the floor element its centre started on.
+    TArray<FBox2D> StartBounds;
+    StartBounds.SetNumUninitialized(FloorCount);
+    for (int32 Floor = 0; Floor < FloorCount; Floor++)
+    {
+        StartBounds[Floor] = LocalBounds[Floor].ShiftBy(StartCenters[Floor]);
+    }
+    Tree.Build(StartBounds);
+
+    TArray<int32> Supports;
+    for (FLayoutLensElement& Element : Plan.Elements)
+    {
+        if (!Element.Placement.Equals(TEXT("on"), ESearchCase::IgnoreCase))
+        {
+            continue;
+        }
+
+        const FVector2D Center(Element.Transform.X, Element.Transform.Y);
+
+        Supports.Reset();
+        Tree.QueryPoint(Center, Supports);
+
+        for (const int32 Support : Supports)
+        {
+            TArray<FVector2D> SupportFootprint = LocalFootprints[Support];
+            for (FVector2D& Point : SupportFootprint)
+            {
+                Point += StartCenters[Support];
+            }
+
+            if (!IsPointInPolygon(SupportFootprint, Center))
+            {
+                continue;
+            }
+
+            const FVector2D Moved = Centers[Support] - StartCenters[Support];
+            if (Moved.Size() > MovedThresholdMeters)
+            {
+                Element.Transform.X += (float)Moved.X;
+                Element.Transform.Y += (float)Moved.Y;
+                OutResult.MovedElementIds.Add(Element.Id);
+            }
+            break;
+        }
+    }
+
+    for (int32 Floor = 0; Floor < FloorCount; Floor++)
+    {
+        if (FVector2D::Distance(Centers[Floor], StartCenters[Floor]) <= MovedThresholdMeters)
+        {
+            continue;
+        }
+
+        FLayoutLensElement& Element = Plan.Elements[FloorElementIndices[Floor]];
+        Element.Transform.X = (float)Centers[Floor].X;
+        Element.Transform.Y = (float)Centers[Floor].Y;
+        OutResult.MovedElementIds.Add(Element.Id);
+    }
+
+    return OutResult.RemainingOverlapCount == 0 && OutResult.RemainingOutsideCount == 0;
+}
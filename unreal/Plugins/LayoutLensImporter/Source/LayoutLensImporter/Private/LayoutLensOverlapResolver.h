@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensRoomPlanTypes.h"
+
+// Defaults mirror GeometryService so a resolved plan passes the same validation.
+struct FLayoutLensOverlapResolveSettings
+{
+    int32 MaxIterations = 64;
+    float SeparationMarginMeters = 0.10f;
+    float OverlapAreaToleranceSquareMeters = 0.002f;
+    float BoundaryToleranceMeters = 0.02f;
+    float BoundaryMarginMeters = 0.05f;
+};
+
+struct FLayoutLensOverlapResolveResult
+{
+    int32 Iterations = 0;
+    int32 RemainingOverlapCount = 0;
+    int32 RemainingOutsideCount = 0;
+    TArray<FString> MovedElementIds;
+};
+
+/*
+ * Separates overlapping floor elements by translation only, so yaw (0/90/180/270 in generated plans) is kept.
+ * Each iteration rebuilds an AABB tree over the footprint bounds, and every element gathers the minimum
+ * translation vector against each overlapping neighbour in parallel (Jacobi style: half the overlap plus
+ * margin each, largest push per direction), then footprint points outside the tolerant boundary are pushed
+ * back in. Footprint bounds are exact for rect footprints at right angles and conservative otherwise.
+ * "on" elements move with the floor element under their centre.
+ */
+struct FLayoutLensOverlapResolver
+{
+    // True when no overlap or out-of-bounds footprint remains.
+    static bool Resolve(
+        FLayoutLensRoomPlan& Plan,
+        const FLayoutLensOverlapResolveSettings& Settings,
+        FLayoutLensOverlapResolveResult& OutResult);
+};
@@ -1,7 +1,7 @@
 #include "LayoutLensPlaceholderActor.h"
 
 #include "Components/StaticMeshComponent.h"
-#include "Components/TextRenderComponent.h"
+#include "Engine/StaticMesh.h"
 #include "UObject/ConstructorHelpers.h"
 
 ALayoutLensPlaceholderActor::ALayoutLensPlaceholderActor()
@@ -13,16 +13,11 @@ ALayoutLensPlaceholderActor::ALayoutLensPlaceholderActor()
     BoxMesh->SetupAttachment(Root);
     BoxMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
 
-    Label = CreateDefaultSubobject<UTextRenderComponent>(TEXT("Label"));
-    Label->SetupAttachment(Root);
-    Label->SetHorizontalAlignment(EHorizTextAligment::EHTA_Center);
-    Label->SetVerticalAlignment(EVerticalTextAligment::EVRTA_TextCenter);
-    Label->SetWorldSize(24.0f);
-
     static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMeshFinder(TEXT("/Engine/BasicShapes/Cube.Cube"));
     if (CubeMeshFinder.Succeeded())
     {
-        BoxMesh->SetStaticMesh(CubeMeshFinder.Object);
+        CubeMesh = CubeMeshFinder.Object;
+        BoxMesh->SetStaticMesh(CubeMesh);
     }
 }
 
@@ -40,13 +35,22 @@ void ALayoutLensPlaceholderActor::SetBoxSizeCm(const FVector& BoxSizeCm)
         SafeSizeCm.Z / DefaultCubeSizeCm.Z
     );
 
-    BoxMesh->SetRelativeScale3D(Scale);
+    if (BoxMesh->GetStaticMesh() != CubeMesh)
+    {
+        BoxMesh->SetStaticMesh(CubeMesh);
+        BoxMesh->SetRelativeLocationAndRotation(FVector::ZeroVector, FRotator::ZeroRotator);
+    }
 
-    const float LabelZ = SafeSizeCm.Z * 0.5f + 30.0f;
-    Label->SetRelativeLocation(FVector(0.0f, 0.0f, LabelZ));
+    BoxMesh->SetRelativeScale3D(Scale);
 }
 
-void ALayoutLensPlaceholderActor::SetLabelText(const FString& Text)
+void ALayoutLensPlaceholderActor::SetDisplayMesh(UStaticMesh* Mesh, const FTransform& RelativeTransform)
 {
-    Label->SetText(FText::FromString(Text));
+    if (Mesh == nullptr)
+    {
+        return;
+    }
+
+    BoxMesh->SetStaticMesh(Mesh);
+    BoxMesh->SetRelativeTransform(RelativeTransform);
 }
\ No newline at end of file
@@ -0,0 +1,251 @@
+#include "LayoutLensPlacementIndex.h"
+
+namespace
+{
+    // Wall items without an explicit elevation are centred at eye height, clamped between floor and ceiling.
+    const float WallMountCenterMeters = 1.5f;
+
+    // Below this many pending changes the short list is cheaper than a rebuild, whatever the tree size.
+    const int32 MinPendingSupportChanges = 64;
+
+    bool IsPointInPolygon(const TArray<FVector2D>& Polygon, const FVector2D& Point)
+    {
+        bool bInside = false;
+        for (int32 Index = 0, Previous = Polygon.Num() - 1; Index < Polygon.Num(); Previous = Index++)
+        {
+            const FVector2D& A = Polygon[Index];
+            const FVector2D& B = Polygon[Previous];
+
+            if ((A.Y > Point.Y) != (B.Y > Point.Y) &&
+                Point.X < (B.X - A.X) * (Point.Y - A.Y) / (B.Y - A.Y) + A.X)
+            {
+                bInside = !bInside;
+            }
+        }
+        return bInside;
+    }
+}
+
+void FLayoutLensPlacementIndex::Reset()
+{
+    Supports.Empty();
+    SupportIndexById.Empty();
+    SupportTree.Reset();
+    TreeSupportCount = 0;
+    RemovedSupportCount = 0;
+    Walls.Empty();
+    WallTree.Reset();
+}
+
+int32 FLayoutLensPlacementIndex::AddSupport(const FLayoutLensElement& Element)
+{
+    const int32 SupportIndex = Supports.Num();
+
+    FSupport& Support = Supports.AddDefaulted_GetRef();
+    Support.ElementId = Element.Id;
+    FLayoutLensPlanGeometry::BuildElementFootprint(Element, Support.Footprint);
+    Support.Bounds = FBox2D(Support.Footprint);
+    Support.TopMeters = Element.HeightMeters;
+
+    SupportIndexById.Add(Element.Id, SupportIndex);
+    return SupportIndex;
+}
+
+void FLayoutLensPlacementIndex::SetElement(const FLayoutLensElement& Element, TArray<FBox2D>& OutChangedBounds)
+{
+    RemoveElement(Element.Id, OutChangedBounds);
+
+    if (FLayoutLensPlanGeometry::IsFloorElement(Element))
+    {
+        OutChangedBounds.Add(Supports[AddSupport(Element)].Bounds);
+    }
+}
+
+void FLayoutLensPlacementIndex::RemoveElement(const FString& ElementId, TArray<FBox2D>& OutChangedBounds)
+{
+    int32 SupportIndex = INDEX_NONE;
+    if (!SupportIndexById.RemoveAndCopyValue(ElementId, SupportIndex))
+    {
+        return;
+    }
+
+    FSupport& Support = Supports[SupportIndex];
+    OutChangedBounds.Add(Support.Bounds);
+    Support.bRemoved = true;
+    RemovedSupportCount++;
+}
+
+bool FLayoutLensPlacementIndex::CompactSupports(bool bForce)
+{
+    const int32 PendingCount = Supports.Num() - TreeSupportCount + RemovedSupportCount;
+    if (PendingCount == 0 || (!bForce && PendingCount <= FMath::Max(MinPendingSupportChanges, TreeSupportCount / 4)))
+    {
+        return false;
+    }
+
+    Supports.RemoveAll([](const FSupport& Support) { return Support.bRemoved; });
+
+    SupportIndexById.Reset();
+    TArray<FBox2D> SupportBounds;
+    SupportBounds.Reserve(Supports.Num());
+
+    for (int32 SupportIndex = 0; SupportIndex < Supports.Num(); SupportIndex++)
+    {
+        SupportIndexById.Add(Supports[SupportIndex].ElementId, SupportIndex);
+        SupportBounds.Add(Supports[SupportIndex].Bounds);
+    }
+
+    SupportTree.Build(SupportBounds);
+    TreeSupportCount = Supports.Num();
+    RemovedSupportCount = 0;
+    return true;
+}
+
+void FLayoutLensPlacementIndex::Build(const FLayoutLensRoomPlan& Plan, float InWallThicknessCm)
+{
+    Reset();
+
+    WallThicknessCm = InWallThicknessCm;
+    RoomHeightMeters = Plan.RoomHeightMeters;
+
+    for (const FLayoutLensElement& Element : Plan.Elements)
+    {
+        if (FLayoutLensPlanGeometry::IsFloorElement(Element))
+        {
+            AddSupport(Element);
+        }
+    }
+
+    CompactSupports(true);
+
+    const int32 PointCount = Plan.Boundary.Num();
+    if (PointCount < 3)
+    {
+        return;
+    }
+
+    // Shoelace sign: counter-clockwise boundaries have the room on the left of every edge.
+    double TwiceArea = 0.0;
+    for (int32 Index = 0; Index < PointCount; Index++)
+    {
+        const FLayoutLensPoint2D& A = Plan.Boundary[Index];
+        const FLayoutLensPoint2D& B = Plan.Boundary[(Index + 1) % PointCount];
+        TwiceArea += (double)A.X * B.Y - (double)B.X * A.Y;
+    }
+    const double InwardSign = TwiceArea >= 0.0 ? 1.0 : -1.0;
+
+    TArray<FBox2D> WallBounds;
+
+    for (int32 Index = 0; Index < PointCount; Index++)
+    {
+        FWallSegment Wall;
+        Wall.A = FVector2D(Plan.Boundary[Index].X, Plan.Boundary[Index].Y);
+        Wall.B = FVector2D(Plan.Boundary[(Index + 1) % PointCount].X, Plan.Boundary[(Index + 1) % PointCount].Y);
+
+        const FVector2D Direction = (Wall.B - Wall.A).GetSafeNormal();
+        Wall.InwardNormal = FVector2D(-Direction.Y, Direction.X) * InwardSign;
+
+        Walls.Add(Wall);
+
+        FBox2D Bounds(ForceInit);
+        Bounds += Wall.A;
+        Bounds += Wall.B;
+        WallBounds.Add(Bounds);
+    }
+
+    WallTree.Build(WallBounds);
+}
+
+int32 FLayoutLensPlacementIndex::FindSupport(const FVector2D& PointMeters) const
+{
+    TArray<int32> Candidates;
+    SupportTree.QueryPoint(PointMeters, Candidates);
+
+    int32 BestSupport = INDEX_NONE;
+    for (const int32 Candidate : Candidates)
+    {
+        if (IsBetterSupport(Candidate, BestSupport, PointMeters))
+        {
+            BestSupport = Candidate;
+        }
+    }
+
+    for (int32 Candidate = TreeSupportCount; Candidate < Supports.Num(); Candidate++)
+    {
+        if (Supports[Candidate].Bounds.IsInsideOrOn(PointMeters) && IsBetterSupport(Candidate, BestSupport, PointMeters))
+        {
+            BestSupport = Candidate;
+        }
+    }
+
+    return BestSupport;
+}
+
+bool FLayoutLensPlacementIndex::IsBetterSupport(int32 Candidate, int32 BestSupport, const FVector2D& PointMeters) const
+{
+    const FSupport& Support = Supports[Candidate];
+    return !Support.bRemoved &&
+        (BestSupport == INDEX_NONE || Support.TopMeters > Supports[BestSupport].TopMeters) &&
+        IsPointInPolygon(Support.Footprint, PointMeters);
+}
+
+int32 FLayoutLensPlacementIndex::FindNearestWall(const FVector2D& PointMeters, FVector2D& OutClosestMeters) const
+{
+    double DistanceSquared = 0.0;
+    const int32 WallIndex = WallTree.FindNearest(
+        PointMeters,
+        [this, &PointMeters](int32 Item)
+        {
+            return FVector2D::DistSquared(PointMeters, FMath::ClosestPointOnSegment2D(PointMeters, Walls[Item].A, Walls[Item].B));
+        },
+        DistanceSquared);
+
+    if (WallIndex != INDEX_NONE)
+    {
+        OutClosestMeters = FMath::ClosestPointOnSegment2D(PointMeters, Walls[WallIndex].A, Walls[WallIndex].B);
+    }
+
+    return WallIndex;
+}
+
+FLayoutLensBox FLayoutLensPlacementIndex::MakeElementBox(const FLayoutLensElement& Element) const
+{
+    FLayoutLensBox Box = FLayoutLensPlanGeometry::MakeElementBox(Element);
+
+    const FVector2D CenterMeters(Element.Transform.X, Element.Transform.Y);
+
+    if (FLayoutLensPlanGeometry::IsOnElement(Element))
+    {
+        const int32 Support = FindSupport(CenterMeters);
+        if (Support != INDEX_NONE)
+        {
+            Box.CenterCm.Z += Supports[Support].TopMeters * 100.0f;
+        }
+    }
+    else if (FLayoutLensPlanGeometry::IsWallElement(Element))
+    {
+        FVector2D ClosestMeters;
+        const int32 WallIndex = FindNearestWall(CenterMeters, ClosestMeters);
+        if (WallIndex != INDEX_NONE)
+        {
+            const FWallSegment& Wall = Walls[WallIndex];
+
+            // Width runs along the wall and depth into the room, so the back face sits on the wall's inner face.
+            const FVector2D SnappedMeters = ClosestMeters + Wall.InwardNormal * (WallThicknessCm * 0.005f + Element.DepthMeters * 0.5f);
+
+            const float HalfHeightMeters = Element.HeightMeters * 0.5f;
+            const float MountCenterMeters = FMath::Clamp(
+                WallMountCenterMeters,
+                HalfHeightMeters,
+                FMath::Max(RoomHeightMeters - HalfHeightMeters, HalfHeightMeters));
+
+            Box.CenterCm = FVector(SnappedMeters.X * 100.0f, SnappedMeters.Y * 100.0f, MountCenterMeters * 100.0f);
+
+            // Yaw from the normal, not the edge direction, so the box's +Y points into the room whichever way the
+            // boundary winds.
+            Box.Rotation = FRotator(0.0f, FMath::RadiansToDegrees(FMath::Atan2(-Wall.InwardNormal.X, Wall.InwardNormal.Y)), 0.0f);
+        }
+    }
+
+    return Box;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensAabbTree.h"
+#include "LayoutLensPlanGeometry.h"
+
+/*
+ * Places elements that are not on the floor. Floor footprints and boundary segments each sit in an AABB
+ * tree, so the support under an "on" element and the wall nearest a "wall" element are found in
+ * logarithmic time. Build once per space change; element changes go through SetElement and RemoveElement,
+ * which keep new footprints in a short list beside the tree and only rebuild it once that list (or the
+ * number of dropped footprints) outgrows a quarter of the tree.
+ */
+class FLayoutLensPlacementIndex
+{
+public:
+    void Build(const FLayoutLensRoomPlan& Plan, float InWallThicknessCm);
+    void Reset();
+
+    // Wall segments do not depend on it, so only "wall" elements need placing again afterwards.
+    void SetWallThickness(float InWallThicknessCm) { WallThicknessCm = InWallThicknessCm; }
+
+    // Both append the footprint bounds whose support changed: the old one, the new one, or both.
+    void SetElement(const FLayoutLensElement& Element, TArray<FBox2D>& OutChangedBounds);
+    void RemoveElement(const FString& ElementId, TArray<FBox2D>& OutChangedBounds);
+
+    // Rebuilds the support tree when enough changes have piled up, or whenever any have with bForce.
+    bool CompactSupports(bool bForce = false);
+
+    // Floor elements as FLayoutLensPlanGeometry::MakeElementBox; "on" elements stacked on their support;
+    // "wall" elements turned to face the room and pushed flat against the nearest wall.
+    FLayoutLensBox MakeElementBox(const FLayoutLensElement& Element) const;
+
+    // Floor element whose footprint contains the point (the tallest when several do), or INDEX_NONE.
+    int32 FindSupport(const FVector2D& PointMeters) const;
+
+    // Index of the nearest boundary segment, or INDEX_NONE without a boundary.
+    int32 FindNearestWall(const FVector2D& PointMeters, FVector2D& OutClosestMeters) const;
+
+private:
+    struct FSupport
+    {
+        FString ElementId;
+        TArray<FVector2D> Footprint;
+        FBox2D Bounds = FBox2D(ForceInit);
+        float TopMeters = 0.0f;
+        bool bRemoved = false;
+    };
+
+    struct FWallSegment
+    {
+        FVector2D A = FVector2D::ZeroVector;
+        FVector2D B = FVector2D::ZeroVector;
+        FVector2D InwardNormal = FVector2D::ZeroVector;
+    };
+
+    int32 AddSupport(const FLayoutLensElement& Element);
+    bool IsBetterSupport(int32 Candidate, int32 BestSupport, const FVector2D& PointMeters) const;
+
+    // Supports below TreeSupportCount are in SupportTree; the rest were added since and are tested one by one.
+    TArray<FSupport> Supports;
+    TMap<FString, int32> SupportIndexById;
+    FLayoutLensAabbTree SupportTree;
+    int32 TreeSupportCount = 0;
+    int32 RemovedSupportCount = 0;
+
+    TArray<FWallSegment> Walls;
+    FLayoutLensAabbTree WallTree;
+
+    float WallThicknessCm = 10.0f;
+    float RoomHeightMeters = 2.7f;
+};
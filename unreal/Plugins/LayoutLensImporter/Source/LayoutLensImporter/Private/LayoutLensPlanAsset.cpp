@@ -0,0 +1,187 @@
+#include "LayoutLensPlanAsset.h"
+
+#include "LayoutLensRoomPlanJson.h"
+#include "LayoutLensSlabMesh.h"
+
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_EDITOR
+#include "DerivedDataCacheInterface.h"
+#endif
+
+namespace
+{
+    // Bump when the package layout below changes.
+    const int32 PlanAssetFormatVersion = 3;
+
+    // Version 1 packages carried box transforms after the plan; they are read and dropped.
+    const int32 BoxTransformsFormatVersion = 1;
+
+    // Version 2 packages end after the plan.
+    const int32 PlanOnlyFormatVersion = 2;
+
+    // Bump when BuildDerivedData output changes so stale DDC entries are ignored.
+    const TCHAR* PlanDerivedDataVersion = TEXT("8C41E2B7F05D4A93A6E1D92B3C7F5E08");
+
+    void SerializeDerivedData(FArchive& Ar, FLayoutLensPlanDerivedData& DerivedData)
+    {
+        Ar << DerivedData.BoundaryTriangles;
+    }
+}
+
+bool ULayoutLensPlanAsset::InitializeFromJson(const FString& JsonText, FString& OutError)
+{
+    const TSharedRef<FLayoutLensRoomPlan> NewPlan = MakeShared<FLayoutLensRoomPlan>();
+    if (!FLayoutLensRoomPlanJson::ParseRoomPlan(JsonText, *NewPlan, OutError))
+    {
+        return false;
+    }
+
+    Plan = NewPlan;
+    SourceHash = FLayoutLensRoomPlanJson::HashDocument(JsonText);
+    ElementCount = Plan->Elements.Num();
+
+    DerivedData = FLayoutLensPlanDerivedData();
+    CacheDerivedData();
+    return true;
+}
+
+const TArray<int32>* ULayoutLensPlanAsset::FindBoundaryTriangles(const TArray<FLayoutLensPoint2D>& Boundary)
+{
+    const TArray<FLayoutLensPoint2D>& AssetBoundary = Plan->Boundary;
+
+    if (&Boundary != &AssetBoundary && (Boundary.Num() != AssetBoundary.Num() ||
+        FMemory::Memcmp(Boundary.GetData(), AssetBoundary.GetData(), Boundary.Num() * sizeof(FLayoutLensPoint2D)) != 0))
+    {
+        return nullptr;
+    }
+
+    if (!DerivedData.bBuilt)
+    {
+        CacheDerivedData();
+    }
+
+    return &DerivedData.BoundaryTriangles;
+}
+
+void ULayoutLensPlanAsset::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+
+    if (Ar.IsObjectReferenceCollector())
+    {
+        return;
+    }
+
+    int32 FormatVersion = PlanAssetFormatVersion;
+    Ar << FormatVersion;
+
+    if (Ar.IsLoading() && FormatVersion != PlanAssetFormatVersion && FormatVersion != PlanOnlyFormatVersion &&
+        FormatVersion != BoxTransformsFormatVersion)
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: %s has plan format %d, expected %d. Reimport it."),
+            *GetPathName(), FormatVersion, PlanAssetFormatVersion);
+        Ar.SetError();
+        return;
+    }
+
+    Ar << SourceHash;
+
+    if (Ar.IsLoading())
+    {
+        const TSharedRef<FLayoutLensRoomPlan> LoadedPlan = MakeShared<FLayoutLensRoomPlan>();
+        Ar << *LoadedPlan;
+        Plan = LoadedPlan;
+        DerivedData = FLayoutLensPlanDerivedData();
+    }
+    else
+    {
+        Ar << const_cast<FLayoutLensRoomPlan&>(*Plan);
+    }
+
+    if (FormatVersion == BoxTransformsFormatVersion)
+    {
+        bool bHasDerivedData = false;
+        Ar << bHasDerivedData;
+
+        if (bHasDerivedData)
+        {
+            TArray<FTransform> UnusedTransforms;
+            Ar << UnusedTransforms;
+            Ar << UnusedTransforms;
+        }
+    }
+    else if (FormatVersion == PlanAssetFormatVersion)
+    {
+        // Editor packages fetch derived data from the DDC on first use; cooked packages carry it so runtime never triangulates.
+        bool bHasDerivedData = Ar.IsSaving() && Ar.IsCooking();
+        Ar << bHasDerivedData;
+
+        if (bHasDerivedData)
+        {
+            if (Ar.IsSaving() && !DerivedData.bBuilt)
+            {
+                CacheDerivedData();
+            }
+
+            SerializeDerivedData(Ar, DerivedData);
+            DerivedData.bBuilt = true;
+        }
+    }
+}
+
+void ULayoutLensPlanAsset::PostLoad()
+{
+    Super::PostLoad();
+
+    ElementCount = Plan->Elements.Num();
+}
+
+#if WITH_EDITOR
+FString ULayoutLensPlanAsset::GetDerivedDataKey() const
+{
+    // The triangulation reads nothing but the boundary, so no visualizer setting enters the key.
+    return FDerivedDataCacheInterface::BuildCacheKey(
+        TEXT("LAYOUTLENSPLAN"), PlanDerivedDataVersion, *FLayoutLensRoomPlanJson::VersionToString(SourceHash));
+}
+#endif
+
+void ULayoutLensPlanAsset::CacheDerivedData()
+{
+#if WITH_EDITOR
+    const FString DerivedDataKey = GetDerivedDataKey();
+
+    TArray<uint8> CachedBytes;
+    if (GetDerivedDataCacheRef().GetSynchronous(*DerivedDataKey, CachedBytes, GetPathName()))
+    {
+        FLayoutLensPlanDerivedData CachedData;
+        FMemoryReader Reader(CachedBytes);
+        SerializeDerivedData(Reader, CachedData);
+
+        if (!Reader.IsError())
+        {
+            DerivedData = MoveTemp(CachedData);
+            DerivedData.bBuilt = true;
+            return;
+        }
+    }
+
+    BuildDerivedData(DerivedData);
+
+    TArray<uint8> NewBytes;
+    FMemoryWriter Writer(NewBytes);
+    SerializeDerivedData(Writer, DerivedData);
+
+    GetDerivedDataCacheRef().Put(*DerivedDataKey, NewBytes, GetPathName());
+#else
+    BuildDerivedData(DerivedData);
+#endif
+}
+
+void ULayoutLensPlanAsset::BuildDerivedData(FLayoutLensPlanDerivedData& OutDerivedData) const
+{
+    OutDerivedData.BoundaryTriangles.Reset();
+    FLayoutLensSlabMesh::TriangulateBoundary(*Plan, OutDerivedData.BoundaryTriangles);
+    OutDerivedData.bBuilt = true;
+}
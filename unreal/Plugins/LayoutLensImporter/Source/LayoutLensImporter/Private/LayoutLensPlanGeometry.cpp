@@ -0,0 +1,240 @@
+#include "LayoutLensPlanGeometry.h"
+
+#include "Hash/xxhash.h"
+
+FTransform FLayoutLensBox::ToCubeTransform() const
+{
+    const FVector SafeSizeCm = FVector(
+        FMath::Max(SizeCm.X, 1.0f),
+        FMath::Max(SizeCm.Y, 1.0f),
+        FMath::Max(SizeCm.Z, 1.0f));
+
+    return FTransform(Rotation, CenterCm, SafeSizeCm / 100.0f);
+}
+
+bool FLayoutLensPlanGeometry::IsFloorElement(const FLayoutLensElement& Element)
+{
+    return Element.Placement.Equals(TEXT("floor"), ESearchCase::IgnoreCase);
+}
+
+bool FLayoutLensPlanGeometry::IsOnElement(const FLayoutLensElement& Element)
+{
+    return Element.Placement.Equals(TEXT("on"), ESearchCase::IgnoreCase);
+}
+
+bool FLayoutLensPlanGeometry::IsWallElement(const FLayoutLensElement& Element)
+{
+    return Element.Placement.Equals(TEXT("wall"), ESearchCase::IgnoreCase);
+}
+
+bool FLayoutLensPlanGeometry::IsPlacedElement(const FLayoutLensElement& Element)
+{
+    return IsFloorElement(Element) || IsOnElement(Element) || IsWallElement(Element);
+}
+
+FLayoutLensBox FLayoutLensPlanGeometry::MakeElementBox(const FLayoutLensElement& Element)
+{
+    const float WidthCm = Element.WidthMeters * 100.0f;
+    const float DepthCm = Element.DepthMeters * 100.0f;
+    const float HeightCm = Element.HeightMeters * 100.0f;
+
+    FLayoutLensBox Box;
+    Box.CenterCm = FVector(Element.Transform.X * 100.0f, Element.Transform.Y * 100.0f, HeightCm * 0.5f);
+    Box.Rotation = FRotator(0.0f, Element.Transform.YawDeg, 0.0f);
+    Box.SizeCm = FVector(WidthCm, DepthCm, HeightCm);
+    return Box;
+}
+
+void FLayoutLensPlanGeometry::BuildElementFootprint(const FLayoutLensElement& Element, TArray<FVector2D>& OutPointsMeters)
+{
+    OutPointsMeters.Reset();
+
+    const bool bIsPolygon = Element.FootprintKind.Equals(TEXT("poly"), ESearchCase::IgnoreCase) && Element.PolygonPoints.Num() >= 3;
+
+    if (bIsPolygon)
+    {
+        OutPointsMeters.Reserve(Element.PolygonPoints.Num());
+        for (const FLayoutLensPoint2D& Point : Element.PolygonPoints)
+        {
+            OutPointsMeters.Add(FVector2D(Point.X, Point.Y));
+        }
+    }
+    else
+    {
+        const float HalfWidth = Element.WidthMeters * 0.5f;
+        const float HalfDepth = Element.DepthMeters * 0.5f;
+
+        OutPointsMeters.Add(FVector2D(-HalfWidth, -HalfDepth));
+        OutPointsMeters.Add(FVector2D(HalfWidth, -HalfDepth));
+        OutPointsMeters.Add(FVector2D(HalfWidth, HalfDepth));
+        OutPointsMeters.Add(FVector2D(-HalfWidth, HalfDepth));
+    }
+
+    float YawSin = 0.0f;
+    float YawCos = 1.0f;
+    FMath::SinCos(&YawSin, &YawCos, FMath::DegreesToRadians(Element.Transform.YawDeg));
+
+    const FVector2D Translation(Element.Transform.X, Element.Transform.Y);
+
+    for (FVector2D& Point : OutPointsMeters)
+    {
+        Point = FVector2D(Point.X * YawCos - Point.Y * YawSin, Point.X * YawSin + Point.Y * YawCos) + Translation;
+    }
+}
+
+void FLayoutLensPlanGeometry::BuildWallBoxes(const FLayoutLensRoomPlan& Plan, float WallThicknessCm, TArray<FLayoutLensBox>& OutBoxes)
+{
+    const int32 PointCount = Plan.Boundary.Num();
+    if (PointCount < 2)
+    {
+        return;
+    }
+
+    const float WallHeightCm = Plan.RoomHeightMeters * 100.0f;
+    const float WallZ = WallHeightCm * 0.5f;
+
+    OutBoxes.Reserve(OutBoxes.Num() + PointCount);
+
+    for (int32 Index = 0; Index < PointCount; Index++)
+    {
+        const int32 NextIndex = (Index + 1) % PointCount;
+
+        const FVector PointA = FVector(Plan.Boundary[Index].X * 100.0f, Plan.Boundary[Index].Y * 100.0f, WallZ);
+        const FVector PointB = FVector(Plan.Boundary[NextIndex].X * 100.0f, Plan.Boundary[NextIndex].Y * 100.0f, WallZ);
+
+        const FVector Delta = PointB - PointA;
+        const float LengthCm = Delta.Size();
+        if (LengthCm < 1.0f)
+        {
+            continue;
+        }
+
+        FLayoutLensBox Box;
+        Box.CenterCm = (PointA + PointB) * 0.5f;
+        Box.Rotation = FRotator(0.0f, FMath::RadiansToDegrees(FMath::Atan2(Delta.Y, Delta.X)), 0.0f);
+        Box.SizeCm = FVector(LengthCm, WallThicknessCm, WallHeightCm);
+        OutBoxes.Add(Box);
+    }
+}
+
+void FLayoutLensPlanGeometry::BuildWallBoxesWithDoorGaps(const FLayoutLensRoomPlan& Plan, float WallThicknessCm, TArray<FLayoutLensBox>& OutBoxes)
+{
+    const int32 PointCount = Plan.Boundary.Num();
+    if (PointCount < 2)
+    {
+        return;
+    }
+
+    const float WallHeightCm = Plan.RoomHeightMeters * 100.0f;
+    const float WallZ = WallHeightCm * 0.5f;
+
+    // Door spans along each edge in centimetres from its first point, clamped like SpawnOpenings places them.
+    TArray<TArray<FVector2D>> GapsByEdge;
+    GapsByEdge.SetNum(PointCount);
+
+    for (const FLayoutLensOpening& Opening : Plan.Openings)
+    {
+        if (!Opening.Kind.Equals(TEXT("door"), ESearchCase::IgnoreCase))
+        {
+            continue;
+        }
+
+        const int32 EdgeIndex = FMath::Clamp(Opening.EdgeIndex, 0, PointCount - 1);
+        const int32 NextIndex = (EdgeIndex + 1) % PointCount;
+
+        const float EdgeLengthCm = FVector2D::Distance(
+            FVector2D(Plan.Boundary[EdgeIndex].X, Plan.Boundary[EdgeIndex].Y),
+            FVector2D(Plan.Boundary[NextIndex].X, Plan.Boundary[NextIndex].Y)) * 100.0f;
+
+        const float CenterDistanceCm = FMath::Clamp(Opening.Center01, 0.0f, 1.0f) * EdgeLengthCm;
+        const float HalfWidthCm = Opening.WidthMeters * 50.0f;
+
+        GapsByEdge[EdgeIndex].Add(FVector2D(CenterDistanceCm - HalfWidthCm, CenterDistanceCm + HalfWidthCm));
+    }
+
+    OutBoxes.Reserve(OutBoxes.Num() + PointCount + Plan.Openings.Num());
+
+    for (int32 Index = 0; Index < PointCount; Index++)
+    {
+        const int32 NextIndex = (Index + 1) % PointCount;
+
+        const FVector PointA = FVector(Plan.Boundary[Index].X * 100.0f, Plan.Boundary[Index].Y * 100.0f, WallZ);
+        const FVector PointB = FVector(Plan.Boundary[NextIndex].X * 100.0f, Plan.Boundary[NextIndex].Y * 100.0f, WallZ);
+
+        const FVector Delta = PointB - PointA;
+        const float LengthCm = Delta.Size();
+        if (LengthCm < 1.0f)
+        {
+            continue;
+        }
+
+        const FVector DirectionUnit = Delta / LengthCm;
+        const FRotator Rotation(0.0f, FMath::RadiansToDegrees(FMath::Atan2(Delta.Y, Delta.X)), 0.0f);
+
+        TArray<FVector2D>& Gaps = GapsByEdge[Index];
+        Gaps.Sort([](const FVector2D& A, const FVector2D& B) { return A.X < B.X; });
+
+        // Walk the edge and emit the solid stretches between gaps; overlapping doors simply merge.
+        float SolidStartCm = 0.0f;
+
+        auto AddPiece = [&](float StartCm, float EndCm)
+        {
+            StartCm = FMath::Max(StartCm, 0.0f);
+            EndCm = FMath::Min(EndCm, LengthCm);
+            if (EndCm - StartCm < 1.0f)
+            {
+                return;
+            }
+
+            FLayoutLensBox Box;
+            Box.CenterCm = PointA + DirectionUnit * ((StartCm + EndCm) * 0.5f);
+            Box.Rotation = Rotation;
+            Box.SizeCm = FVector(EndCm - StartCm, WallThicknessCm, WallHeightCm);
+            OutBoxes.Add(Box);
+        };
+
+        for (const FVector2D& Gap : Gaps)
+        {
+            AddPiece(SolidStartCm, Gap.X);
+            SolidStartCm = FMath::Max(SolidStartCm, Gap.Y);
+        }
+
+        AddPiece(SolidStartCm, LengthCm);
+    }
+}
+
+uint64 FLayoutLensPlanGeometry::HashBoxes(const TArray<FLayoutLensBox>& Boxes)
+{
+    TArray<float> Values;
+    Values.Reserve(Boxes.Num() * 7);
+
+    for (const FLayoutLensBox& Box : Boxes)
+    {
+        Values.Add(Box.CenterCm.X);
+        Values.Add(Box.CenterCm.Y);
+        Values.Add(Box.CenterCm.Z);
+        Values.Add(Box.Rotation.Yaw);
+        Values.Add(Box.SizeCm.X);
+        Values.Add(Box.SizeCm.Y);
+        Values.Add(Box.SizeCm.Z);
+    }
+
+    return FXxHash64::HashBuffer(Values.GetData(), Values.Num() * sizeof(float)).Hash;
+}
+
+FBox2D FLayoutLensPlanGeometry::ComputeBoundsCm(const FLayoutLensRoomPlan& Plan)
+{
+    FBox2D Bounds(ForceInit);
+
+    for (const FLayoutLensPoint2D& Point : Plan.Boundary)
+    {
+        Bounds += FVector2D(Point.X * 100.0f, Point.Y * 100.0f);
+    }
+
+    for (const FLayoutLensElement& Element : Plan.Elements)
+    {
+        Bounds += FVector2D(Element.Transform.X * 100.0f, Element.Transform.Y * 100.0f);
+    }
+
+    return Bounds;
+}
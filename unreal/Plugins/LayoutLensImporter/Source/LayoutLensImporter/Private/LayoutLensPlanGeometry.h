@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensRoomPlanTypes.h"
+
+// Oriented box in centimetres, matching the 100 cm /Engine/BasicShapes/Cube the placeholders scale.
+struct FLayoutLensBox
+{
+    FVector CenterCm = FVector::ZeroVector;
+    FRotator Rotation = FRotator::ZeroRotator;
+    FVector SizeCm = FVector(100.0f);
+
+    FTransform ToCubeTransform() const;
+};
+
+struct FLayoutLensPlanGeometry
+{
+    static bool IsFloorElement(const FLayoutLensElement& Element);
+    static bool IsOnElement(const FLayoutLensElement& Element);
+    static bool IsWallElement(const FLayoutLensElement& Element);
+
+    // Any of the three placements the pipeline produces.
+    static bool IsPlacedElement(const FLayoutLensElement& Element);
+
+    static FLayoutLensBox MakeElementBox(const FLayoutLensElement& Element);
+
+    // Footprint outline in plan metres, rotated by yaw and translated like the Python GeometryService does.
+    static void BuildElementFootprint(const FLayoutLensElement& Element, TArray<FVector2D>& OutPointsMeters);
+    static void BuildWallBoxes(const FLayoutLensRoomPlan& Plan, float WallThicknessCm, TArray<FLayoutLensBox>& OutBoxes);
+
+    // Wall boxes split around door openings so the doorways stay passable; windows leave the wall whole.
+    static void BuildWallBoxesWithDoorGaps(const FLayoutLensRoomPlan& Plan, float WallThicknessCm, TArray<FLayoutLensBox>& OutBoxes);
+
+    // Order-sensitive hash of centres, yaws and sizes, for skipping rebuilds when nothing moved.
+    static uint64 HashBoxes(const TArray<FLayoutLensBox>& Boxes);
+
+    // XY bounds of the boundary and every element centre, in centimetres.
+    static FBox2D ComputeBoundsCm(const FLayoutLensRoomPlan& Plan);
+};
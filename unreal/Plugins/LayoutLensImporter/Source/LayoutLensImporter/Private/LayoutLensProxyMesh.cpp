@@ -0,0 +1,123 @@
+#include "LayoutLensProxyMesh.h"
+
+#include "Engine/StaticMesh.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+
+void FLayoutLensProxyMesh::BuildBoxMeshDescription(const TArray<FLayoutLensBox>& Boxes, FMeshDescription& MeshDescription)
+{
+    FStaticMeshAttributes Attributes(MeshDescription);
+    Attributes.Register();
+
+    TVertexAttributesRef<FVector3f> Positions = Attributes.GetVertexPositions();
+    TVertexInstanceAttributesRef<FVector3f> Normals = Attributes.GetVertexInstanceNormals();
+    TVertexInstanceAttributesRef<FVector2f> UVs = Attributes.GetVertexInstanceUVs();
+
+    MeshDescription.ReserveNewVertices(Boxes.Num() * 24);
+    MeshDescription.ReserveNewVertexInstances(Boxes.Num() * 24);
+    MeshDescription.ReserveNewTriangles(Boxes.Num() * 12);
+
+    const FPolygonGroupID PolygonGroup = MeshDescription.CreatePolygonGroup();
+
+    const FVector FaceNormals[6] =
+    {
+        FVector(1.0f, 0.0f, 0.0f), FVector(-1.0f, 0.0f, 0.0f),
+        FVector(0.0f, 1.0f, 0.0f), FVector(0.0f, -1.0f, 0.0f),
+        FVector(0.0f, 0.0f, 1.0f), FVector(0.0f, 0.0f, -1.0f)
+    };
+
+    const FVector2D CornerSigns[4] = { FVector2D(-1.0f, -1.0f), FVector2D(1.0f, -1.0f), FVector2D(1.0f, 1.0f), FVector2D(-1.0f, 1.0f) };
+
+    for (const FLayoutLensBox& Box : Boxes)
+    {
+        const FVector SafeSizeCm = Box.SizeCm.ComponentMax(FVector(1.0f));
+        const FTransform BoxTransform(Box.Rotation, Box.CenterCm, SafeSizeCm);
+
+        for (const FVector& FaceNormal : FaceNormals)
+        {
+            const FVector AxisU = FMath::Abs(FaceNormal.Z) > 0.5f ? FVector(1.0f, 0.0f, 0.0f) : FVector(0.0f, 0.0f, 1.0f);
+            const FVector AxisV = FaceNormal ^ AxisU;
+
+            FVector CornerPositions[4];
+            for (int32 Corner = 0; Corner < 4; Corner++)
+            {
+                const FVector LocalCorner = (FaceNormal + AxisU * CornerSigns[Corner].X + AxisV * CornerSigns[Corner].Y) * 0.5f;
+                CornerPositions[Corner] = BoxTransform.TransformPosition(LocalCorner);
+            }
+
+            const FVector WorldNormal = BoxTransform.TransformVectorNoScale(FaceNormal);
+
+            FVertexInstanceID CornerInstances[4];
+            for (int32 Corner = 0; Corner < 4; Corner++)
+            {
+                const FVertexID Vertex = MeshDescription.CreateVertex();
+                Positions[Vertex] = (FVector3f)CornerPositions[Corner];
+
+                CornerInstances[Corner] = MeshDescription.CreateVertexInstance(Vertex);
+                Normals[CornerInstances[Corner]] = (FVector3f)WorldNormal;
+                UVs[CornerInstances[Corner]] = FVector2f((CornerSigns[Corner].X + 1.0f) * 0.5f, (CornerSigns[Corner].Y + 1.0f) * 0.5f);
+            }
+
+            // Front faces satisfy (P2 - P0) ^ (P1 - P0) pointing along the face normal.
+            const FVector WindingNormal = (CornerPositions[2] - CornerPositions[0]) ^ (CornerPositions[1] - CornerPositions[0]);
+            if ((WindingNormal | WorldNormal) >= 0.0f)
+            {
+                MeshDescription.CreateTriangle(PolygonGroup, { CornerInstances[0], CornerInstances[1], CornerInstances[2] });
+                MeshDescription.CreateTriangle(PolygonGroup, { CornerInstances[0], CornerInstances[2], CornerInstances[3] });
+            }
+            else
+            {
+                MeshDescription.CreateTriangle(PolygonGroup, { CornerInstances[0], CornerInstances[2], CornerInstances[1] });
+                MeshDescription.CreateTriangle(PolygonGroup, { CornerInstances[0], CornerInstances[3], CornerInstances[2] });
+            }
+        }
+    }
+}
+
+UStaticMesh* FLayoutLensProxyMesh::BuildMergedBoxMesh(UObject* Outer, const TArray<FLayoutLensBox>& Boxes, FName Name)
+{
+    if (Boxes.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    FMeshDescription MeshDescription;
+    BuildBoxMeshDescription(Boxes, MeshDescription);
+
+    UStaticMesh* StaticMesh = NewObject<UStaticMesh>(Outer, Name, RF_Transient);
+    StaticMesh->GetStaticMaterials().Add(FStaticMaterial());
+
+    UStaticMesh::FBuildMeshDescriptionsParams BuildParams;
+    BuildParams.bBuildSimpleCollision = false;
+    BuildParams.bFastBuild = true;
+
+    const TArray<const FMeshDescription*> MeshDescriptions = { &MeshDescription };
+    StaticMesh->BuildFromMeshDescriptions(MeshDescriptions, BuildParams);
+
+    return StaticMesh;
+}
+
+#if WITH_EDITOR
+UStaticMesh* FLayoutLensProxyMesh::BakeMergedBoxMesh(UObject* Outer, FName Name, const TArray<FLayoutLensBox>& Boxes)
+{
+    if (Boxes.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    UStaticMesh* StaticMesh = NewObject<UStaticMesh>(Outer, Name);
+    StaticMesh->GetStaticMaterials().Add(FStaticMaterial());
+
+    FStaticMeshSourceModel& SourceModel = StaticMesh->AddSourceModel();
+    SourceModel.BuildSettings.bRecomputeNormals = false;
+    SourceModel.BuildSettings.bRecomputeTangents = true;
+    SourceModel.BuildSettings.bGenerateLightmapUVs = false;
+
+    FMeshDescription* MeshDescription = StaticMesh->CreateMeshDescription(0);
+    BuildBoxMeshDescription(Boxes, *MeshDescription);
+    StaticMesh->CommitMeshDescription(0);
+
+    StaticMesh->Build(true);
+    return StaticMesh;
+}
+#endif
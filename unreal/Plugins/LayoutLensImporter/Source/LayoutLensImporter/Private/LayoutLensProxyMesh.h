@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensPlanGeometry.h"
+
+class UStaticMesh;
+struct FMeshDescription;
+
+struct FLayoutLensProxyMesh
+{
+    // Flat-shaded, single-section geometry for all boxes.
+    static void BuildBoxMeshDescription(const TArray<FLayoutLensBox>& Boxes, FMeshDescription& OutMeshDescription);
+
+    // Merges the boxes into one transient static mesh, so a whole room draws in a single call.
+    static UStaticMesh* BuildMergedBoxMesh(UObject* Outer, const TArray<FLayoutLensBox>& Boxes, FName Name = NAME_None);
+
+#if WITH_EDITOR
+    // Same geometry as a savable mesh with a source model, for meshes that live in a level or package.
+    static UStaticMesh* BakeMergedBoxMesh(UObject* Outer, FName Name, const TArray<FLayoutLensBox>& Boxes);
+#endif
+};
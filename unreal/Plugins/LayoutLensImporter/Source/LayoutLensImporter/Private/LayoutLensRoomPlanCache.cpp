@@ -0,0 +1,224 @@
+#include "LayoutLensRoomPlanCache.h"
+
+#include "LayoutLensRoomPlanJson.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    TAutoConsoleVariable<int32> CVarParseCacheMaxMemoryMB(
+        TEXT("LayoutLens.ParseCache.MaxMemoryMB"),
+        256,
+        TEXT("Memory cap of the LayoutLens parsed room plan cache in MB. 0 disables caching."));
+
+    const int32 MaxCachedPlans = 4096;
+}
+
+FLayoutLensRoomPlanCache& FLayoutLensRoomPlanCache::Get()
+{
+    static FLayoutLensRoomPlanCache Instance;
+    return Instance;
+}
+
+FLayoutLensRoomPlanCache::FLayoutLensRoomPlanCache()
+    : Entries(MaxCachedPlans)
+{
+}
+
+FString FLayoutLensRoomPlanCache::MakeKey(const FString& AbsolutePath, uint64 ContentHash)
+{
+    return FString::Printf(TEXT("%016llx|%s"), ContentHash, *AbsolutePath);
+}
+
+int64 FLayoutLensRoomPlanCache::EstimateSizeBytes(const FLayoutLensRoomPlan& Plan)
+{
+    int64 SizeBytes = sizeof(FLayoutLensRoomPlan);
+    SizeBytes += Plan.Boundary.GetAllocatedSize();
+    SizeBytes += Plan.Openings.GetAllocatedSize();
+    SizeBytes += Plan.Elements.GetAllocatedSize();
+
+    for (const FLayoutLensOpening& Opening : Plan.Openings)
+    {
+        SizeBytes += Opening.Kind.GetAllocatedSize();
+    }
+
+    for (const FLayoutLensElement& Element : Plan.Elements)
+    {
+        SizeBytes += Element.Id.GetAllocatedSize();
+        SizeBytes += Element.Label.GetAllocatedSize();
+        SizeBytes += Element.Placement.GetAllocatedSize();
+        SizeBytes += Element.FootprintKind.GetAllocatedSize();
+        SizeBytes += Element.PolygonPoints.GetAllocatedSize();
+    }
+
+    return SizeBytes;
+}
+
+bool FLayoutLensRoomPlanCache::LoadRoomPlan(
+    const FString& AbsolutePath,
+    TSharedPtr<const FLayoutLensRoomPlan>& OutPlan,
+    uint64& OutDocumentVersion,
+    FString& OutError)
+{
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+    if (!PlatformFile.FileExists(*AbsolutePath))
+    {
+        OutError = FString::Printf(TEXT("File not found: %s"), *AbsolutePath);
+        return false;
+    }
+
+    // The region must be released before the handle that owns the mapping.
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    TArray<uint8> FallbackBytes;
+
+    FOpenMappedResult MappedResult = PlatformFile.OpenMappedEx(*AbsolutePath);
+    if (MappedResult.HasValue())
+    {
+        MappedHandle = MappedResult.StealValue();
+        MappedRegion.Reset(MappedHandle->MapRegion());
+    }
+
+    const uint8* Bytes = nullptr;
+    int64 ByteCount = 0;
+
+    if (MappedRegion.IsValid())
+    {
+        Bytes = MappedRegion->GetMappedPtr();
+        ByteCount = MappedRegion->GetMappedSize();
+    }
+    else
+    {
+        if (!FFileHelper::LoadFileToArray(FallbackBytes, *AbsolutePath))
+        {
+            OutError = FString::Printf(TEXT("LoadFileToArray failed: %s"), *AbsolutePath);
+            return false;
+        }
+
+        Bytes = FallbackBytes.GetData();
+        ByteCount = FallbackBytes.Num();
+    }
+
+    const uint64 ContentHash = FXxHash64::HashBuffer(Bytes, ByteCount).Hash;
+    const FString Key = MakeKey(AbsolutePath, ContentHash);
+    const int64 CapacityBytes = (int64)FMath::Max(CVarParseCacheMaxMemoryMB.GetValueOnAnyThread(), 0) * 1024 * 1024;
+
+    {
+        FScopeLock Lock(&Mutex);
+
+        if (const FEntry* Entry = Entries.FindAndTouch(Key))
+        {
+            Hits++;
+            OutPlan = Entry->Plan;
+            OutDocumentVersion = Entry->DocumentVersion;
+            return true;
+        }
+
+        Misses++;
+    }
+
+    FString JsonText;
+    FFileHelper::BufferToString(JsonText, Bytes, (int32)ByteCount);
+
+    const TSharedRef<FLayoutLensRoomPlan> ParsedPlan = MakeShared<FLayoutLensRoomPlan>();
+    if (!FLayoutLensRoomPlanJson::ParseRoomPlan(JsonText, *ParsedPlan, OutError))
+    {
+        return false;
+    }
+
+    FEntry NewEntry;
+    NewEntry.Plan = ParsedPlan;
+    NewEntry.DocumentVersion = FLayoutLensRoomPlanJson::ContinueHash(FLayoutLensRoomPlanJson::BeginHash(), Bytes, ByteCount);
+    NewEntry.SizeBytes = EstimateSizeBytes(*ParsedPlan);
+
+    OutPlan = NewEntry.Plan;
+    OutDocumentVersion = NewEntry.DocumentVersion;
+
+    if (CapacityBytes <= 0 || NewEntry.SizeBytes > CapacityBytes)
+    {
+        return true;
+    }
+
+    FScopeLock Lock(&Mutex);
+
+    // A changed file makes its previous entry unreachable; drop it instead of waiting for eviction.
+    FString PreviousKey;
+    if (LatestKeyByPath.RemoveAndCopyValue(AbsolutePath, PreviousKey) && PreviousKey != Key)
+    {
+        if (const FEntry* PreviousEntry = Entries.FindAndTouch(PreviousKey))
+        {
+            UsedBytes -= PreviousEntry->SizeBytes;
+            Entries.Remove(PreviousKey);
+        }
+    }
+
+    if (!Entries.Contains(Key))
+    {
+        EvictToCapacity(CapacityBytes - NewEntry.SizeBytes);
+        if (Entries.Num() >= Entries.Max())
+        {
+            EvictLeastRecent();
+        }
+
+        UsedBytes += NewEntry.SizeBytes;
+        Entries.Add(Key, MoveTemp(NewEntry));
+    }
+
+    LatestKeyByPath.Add(AbsolutePath, Key);
+    return true;
+}
+
+void FLayoutLensRoomPlanCache::EvictToCapacity(int64 CapacityBytes)
+{
+    while (UsedBytes > CapacityBytes && Entries.Num() > 0)
+    {
+        EvictLeastRecent();
+    }
+}
+
+void FLayoutLensRoomPlanCache::EvictLeastRecent()
+{
+    const FString EvictedKey = Entries.GetLeastRecentKey();
+    UsedBytes -= Entries.RemoveLeastRecent().SizeBytes;
+
+    // Keys are "hash|path"; the path only forgets the key if a newer load has not replaced it.
+    int32 SeparatorIndex = INDEX_NONE;
+    if (EvictedKey.FindChar(TEXT('|'), SeparatorIndex))
+    {
+        const FString EvictedPath = EvictedKey.RightChop(SeparatorIndex + 1);
+        const FString* LatestKey = LatestKeyByPath.Find(EvictedPath);
+        if (LatestKey != nullptr && *LatestKey == EvictedKey)
+        {
+            LatestKeyByPath.Remove(EvictedPath);
+        }
+    }
+}
+
+FLayoutLensRoomPlanCacheStats FLayoutLensRoomPlanCache::GetStats() const
+{
+    FScopeLock Lock(&Mutex);
+
+    FLayoutLensRoomPlanCacheStats Stats;
+    Stats.Hits = Hits;
+    Stats.Misses = Misses;
+    Stats.EntryCount = Entries.Num();
+    Stats.UsedBytes = UsedBytes;
+    Stats.CapacityBytes = (int64)FMath::Max(CVarParseCacheMaxMemoryMB.GetValueOnAnyThread(), 0) * 1024 * 1024;
+    return Stats;
+}
+
+void FLayoutLensRoomPlanCache::Empty()
+{
+    FScopeLock Lock(&Mutex);
+
+    Entries.Empty(MaxCachedPlans);
+    LatestKeyByPath.Empty();
+    UsedBytes = 0;
+}
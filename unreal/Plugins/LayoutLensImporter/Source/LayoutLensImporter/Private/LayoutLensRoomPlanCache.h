@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "LayoutLensRoomPlanTypes.h"
+
+struct FLayoutLensRoomPlanCacheStats
+{
+    int64 Hits = 0;
+    int64 Misses = 0;
+    int32 EntryCount = 0;
+    int64 UsedBytes = 0;
+    int64 CapacityBytes = 0;
+
+    float GetHitRate() const
+    {
+        const int64 Lookups = Hits + Misses;
+        return Lookups > 0 ? (float)Hits / (float)Lookups : 0.0f;
+    }
+};
+
+/*
+ * Process-wide LRU of parsed room plans keyed by absolute path + xxHash64 of the file bytes.
+ * A lookup still maps and hashes the file, but identical bytes never go through the JSON parser twice.
+ * The memory cap comes from LayoutLens.ParseCache.MaxMemoryMB (0 disables the cache). Thread-safe.
+ */
+class FLayoutLensRoomPlanCache
+{
+public:
+    static FLayoutLensRoomPlanCache& Get();
+
+    // OutDocumentVersion is the FNV-1a document hash used by the patch protocol.
+    bool LoadRoomPlan(
+        const FString& AbsolutePath,
+        TSharedPtr<const FLayoutLensRoomPlan>& OutPlan,
+        uint64& OutDocumentVersion,
+        FString& OutError);
+
+    FLayoutLensRoomPlanCacheStats GetStats() const;
+    void Empty();
+
+private:
+    FLayoutLensRoomPlanCache();
+
+    struct FEntry
+    {
+        TSharedPtr<const FLayoutLensRoomPlan> Plan;
+        uint64 DocumentVersion = 0;
+        int64 SizeBytes = 0;
+    };
+
+    static int64 EstimateSizeBytes(const FLayoutLensRoomPlan& Plan);
+    static FString MakeKey(const FString& AbsolutePath, uint64 ContentHash);
+
+    void EvictToCapacity(int64 CapacityBytes);
+    void EvictLeastRecent();
+
+private:
+    mutable FCriticalSection Mutex;
+
+    TLruCache<FString, FEntry> Entries;
+    TMap<FString, FString> LatestKeyByPath;
+
+    int64 UsedBytes = 0;
+    int64 Hits = 0;
+    int64 Misses = 0;
+};
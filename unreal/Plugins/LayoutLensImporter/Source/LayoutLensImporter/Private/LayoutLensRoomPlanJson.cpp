@@ -0,0 +1,403 @@
+#include "LayoutLensRoomPlanJson.h"
+
+#include "Json.h"
+
+bool FLayoutLensRoomPlanJson::ParseRoomPlan(const FString& JsonText, FLayoutLensRoomPlan& OutPlan, FString& OutError)
+{
+    TSharedPtr<FJsonObject> RootObject;
+
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+    const bool bOk = FJsonSerializer::Deserialize(Reader, RootObject);
+    if (!bOk || !RootObject.IsValid())
+    {
+        OutError = TEXT("FJsonSerializer::Deserialize failed.");
+        return false;
+    }
+
+    const TSharedPtr<FJsonObject>* SpaceObjectPointer = nullptr;
+
+    if (!RootObject->TryGetObjectField(TEXT("space"), SpaceObjectPointer) ||
+        SpaceObjectPointer == nullptr || !SpaceObjectPointer->IsValid())
+    {
+        OutError = TEXT("Missing 'space' object.");
+        return false;
+    }
+
+    if (!ParseSpace(*SpaceObjectPointer, OutPlan, OutError))
+    {
+        return false;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* ElementsArray = nullptr;
+    if (!RootObject->TryGetArrayField(TEXT("elements"), ElementsArray) || ElementsArray == nullptr)
+    {
+        OutError = TEXT("Missing 'elements' array.");
+        return false;
+    }
+
+    OutPlan.Elements.Empty(ElementsArray->Num());
+
+    TSet<FString> SeenIds;
+    SeenIds.Reserve(ElementsArray->Num());
+
+    for (const TSharedPtr<FJsonValue>& ElementValue : *ElementsArray)
+    {
+        const TSharedPtr<FJsonObject> ElementObject = ElementValue->AsObject();
+        if (!ElementObject.IsValid())
+        {
+            continue;
+        }
+
+        FLayoutLensElement Element;
+        ParseElement(ElementObject, Element);
+
+        if (!AcceptElementId(SeenIds, Element.Id))
+        {
+            continue;
+        }
+
+        OutPlan.Elements.Add(MoveTemp(Element));
+    }
+
+    return true;
+}
+
+bool FLayoutLensRoomPlanJson::AcceptElementId(TSet<FString>& InOutSeenIds, const FString& ElementId)
+{
+    bool bAlreadySeen = false;
+    InOutSeenIds.Add(ElementId, &bAlreadySeen);
+
+    if (bAlreadySeen)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: Dropped a second element with id '%s'; the first one is kept."), *ElementId);
+    }
+    return !bAlreadySeen;
+}
+
+bool FLayoutLensRoomPlanJson::ParseSpace(const TSharedPtr<FJsonObject>& SpaceObject, FLayoutLensRoomPlan& OutPlan, FString& OutError)
+{
+    OutPlan.RoomHeightMeters = (float)SpaceObject->GetNumberField(TEXT("height"));
+
+    const TArray<TSharedPtr<FJsonValue>>* BoundaryArray = nullptr;
+    if (!SpaceObject->TryGetArrayField(TEXT("boundary"), BoundaryArray) || BoundaryArray == nullptr)
+    {
+        OutError = TEXT("Missing 'space.boundary' array.");
+        return false;
+    }
+
+    OutPlan.Boundary.Empty();
+    for (const TSharedPtr<FJsonValue>& PointValue : *BoundaryArray)
+    {
+        const TSharedPtr<FJsonObject> PointObject = PointValue->AsObject();
+        if (!PointObject.IsValid())
+        {
+            continue;
+        }
+
+        FLayoutLensPoint2D Point;
+        Point.X = (float)PointObject->GetNumberField(TEXT("x"));
+        Point.Y = (float)PointObject->GetNumberField(TEXT("y"));
+        OutPlan.Boundary.Add(Point);
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* OpeningsArray = nullptr;
+    if (SpaceObject->TryGetArrayField(TEXT("openings"), OpeningsArray) && OpeningsArray != nullptr)
+    {
+        ParseOpenings(*OpeningsArray, OutPlan.Openings);
+    }
+
+    return true;
+}
+
+void FLayoutLensRoomPlanJson::ParseOpenings(const TArray<TSharedPtr<FJsonValue>>& OpeningsArray, TArray<FLayoutLensOpening>& OutOpenings)
+{
+    OutOpenings.Empty();
+    for (const TSharedPtr<FJsonValue>& OpeningValue : OpeningsArray)
+    {
+        const TSharedPtr<FJsonObject> OpeningObject = OpeningValue->AsObject();
+        if (!OpeningObject.IsValid())
+        {
+            continue;
+        }
+
+        FLayoutLensOpening Opening;
+        Opening.Kind = OpeningObject->GetStringField(TEXT("kind"));
+        Opening.EdgeIndex = OpeningObject->GetIntegerField(TEXT("edge_index"));
+        Opening.Center01 = (float)OpeningObject->GetNumberField(TEXT("center"));
+        Opening.WidthMeters = (float)OpeningObject->GetNumberField(TEXT("width"));
+        OutOpenings.Add(Opening);
+    }
+}
+
+void FLayoutLensRoomPlanJson::ParseElement(const TSharedPtr<FJsonObject>& ElementObject, FLayoutLensElement& OutElement)
+{
+    FLayoutLensElement& Element = OutElement;
+    Element.Id = ElementObject->GetStringField(TEXT("id"));
+    Element.Label = ElementObject->GetStringField(TEXT("label"));
+    Element.Placement = ElementObject->GetStringField(TEXT("placement"));
+    Element.HeightMeters = (float)ElementObject->GetNumberField(TEXT("height"));
+
+    const TSharedPtr<FJsonObject>* TransformObjectPointer = nullptr;
+    if (ElementObject->TryGetObjectField(TEXT("transform"), TransformObjectPointer) &&
+        TransformObjectPointer != nullptr && TransformObjectPointer->IsValid())
+    {
+        const TSharedPtr<FJsonObject>& TransformObject = *TransformObjectPointer;
+        Element.Transform.X = (float)TransformObject->GetNumberField(TEXT("x"));
+        Element.Transform.Y = (float)TransformObject->GetNumberField(TEXT("y"));
+        Element.Transform.YawDeg = (float)TransformObject->GetNumberField(TEXT("yaw_deg"));
+    }
+
+    const TSharedPtr<FJsonObject>* FootprintObjectPointer = nullptr;
+    if (ElementObject->TryGetObjectField(TEXT("footprint"), FootprintObjectPointer) &&
+        FootprintObjectPointer != nullptr && FootprintObjectPointer->IsValid())
+    {
+        const TSharedPtr<FJsonObject>& FootprintObject = *FootprintObjectPointer;
+        Element.FootprintKind = FootprintObject->GetStringField(TEXT("kind"));
+
+        if (Element.FootprintKind.Equals(TEXT("rect"), ESearchCase::IgnoreCase))
+        {
+            Element.WidthMeters = (float)FootprintObject->GetNumberField(TEXT("width"));
+            Element.DepthMeters = (float)FootprintObject->GetNumberField(TEXT("depth"));
+        }
+        else if (Element.FootprintKind.Equals(TEXT("poly"), ESearchCase::IgnoreCase))
+        {
+            const TArray<TSharedPtr<FJsonValue>>* PointsArray = nullptr;
+            if (FootprintObject->TryGetArrayField(TEXT("points"), PointsArray) && PointsArray != nullptr)
+            {
+                Element.PolygonPoints.Empty();
+
+                for (const TSharedPtr<FJsonValue>& PolyPointValue : *PointsArray)
+                {
+                    const TSharedPtr<FJsonObject> PolyPointObject = PolyPointValue->AsObject();
+                    if (!PolyPointObject.IsValid())
+                    {
+                        continue;
+                    }
+
+                    FLayoutLensPoint2D PolyPoint;
+                    PolyPoint.X = (float)PolyPointObject->GetNumberField(TEXT("x"));
+                    PolyPoint.Y = (float)PolyPointObject->GetNumberField(TEXT("y"));
+                    Element.PolygonPoints.Add(PolyPoint);
+                }
+
+                float MinX = 0.0f;
+                float MaxX = 0.0f;
+                float MinY = 0.0f;
+                float MaxY = 0.0f;
+
+                if (Element.PolygonPoints.Num() > 0)
+                {
+                    MinX = Element.PolygonPoints[0].X;
+                    MaxX = Element.PolygonPoints[0].X;
+                    MinY = Element.PolygonPoints[0].Y;
+                    MaxY = Element.PolygonPoints[0].Y;
+
+                    for (const FLayoutLensPoint2D& P : Element.PolygonPoints)
+                    {
+                        MinX = FMath::Min(MinX, P.X);
+                        MaxX = FMath::Max(MaxX, P.X);
+                        MinY = FMath::Min(MinY, P.Y);
+                        MaxY = FMath::Max(MaxY, P.Y);
+                    }
+
+                    Element.WidthMeters = FMath::Max(MaxX - MinX, 0.01f);
+                    Element.DepthMeters = FMath::Max(MaxY - MinY, 0.01f);
+                }
+            }
+        }
+    }
+}
+
+bool FLayoutLensRoomPlanJson::WriteRoomPlan(const FString& SourceJsonText, const FLayoutLensRoomPlan& Plan, FString& OutJsonText, FString& OutError)
+{
+    TSharedPtr<FJsonObject> RootObject = MakeShared<FJsonObject>();
+
+    if (!SourceJsonText.IsEmpty())
+    {
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(SourceJsonText);
+        if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+        {
+            OutError = TEXT("FJsonSerializer::Deserialize failed.");
+            return false;
+        }
+    }
+
+    const TSharedPtr<FJsonObject>* SourceSpacePointer = nullptr;
+    const TSharedPtr<FJsonObject> SpaceObject =
+        RootObject->TryGetObjectField(TEXT("space"), SourceSpacePointer) && SourceSpacePointer != nullptr && SourceSpacePointer->IsValid()
+            ? *SourceSpacePointer
+            : MakeShared<FJsonObject>();
+
+    WriteSpace(Plan, SpaceObject);
+    RootObject->SetObjectField(TEXT("space"), SpaceObject);
+
+    // Source objects are reused by id so fields the parser does not read survive; elements only the plan has are
+    // written fresh and elements only the source has are dropped.
+    TMap<FString, TSharedPtr<FJsonObject>> SourceElementsById;
+
+    const TArray<TSharedPtr<FJsonValue>>* SourceElementsArray = nullptr;
+    if (RootObject->TryGetArrayField(TEXT("elements"), SourceElementsArray) && SourceElementsArray != nullptr)
+    {
+        for (const TSharedPtr<FJsonValue>& ElementValue : *SourceElementsArray)
+        {
+            const TSharedPtr<FJsonObject> ElementObject = ElementValue->AsObject();
+            if (ElementObject.IsValid())
+            {
+                SourceElementsById.FindOrAdd(ElementObject->GetStringField(TEXT("id")), ElementObject);
+            }
+        }
+    }
+
+    TArray<TSharedPtr<FJsonValue>> ElementsArray;
+    ElementsArray.Reserve(Plan.Elements.Num());
+
+    for (const FLayoutLensElement& Element : Plan.Elements)
+    {
+        const TSharedPtr<FJsonObject>* SourceElement = SourceElementsById.Find(Element.Id);
+        const TSharedPtr<FJsonObject> ElementObject = SourceElement != nullptr ? *SourceElement : MakeShared<FJsonObject>();
+
+        WriteElement(Element, ElementObject);
+        ElementsArray.Add(MakeShared<FJsonValueObject>(ElementObject));
+    }
+
+    RootObject->SetArrayField(TEXT("elements"), ElementsArray);
+
+    OutJsonText.Reset();
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutJsonText);
+    if (!FJsonSerializer::Serialize(RootObject.ToSharedRef(), Writer))
+    {
+        OutError = TEXT("FJsonSerializer::Serialize failed.");
+        return false;
+    }
+
+    return true;
+}
+
+void FLayoutLensRoomPlanJson::WriteSpace(const FLayoutLensRoomPlan& Plan, const TSharedPtr<FJsonObject>& SpaceObject)
+{
+    SpaceObject->SetNumberField(TEXT("height"), RoundMeters(Plan.RoomHeightMeters));
+    SpaceObject->SetArrayField(TEXT("boundary"), WritePoints(Plan.Boundary));
+
+    TArray<TSharedPtr<FJsonValue>> OpeningsArray;
+    OpeningsArray.Reserve(Plan.Openings.Num());
+
+    for (const FLayoutLensOpening& Opening : Plan.Openings)
+    {
+        const TSharedPtr<FJsonObject> OpeningObject = MakeShared<FJsonObject>();
+        OpeningObject->SetStringField(TEXT("kind"), Opening.Kind);
+        OpeningObject->SetNumberField(TEXT("edge_index"), Opening.EdgeIndex);
+        OpeningObject->SetNumberField(TEXT("center"), RoundMeters(Opening.Center01));
+        OpeningObject->SetNumberField(TEXT("width"), RoundMeters(Opening.WidthMeters));
+        OpeningsArray.Add(MakeShared<FJsonValueObject>(OpeningObject));
+    }
+
+    SpaceObject->SetArrayField(TEXT("openings"), OpeningsArray);
+}
+
+void FLayoutLensRoomPlanJson::WriteElement(const FLayoutLensElement& Element, const TSharedPtr<FJsonObject>& ElementObject)
+{
+    ElementObject->SetStringField(TEXT("id"), Element.Id);
+    ElementObject->SetStringField(TEXT("label"), Element.Label);
+    ElementObject->SetStringField(TEXT("placement"), Element.Placement);
+    ElementObject->SetNumberField(TEXT("height"), RoundMeters(Element.HeightMeters));
+
+    const TSharedPtr<FJsonObject>* SourceTransformPointer = nullptr;
+    const TSharedPtr<FJsonObject> TransformObject =
+        ElementObject->TryGetObjectField(TEXT("transform"), SourceTransformPointer) && SourceTransformPointer != nullptr && SourceTransformPointer->IsValid()
+            ? *SourceTransformPointer
+            : MakeShared<FJsonObject>();
+
+    TransformObject->SetNumberField(TEXT("x"), RoundMeters(Element.Transform.X));
+    TransformObject->SetNumberField(TEXT("y"), RoundMeters(Element.Transform.Y));
+    TransformObject->SetNumberField(TEXT("yaw_deg"), RoundMeters(Element.Transform.YawDeg));
+    ElementObject->SetObjectField(TEXT("transform"), TransformObject);
+
+    const TSharedPtr<FJsonObject> FootprintObject = MakeShared<FJsonObject>();
+    FootprintObject->SetStringField(TEXT("kind"), Element.FootprintKind.IsEmpty() ? TEXT("rect") : *Element.FootprintKind);
+
+    if (Element.FootprintKind.Equals(TEXT("poly"), ESearchCase::IgnoreCase))
+    {
+        FootprintObject->SetArrayField(TEXT("points"), WritePoints(Element.PolygonPoints));
+    }
+    else
+    {
+        FootprintObject->SetNumberField(TEXT("width"), RoundMeters(Element.WidthMeters));
+        FootprintObject->SetNumberField(TEXT("depth"), RoundMeters(Element.DepthMeters));
+    }
+
+    ElementObject->SetObjectField(TEXT("footprint"), FootprintObject);
+}
+
+TArray<TSharedPtr<FJsonValue>> FLayoutLensRoomPlanJson::WritePoints(const TArray<FLayoutLensPoint2D>& Points)
+{
+    TArray<TSharedPtr<FJsonValue>> PointsArray;
+    PointsArray.Reserve(Points.Num());
+
+    for (const FLayoutLensPoint2D& Point : Points)
+    {
+        const TSharedPtr<FJsonObject> PointObject = MakeShared<FJsonObject>();
+        PointObject->SetNumberField(TEXT("x"), RoundMeters(Point.X));
+        PointObject->SetNumberField(TEXT("y"), RoundMeters(Point.Y));
+        PointsArray.Add(MakeShared<FJsonValueObject>(PointObject));
+    }
+
+    return PointsArray;
+}
+
+double FLayoutLensRoomPlanJson::RoundMeters(float Value)
+{
+    // Millimetres are plenty and keep float noise out of the file.
+    return FMath::RoundToDouble(Value * 1000.0) / 1000.0;
+}
+
+uint64 FLayoutLensRoomPlanJson::HashDocument(const FString& JsonText, uint64 Seed)
+{
+    const FTCHARToUTF8 Utf8(*JsonText);
+    return ContinueHash(BeginHash(Seed), (const uint8*)Utf8.Get(), Utf8.Length());
+}
+
+uint64 FLayoutLensRoomPlanJson::BeginHash(uint64 Seed)
+{
+    const uint64 FnvOffsetBasis = 0xcbf29ce484222325ull;
+    return FnvOffsetBasis ^ Seed;
+}
+
+uint64 FLayoutLensRoomPlanJson::ContinueHash(uint64 Hash, const uint8* Bytes, int64 ByteCount)
+{
+    const uint64 FnvPrime = 0x100000001b3ull;
+
+    for (int64 Index = 0; Index < ByteCount; Index++)
+    {
+        Hash ^= Bytes[Index];
+        Hash *= FnvPrime;
+    }
+
+    return Hash;
+}
+
+FString FLayoutLensRoomPlanJson::VersionToString(uint64 Version)
+{
+    return FString::Printf(TEXT("%016llx"), Version);
+}
+
+bool FLayoutLensRoomPlanJson::VersionFromString(const FString& Text, uint64& OutVersion)
+{
+    FString CleanText = Text;
+    CleanText.TrimStartAndEndInline();
+
+    if (CleanText.IsEmpty() || CleanText.Len() > 16)
+    {
+        return false;
+    }
+
+    for (const TCHAR Character : CleanText)
+    {
+        if (!FChar::IsHexDigit(Character))
+        {
+            return false;
+        }
+    }
+
+    OutVersion = FCString::Strtoui64(*CleanText, nullptr, 16);
+    return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensRoomPlanTypes.h"
+
+class FJsonObject;
+class FJsonValue;
+
+struct FLayoutLensRoomPlanJson
+{
+    static bool ParseRoomPlan(const FString& JsonText, FLayoutLensRoomPlan& OutPlan, FString& OutError);
+
+    static bool ParseSpace(const TSharedPtr<FJsonObject>& SpaceObject, FLayoutLensRoomPlan& OutPlan, FString& OutError);
+    static void ParseOpenings(const TArray<TSharedPtr<FJsonValue>>& OpeningsArray, TArray<FLayoutLensOpening>& OutOpenings);
+    static void ParseElement(const TSharedPtr<FJsonObject>& ElementObject, FLayoutLensElement& OutElement);
+
+    // Ids key the actors, instance slots and patches, so only the first element with a given id is kept; a repeat
+    // is logged and the caller drops it.
+    static bool AcceptElementId(TSet<FString>& InOutSeenIds, const FString& ElementId);
+
+    // Writes Plan as a room plan document. SourceJsonText, when given, is the template: its other top-level fields
+    // and unknown fields of elements that are still in Plan are kept.
+    static bool WriteRoomPlan(const FString& SourceJsonText, const FLayoutLensRoomPlan& Plan, FString& OutJsonText, FString& OutError);
+
+    static void WriteSpace(const FLayoutLensRoomPlan& Plan, const TSharedPtr<FJsonObject>& SpaceObject);
+    static void WriteElement(const FLayoutLensElement& Element, const TSharedPtr<FJsonObject>& ElementObject);
+    static TArray<TSharedPtr<FJsonValue>> WritePoints(const TArray<FLayoutLensPoint2D>& Points);
+    static double RoundMeters(float Value);
+
+    // 64-bit FNV-1a over the UTF-8 bytes of a document. Plain enough that the Python side can produce the same value.
+    static uint64 HashDocument(const FString& JsonText, uint64 Seed = 0);
+    static uint64 BeginHash(uint64 Seed = 0);
+    static uint64 ContinueHash(uint64 Hash, const uint8* Bytes, int64 ByteCount);
+    static FString VersionToString(uint64 Version);
+    static bool VersionFromString(const FString& Text, uint64& OutVersion);
+};
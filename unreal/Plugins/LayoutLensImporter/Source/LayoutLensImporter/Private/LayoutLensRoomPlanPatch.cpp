@@ -0,0 +1,226 @@
+#include "LayoutLensRoomPlanPatch.h"
+
+#include "LayoutLensRoomPlanJson.h"
+
+#include "Json.h"
+
+bool FLayoutLensRoomPlanPatcher::ParsePatch(const FString& JsonText, FLayoutLensRoomPlanPatch& OutPatch, FString& OutError)
+{
+    TSharedPtr<FJsonObject> RootObject;
+
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
+    const bool bOk = FJsonSerializer::Deserialize(Reader, RootObject);
+    if (!bOk || !RootObject.IsValid())
+    {
+        OutError = TEXT("FJsonSerializer::Deserialize failed.");
+        return false;
+    }
+
+    int64 Sequence = 0;
+    if (!RootObject->TryGetNumberField(TEXT("sequence"), Sequence))
+    {
+        OutError = TEXT("Missing 'sequence' number.");
+        return false;
+    }
+
+    FString BaseVersionText;
+    if (!RootObject->TryGetStringField(TEXT("base_version"), BaseVersionText) ||
+        !FLayoutLensRoomPlanJson::VersionFromString(BaseVersionText, OutPatch.BaseVersion))
+    {
+        OutError = TEXT("Missing or malformed 'base_version' hash.");
+        return false;
+    }
+
+    const TArray<TSharedPtr<FJsonValue>>* OpsArray = nullptr;
+    if (!RootObject->TryGetArrayField(TEXT("ops"), OpsArray) || OpsArray == nullptr)
+    {
+        OutError = TEXT("Missing 'ops' array.");
+        return false;
+    }
+
+    OutPatch.Sequence = Sequence;
+    OutPatch.ResultVersion = FLayoutLensRoomPlanJson::HashDocument(JsonText, OutPatch.BaseVersion);
+    OutPatch.Ops.Empty(OpsArray->Num());
+
+    for (int32 OpIndex = 0; OpIndex < OpsArray->Num(); OpIndex++)
+    {
+        const TSharedPtr<FJsonObject> OpObject = (*OpsArray)[OpIndex]->AsObject();
+        if (!OpObject.IsValid())
+        {
+            OutError = FString::Printf(TEXT("Op #%d is not an object."), OpIndex);
+            return false;
+        }
+
+        const FString OpName = OpObject->GetStringField(TEXT("op"));
+
+        FLayoutLensPatchOp Op;
+
+        if (OpName.Equals(TEXT("add"), ESearchCase::IgnoreCase) || OpName.Equals(TEXT("update"), ESearchCase::IgnoreCase))
+        {
+            const TSharedPtr<FJsonObject>* ElementObjectPointer = nullptr;
+            if (!OpObject->TryGetObjectField(TEXT("element"), ElementObjectPointer) ||
+                ElementObjectPointer == nullptr || !ElementObjectPointer->IsValid())
+            {
+                OutError = FString::Printf(TEXT("Op #%d (%s) is missing 'element'."), OpIndex, *OpName);
+                return false;
+            }
+
+            Op.Type = OpName.Equals(TEXT("add"), ESearchCase::IgnoreCase)
+                ? ELayoutLensPatchOpType::AddElement
+                : ELayoutLensPatchOpType::UpdateElement;
+
+            FLayoutLensRoomPlanJson::ParseElement(*ElementObjectPointer, Op.Element);
+            Op.ElementId = Op.Element.Id;
+        }
+        else if (OpName.Equals(TEXT("remove"), ESearchCase::IgnoreCase))
+        {
+            Op.Type = ELayoutLensPatchOpType::RemoveElement;
+            Op.ElementId = OpObject->GetStringField(TEXT("id"));
+        }
+        else if (OpName.Equals(TEXT("replace_space"), ESearchCase::IgnoreCase))
+        {
+            const TSharedPtr<FJsonObject>* SpaceObjectPointer = nullptr;
+            if (!OpObject->TryGetObjectField(TEXT("space"), SpaceObjectPointer) ||
+                SpaceObjectPointer == nullptr || !SpaceObjectPointer->IsValid())
+            {
+                OutError = FString::Printf(TEXT("Op #%d (replace_space) is missing 'space'."), OpIndex);
+                return false;
+            }
+
+            FLayoutLensRoomPlan SpaceOnly;
+            if (!FLayoutLensRoomPlanJson::ParseSpace(*SpaceObjectPointer, SpaceOnly, OutError))
+            {
+                return false;
+            }
+
+            Op.Type = ELayoutLensPatchOpType::ReplaceSpace;
+            Op.RoomHeightMeters = SpaceOnly.RoomHeightMeters;
+            Op.Boundary = MoveTemp(SpaceOnly.Boundary);
+            Op.Openings = MoveTemp(SpaceOnly.Openings);
+        }
+        else if (OpName.Equals(TEXT("replace_openings"), ESearchCase::IgnoreCase))
+        {
+            const TArray<TSharedPtr<FJsonValue>>* OpeningsArray = nullptr;
+            if (!OpObject->TryGetArrayField(TEXT("openings"), OpeningsArray) || OpeningsArray == nullptr)
+            {
+                OutError = FString::Printf(TEXT("Op #%d (replace_openings) is missing 'openings'."), OpIndex);
+                return false;
+            }
+
+            Op.Type = ELayoutLensPatchOpType::ReplaceOpenings;
+            FLayoutLensRoomPlanJson::ParseOpenings(*OpeningsArray, Op.Openings);
+        }
+        else
+        {
+            OutError = FString::Printf(TEXT("Op #%d has unknown op '%s'."), OpIndex, *OpName);
+            return false;
+        }
+
+        OutPatch.Ops.Add(MoveTemp(Op));
+    }
+
+    return true;
+}
+
+void FLayoutLensRoomPlanPatcher::BuildElementIndex(const FLayoutLensRoomPlan& Plan, TMap<FString, int32>& OutElementIndexById)
+{
+    OutElementIndexById.Empty(Plan.Elements.Num());
+    for (int32 Index = 0; Index < Plan.Elements.Num(); Index++)
+    {
+        OutElementIndexById.Add(Plan.Elements[Index].Id, Index);
+    }
+}
+
+bool FLayoutLensRoomPlanPatcher::ApplyPatch(
+    const FLayoutLensRoomPlanPatch& Patch,
+    FLayoutLensRoomPlan& InOutPlan,
+    TMap<FString, int32>& InOutElementIndexById,
+    FLayoutLensPatchResult& OutResult,
+    FString& OutError)
+{
+    TMap<FString, bool> PendingExistence;
+
+    for (const FLayoutLensPatchOp& Op : Patch.Ops)
+    {
+        if (Op.Type == ELayoutLensPatchOpType::ReplaceSpace || Op.Type == ELayoutLensPatchOpType::ReplaceOpenings)
+        {
+            continue;
+        }
+
+        if (Op.ElementId.IsEmpty())
+        {
+            OutError = TEXT("Element op without an id.");
+            return false;
+        }
+
+        const bool* PendingPointer = PendingExistence.Find(Op.ElementId);
+        const bool bExists = PendingPointer != nullptr ? *PendingPointer : InOutElementIndexById.Contains(Op.ElementId);
+
+        if (Op.Type == ELayoutLensPatchOpType::AddElement && bExists)
+        {
+            OutError = FString::Printf(TEXT("Cannot add '%s': id already exists."), *Op.ElementId);
+            return false;
+        }
+
+        if (Op.Type != ELayoutLensPatchOpType::AddElement && !bExists)
+        {
+            OutError = FString::Printf(TEXT("Cannot update/remove '%s': id not found."), *Op.ElementId);
+            return false;
+        }
+
+        PendingExistence.Add(Op.ElementId, Op.Type != ELayoutLensPatchOpType::RemoveElement);
+    }
+
+    for (const FLayoutLensPatchOp& Op : Patch.Ops)
+    {
+        switch (Op.Type)
+        {
+        case ELayoutLensPatchOpType::AddElement:
+        {
+            const int32 NewIndex = InOutPlan.Elements.Add(Op.Element);
+            InOutElementIndexById.Add(Op.ElementId, NewIndex);
+            OutResult.AddedIds.Add(Op.ElementId);
+            break;
+        }
+        case ELayoutLensPatchOpType::UpdateElement:
+        {
+            const int32 Index = InOutElementIndexById.FindChecked(Op.ElementId);
+            InOutPlan.Elements[Index] = Op.Element;
+            OutResult.UpdatedIds.AddUnique(Op.ElementId);
+            break;
+        }
+        case ELayoutLensPatchOpType::RemoveElement:
+        {
+            const int32 Index = InOutElementIndexById.FindAndRemoveChecked(Op.ElementId);
+            InOutPlan.Elements.RemoveAtSwap(Index);
+
+            if (InOutPlan.Elements.IsValidIndex(Index))
+            {
+                InOutElementIndexById.Add(InOutPlan.Elements[Index].Id, Index);
+            }
+
+            OutResult.AddedIds.Remove(Op.ElementId);
+            OutResult.UpdatedIds.Remove(Op.ElementId);
+            OutResult.RemovedIds.AddUnique(Op.ElementId);
+            break;
+        }
+        case ELayoutLensPatchOpType::ReplaceSpace:
+        {
+            InOutPlan.RoomHeightMeters = Op.RoomHeightMeters;
+            InOutPlan.Boundary = Op.Boundary;
+            InOutPlan.Openings = Op.Openings;
+            OutResult.bSpaceReplaced = true;
+            OutResult.bOpeningsReplaced = true;
+            break;
+        }
+        case ELayoutLensPatchOpType::ReplaceOpenings:
+        {
+            InOutPlan.Openings = Op.Openings;
+            OutResult.bOpeningsReplaced = true;
+            break;
+        }
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensRoomPlanTypes.h"
+
+/*
+ * Patch message applied on top of the last loaded room plan:
+ *
+ * {
+ *   "sequence": 3,
+ *   "base_version": "9f1c0a7d2b3e4f50",
+ *   "ops": [
+ *     { "op": "add",    "element": { ...element... } },
+ *     { "op": "update", "element": { ...element... } },
+ *     { "op": "remove", "id": "chair_02" },
+ *     { "op": "replace_space",    "space": { "height": 2.7, "boundary": [...], "openings": [...] } },
+ *     { "op": "replace_openings", "openings": [...] }
+ *   ]
+ * }
+ *
+ * A full room_plan.json resets the sequence to 0 and its version to HashDocument(file text).
+ * Each applied patch advances the version to HashDocument(patch text, base_version).
+ */
+
+enum class ELayoutLensPatchOpType : uint8
+{
+    AddElement,
+    UpdateElement,
+    RemoveElement,
+    ReplaceSpace,
+    ReplaceOpenings
+};
+
+struct FLayoutLensPatchOp
+{
+    ELayoutLensPatchOpType Type = ELayoutLensPatchOpType::UpdateElement;
+
+    FString ElementId;
+    FLayoutLensElement Element;
+
+    float RoomHeightMeters = 2.7f;
+    TArray<FLayoutLensPoint2D> Boundary;
+    TArray<FLayoutLensOpening> Openings;
+};
+
+struct FLayoutLensRoomPlanPatch
+{
+    int64 Sequence = 0;
+    uint64 BaseVersion = 0;
+    uint64 ResultVersion = 0;
+    TArray<FLayoutLensPatchOp> Ops;
+};
+
+struct FLayoutLensPatchResult
+{
+    TArray<FString> AddedIds;
+    TArray<FString> UpdatedIds;
+    TArray<FString> RemovedIds;
+
+    bool bSpaceReplaced = false;
+    bool bOpeningsReplaced = false;
+};
+
+struct FLayoutLensRoomPlanPatcher
+{
+    static bool ParsePatch(const FString& JsonText, FLayoutLensRoomPlanPatch& OutPatch, FString& OutError);
+
+    static void BuildElementIndex(const FLayoutLensRoomPlan& Plan, TMap<FString, int32>& OutElementIndexById);
+
+    // Validates every op against the current plan before touching it, so a rejected patch leaves the plan unchanged.
+    static bool ApplyPatch(
+        const FLayoutLensRoomPlanPatch& Patch,
+        FLayoutLensRoomPlan& InOutPlan,
+        TMap<FString, int32>& InOutElementIndexById,
+        FLayoutLensPatchResult& OutResult,
+        FString& OutError);
+};
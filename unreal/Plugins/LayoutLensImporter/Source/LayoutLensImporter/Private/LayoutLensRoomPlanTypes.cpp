@@ -0,0 +1,59 @@
+#include "LayoutLensRoomPlanTypes.h"
+
+namespace
+{
+    // Placement and footprint kind repeat across elements, so they go through the package name table.
+    void SerializeAsName(FArchive& Ar, FString& Value)
+    {
+        FName Name = Ar.IsSaving() ? FName(*Value) : NAME_None;
+        Ar << Name;
+
+        if (Ar.IsLoading())
+        {
+            Value = Name.IsNone() ? FString() : Name.ToString();
+        }
+    }
+}
+
+FArchive& operator<<(FArchive& Ar, FLayoutLensPoint2D& Point)
+{
+    Ar << Point.X;
+    Ar << Point.Y;
+    return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FLayoutLensOpening& Opening)
+{
+    SerializeAsName(Ar, Opening.Kind);
+    Ar << Opening.EdgeIndex;
+    Ar << Opening.Center01;
+    Ar << Opening.WidthMeters;
+    return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FLayoutLensElement& Element)
+{
+    Ar << Element.Id;
+    Ar << Element.Label;
+    SerializeAsName(Ar, Element.Placement);
+    Ar << Element.HeightMeters;
+
+    Ar << Element.Transform.X;
+    Ar << Element.Transform.Y;
+    Ar << Element.Transform.YawDeg;
+
+    SerializeAsName(Ar, Element.FootprintKind);
+    Ar << Element.WidthMeters;
+    Ar << Element.DepthMeters;
+    Ar << Element.PolygonPoints;
+    return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FLayoutLensRoomPlan& Plan)
+{
+    Ar << Plan.RoomHeightMeters;
+    Ar << Plan.Boundary;
+    Ar << Plan.Openings;
+    Ar << Plan.Elements;
+    return Ar;
+}
@@ -0,0 +1,300 @@
+#include "LayoutLensSlabMesh.h"
+
+#include "Algo/Reverse.h"
+#include "Engine/StaticMesh.h"
+#include "Hash/xxhash.h"
+#include "MeshDescription.h"
+#include "StaticMeshAttributes.h"
+
+namespace
+{
+    double Cross2D(const FVector2D& A, const FVector2D& B)
+    {
+        return A.X * B.Y - A.Y * B.X;
+    }
+
+    bool IsInsideTriangle(const FVector2D& Point, const FVector2D& A, const FVector2D& B, const FVector2D& C)
+    {
+        // Inclusive, so a vertex touching the candidate ear's edge also blocks it.
+        return Cross2D(B - A, Point - A) >= 0.0 && Cross2D(C - B, Point - B) >= 0.0 && Cross2D(A - C, Point - C) >= 0.0;
+    }
+
+    const TCHAR* FloorSlotName = TEXT("Floor");
+    const TCHAR* CeilingSlotName = TEXT("Ceiling");
+
+    void GetBoundaryPointsCm(const FLayoutLensRoomPlan& Plan, TArray<FVector2D>& OutPointsCm)
+    {
+        OutPointsCm.Reset(Plan.Boundary.Num());
+        for (const FLayoutLensPoint2D& Point : Plan.Boundary)
+        {
+            OutPointsCm.Add(FVector2D(Point.X * 100.0, Point.Y * 100.0));
+        }
+    }
+
+    FPolygonGroupID AddPolygonGroup(FMeshDescription& MeshDescription, const TCHAR* SlotName)
+    {
+        const FPolygonGroupID PolygonGroup = MeshDescription.CreatePolygonGroup();
+        FStaticMeshAttributes(MeshDescription).GetPolygonGroupMaterialSlotNames()[PolygonGroup] = FName(SlotName);
+        return PolygonGroup;
+    }
+
+    void AddSurface(
+        FMeshDescription& MeshDescription,
+        const TCHAR* SlotName,
+        const TArray<FVector2D>& PointsCm,
+        const TArray<int32>& Triangles,
+        double HeightCm,
+        const FVector& Normal)
+    {
+        FStaticMeshAttributes Attributes(MeshDescription);
+        TVertexAttributesRef<FVector3f> Positions = Attributes.GetVertexPositions();
+        TVertexInstanceAttributesRef<FVector3f> Normals = Attributes.GetVertexInstanceNormals();
+        TVertexInstanceAttributesRef<FVector2f> UVs = Attributes.GetVertexInstanceUVs();
+
+        const FPolygonGroupID PolygonGroup = AddPolygonGroup(MeshDescription, SlotName);
+
+        TArray<FVertexInstanceID> PointInstances;
+        PointInstances.Reserve(PointsCm.Num());
+
+        for (const FVector2D& PointCm : PointsCm)
+        {
+            const FVertexID Vertex = MeshDescription.CreateVertex();
+            Positions[Vertex] = FVector3f((float)PointCm.X, (float)PointCm.Y, (float)HeightCm);
+
+            const FVertexInstanceID Instance = MeshDescription.CreateVertexInstance(Vertex);
+            Normals[Instance] = (FVector3f)Normal;
+            UVs[Instance] = FVector2f((float)(PointCm.X * 0.01), (float)(PointCm.Y * 0.01));
+            PointInstances.Add(Instance);
+        }
+
+        for (int32 Index = 0; Index + 2 < Triangles.Num(); Index += 3)
+        {
+            const FVertexInstanceID Corner0 = PointInstances[Triangles[Index]];
+            const FVertexInstanceID Corner1 = PointInstances[Triangles[Index + 1]];
+            const FVertexInstanceID Corner2 = PointInstances[Triangles[Index + 2]];
+
+            // Same front-face rule as the proxy boxes: (P2 - P0) ^ (P1 - P0) points along the normal.
+            const FVector P0(PointsCm[Triangles[Index]], 0.0);
+            const FVector P1(PointsCm[Triangles[Index + 1]], 0.0);
+            const FVector P2(PointsCm[Triangles[Index + 2]], 0.0);
+
+            if ((((P2 - P0) ^ (P1 - P0)) | Normal) >= 0.0)
+            {
+                MeshDescription.CreateTriangle(PolygonGroup, { Corner0, Corner1, Corner2 });
+            }
+            else
+            {
+                MeshDescription.CreateTriangle(PolygonGroup, { Corner0, Corner2, Corner1 });
+            }
+        }
+    }
+}
+
+bool FLayoutLensSlabMesh::Triangulate(const TArray<FVector2D>& Points, TArray<int32>& OutTriangles)
+{
+    OutTriangles.Reset();
+
+    TArray<int32> Remaining;
+    Remaining.Reserve(Points.Num());
+
+    for (int32 PointIndex = 0; PointIndex < Points.Num(); PointIndex++)
+    {
+        if (Remaining.Num() == 0 || !Points[PointIndex].Equals(Points[Remaining.Last()], UE_KINDA_SMALL_NUMBER))
+        {
+            Remaining.Add(PointIndex);
+        }
+    }
+
+    // Closed boundaries often repeat the first point at the end.
+    if (Remaining.Num() > 1 && Points[Remaining[0]].Equals(Points[Remaining.Last()], UE_KINDA_SMALL_NUMBER))
+    {
+        Remaining.Pop();
+    }
+
+    if (Remaining.Num() < 3)
+    {
+        return false;
+    }
+
+    double TwiceArea = 0.0;
+    for (int32 Index = 0; Index < Remaining.Num(); Index++)
+    {
+        TwiceArea += Cross2D(Points[Remaining[Index]], Points[Remaining[(Index + 1) % Remaining.Num()]]);
+    }
+
+    if (FMath::Abs(TwiceArea) < UE_KINDA_SMALL_NUMBER)
+    {
+        return false;
+    }
+
+    if (TwiceArea < 0.0)
+    {
+        Algo::Reverse(Remaining);
+    }
+
+    OutTriangles.Reserve((Remaining.Num() - 2) * 3);
+
+    while (Remaining.Num() > 3)
+    {
+        const int32 Count = Remaining.Num();
+        int32 EarIndex = INDEX_NONE;
+        int32 FlattestIndex = 0;
+        double FlattestCross = TNumericLimits<double>::Max();
+
+        for (int32 Index = 0; Index < Count && EarIndex == INDEX_NONE; Index++)
+        {
+            const FVector2D& A = Points[Remaining[(Index + Count - 1) % Count]];
+            const FVector2D& B = Points[Remaining[Index]];
+            const FVector2D& C = Points[Remaining[(Index + 1) % Count]];
+
+            const double Turn = Cross2D(B - A, C - B);
+            if (FMath::Abs(Turn) < FlattestCross)
+            {
+                FlattestCross = FMath::Abs(Turn);
+                FlattestIndex = Index;
+            }
+
+            // Reflex and collinear corners are never ears.
+            if (Turn <= UE_KINDA_SMALL_NUMBER)
+            {
+                continue;
+            }
+
+            bool bEmpty = true;
+            for (int32 Other = 0; Other < Count && bEmpty; Other++)
+            {
+                if (Other == Index || Other == (Index + Count - 1) % Count || Other == (Index + 1) % Count)
+                {
+                    continue;
+                }
+
+                const FVector2D& Point = Points[Remaining[Other]];
+                if (!Point.Equals(A) && !Point.Equals(B) && !Point.Equals(C) && IsInsideTriangle(Point, A, B, C))
+                {
+                    bEmpty = false;
+                }
+            }
+
+            if (bEmpty)
+            {
+                EarIndex = Index;
+            }
+        }
+
+        if (EarIndex == INDEX_NONE)
+        {
+            // Only collinear runs or a self-touching boundary are left; dropping the flattest corner loses
+            // no area in the first case and keeps the loop finite in the second.
+            Remaining.RemoveAt(FlattestIndex);
+            continue;
+        }
+
+        OutTriangles.Add(Remaining[(EarIndex + Count - 1) % Count]);
+        OutTriangles.Add(Remaining[EarIndex]);
+        OutTriangles.Add(Remaining[(EarIndex + 1) % Count]);
+        Remaining.RemoveAt(EarIndex);
+    }
+
+    const double LastTurn = Cross2D(Points[Remaining[1]] - Points[Remaining[0]], Points[Remaining[2]] - Points[Remaining[1]]);
+    if (LastTurn > UE_KINDA_SMALL_NUMBER)
+    {
+        OutTriangles.Append(Remaining);
+    }
+
+    return OutTriangles.Num() > 0;
+}
+
+bool FLayoutLensSlabMesh::TriangulateBoundary(const FLayoutLensRoomPlan& Plan, TArray<int32>& OutTriangles)
+{
+    TArray<FVector2D> PointsCm;
+    GetBoundaryPointsCm(Plan, PointsCm);
+    return Triangulate(PointsCm, OutTriangles);
+}
+
+uint64 FLayoutLensSlabMesh::ComputeSlabKey(const FLayoutLensRoomPlan& Plan, bool bFloor, bool bCeiling)
+{
+    TArray<float> Values;
+    Values.Reserve(Plan.Boundary.Num() * 2 + 2);
+
+    for (const FLayoutLensPoint2D& Point : Plan.Boundary)
+    {
+        Values.Add(Point.X);
+        Values.Add(Point.Y);
+    }
+
+    Values.Add(Plan.RoomHeightMeters);
+    Values.Add((bFloor ? 1.0f : 0.0f) + (bCeiling ? 2.0f : 0.0f));
+
+    return FXxHash64::HashBuffer(Values.GetData(), Values.Num() * sizeof(float)).Hash;
+}
+
+void FLayoutLensSlabMesh::BuildSlabMeshDescription(const FLayoutLensRoomPlan& Plan, bool bFloor, bool bCeiling, const TArray<int32>* BoundaryTriangles, FMeshDescription& MeshDescription)
+{
+    FStaticMeshAttributes Attributes(MeshDescription);
+    Attributes.Register();
+
+    TArray<FVector2D> PointsCm;
+    GetBoundaryPointsCm(Plan, PointsCm);
+
+    TArray<int32> NewTriangles;
+    if (BoundaryTriangles == nullptr)
+    {
+        Triangulate(PointsCm, NewTriangles);
+        BoundaryTriangles = &NewTriangles;
+    }
+
+    const TArray<int32>& Triangles = *BoundaryTriangles;
+    if (Triangles.Num() == 0)
+    {
+        return;
+    }
+
+    MeshDescription.ReserveNewVertices(PointsCm.Num() * 2);
+    MeshDescription.ReserveNewVertexInstances(PointsCm.Num() * 2);
+    MeshDescription.ReserveNewTriangles(Triangles.Num() / 3 * 2);
+
+    // Both groups always exist so the floor and ceiling keep their material slots when only one is built.
+    if (bFloor)
+    {
+        AddSurface(MeshDescription, FloorSlotName, PointsCm, Triangles, 0.0, FVector::UpVector);
+    }
+    else
+    {
+        AddPolygonGroup(MeshDescription, FloorSlotName);
+    }
+
+    if (bCeiling)
+    {
+        AddSurface(MeshDescription, CeilingSlotName, PointsCm, Triangles, Plan.RoomHeightMeters * 100.0, FVector::DownVector);
+    }
+}
+
+UStaticMesh* FLayoutLensSlabMesh::BuildSlabMesh(UObject* Outer, const FLayoutLensRoomPlan& Plan, bool bFloor, bool bCeiling, const TArray<int32>* BoundaryTriangles)
+{
+    if (!bFloor && !bCeiling)
+    {
+        return nullptr;
+    }
+
+    FMeshDescription MeshDescription;
+    BuildSlabMeshDescription(Plan, bFloor, bCeiling, BoundaryTriangles, MeshDescription);
+
+    if (MeshDescription.Triangles().Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: Room boundary has no area; no floor or ceiling built."));
+        return nullptr;
+    }
+
+    UStaticMesh* StaticMesh = NewObject<UStaticMesh>(Outer, NAME_None, RF_Transient);
+    StaticMesh->GetStaticMaterials().Add(FStaticMaterial(nullptr, FName(FloorSlotName)));
+    StaticMesh->GetStaticMaterials().Add(FStaticMaterial(nullptr, FName(CeilingSlotName)));
+
+    UStaticMesh::FBuildMeshDescriptionsParams BuildParams;
+    BuildParams.bBuildSimpleCollision = false;
+    BuildParams.bFastBuild = true;
+
+    const TArray<const FMeshDescription*> MeshDescriptions = { &MeshDescription };
+    StaticMesh->BuildFromMeshDescriptions(MeshDescriptions, BuildParams);
+
+    return StaticMesh;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensRoomPlanTypes.h"
+
+class UStaticMesh;
+struct FMeshDescription;
+
+struct FLayoutLensSlabMesh
+{
+    // Ear clipping of a simple polygon in either winding, concave ones included. OutTriangles holds point indices,
+    // counter-clockwise. Repeated and collinear points are skipped; false if nothing with area is left.
+    static bool Triangulate(const TArray<FVector2D>& Points, TArray<int32>& OutTriangles);
+
+    // Triangulate over the plan boundary in centimetres; the indices are into Plan.Boundary. Plan assets cache it.
+    static bool TriangulateBoundary(const FLayoutLensRoomPlan& Plan, TArray<int32>& OutTriangles);
+
+    // Changes exactly when the slab mesh would: boundary points, room height and which slabs are wanted.
+    static uint64 ComputeSlabKey(const FLayoutLensRoomPlan& Plan, bool bFloor, bool bCeiling);
+
+    // Floor at z = 0 facing up (section 0) and ceiling at RoomHeightMeters facing down (section 1), in plan
+    // centimetres with UVs in metres. BoundaryTriangles come from TriangulateBoundary; null triangulates here.
+    static void BuildSlabMeshDescription(const FLayoutLensRoomPlan& Plan, bool bFloor, bool bCeiling, const TArray<int32>* BoundaryTriangles, FMeshDescription& OutMeshDescription);
+
+    // Transient mesh with Floor and Ceiling material slots, or nullptr for a degenerate boundary.
+    static UStaticMesh* BuildSlabMesh(UObject* Outer, const FLayoutLensRoomPlan& Plan, bool bFloor, bool bCeiling, const TArray<int32>* BoundaryTriangles = nullptr);
+};
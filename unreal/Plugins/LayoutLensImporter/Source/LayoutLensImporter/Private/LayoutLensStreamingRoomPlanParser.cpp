@@ -0,0 +1,213 @@
+#include "LayoutLensStreamingRoomPlanParser.h"
+
+#include "LayoutLensRoomPlanJson.h"
+
+#include "Json.h"
+
+void FLayoutLensStreamingRoomPlanParser::Reset()
+{
+    *this = FLayoutLensStreamingRoomPlanParser();
+}
+
+bool FLayoutLensStreamingRoomPlanParser::AppendText(const FString& NewText, TArray<FLayoutLensElement>& OutNewElements, FString& OutError)
+{
+    if (bComplete || NewText.IsEmpty())
+    {
+        return true;
+    }
+
+    Buffer.Append(NewText);
+
+    const int32 BufferLength = Buffer.Len();
+    for (; ScanIndex < BufferLength && !bComplete; ScanIndex++)
+    {
+        const TCHAR Character = Buffer[ScanIndex];
+
+        if (!bRootStarted)
+        {
+            // Anything before the root object (e.g. a markdown fence from the model) is ignored.
+            if (Character == TCHAR('{'))
+            {
+                bRootStarted = true;
+                Depth = 1;
+            }
+            continue;
+        }
+
+        if (bInString)
+        {
+            if (bEscape)
+            {
+                bEscape = false;
+            }
+            else if (Character == TCHAR('\\'))
+            {
+                bEscape = true;
+            }
+            else if (Character == TCHAR('"'))
+            {
+                bInString = false;
+                if (Depth == 1)
+                {
+                    LastRootString = Buffer.Mid(StringStart + 1, ScanIndex - StringStart - 1);
+                }
+                StringStart = INDEX_NONE;
+            }
+            continue;
+        }
+
+        switch (Character)
+        {
+        case TCHAR('"'):
+            bInString = true;
+            StringStart = ScanIndex;
+            break;
+
+        case TCHAR(':'):
+            if (Depth == 1)
+            {
+                CurrentRootKey = LastRootString;
+            }
+            break;
+
+        case TCHAR(','):
+            if (Depth == 1)
+            {
+                CurrentRootKey.Empty();
+            }
+            break;
+
+        case TCHAR('{'):
+        case TCHAR('['):
+            if (FragmentStart == INDEX_NONE)
+            {
+                if (Depth == 1 && Character == TCHAR('{') && CurrentRootKey == TEXT("space"))
+                {
+                    FragmentStart = ScanIndex;
+                    FragmentDepth = Depth + 1;
+                }
+                else if (Depth == 1 && Character == TCHAR('[') && CurrentRootKey == TEXT("elements"))
+                {
+                    bInElementsArray = true;
+                }
+                else if (Depth == 2 && Character == TCHAR('{') && bInElementsArray)
+                {
+                    FragmentStart = ScanIndex;
+                    FragmentDepth = Depth + 1;
+                }
+            }
+            Depth++;
+            break;
+
+        case TCHAR('}'):
+        case TCHAR(']'):
+            Depth--;
+            if (Depth < 0)
+            {
+                OutError = FString::Printf(TEXT("Unbalanced bracket at character %lld."), BufferBase + ScanIndex);
+                return false;
+            }
+
+            if (FragmentStart != INDEX_NONE && Depth == FragmentDepth - 1)
+            {
+                const int32 Start = FragmentStart;
+                FragmentStart = INDEX_NONE;
+
+                if (!OnFragmentClosed(Start, ScanIndex + 1, OutNewElements, OutError))
+                {
+                    return false;
+                }
+            }
+            else if (Depth == 1 && Character == TCHAR(']') && bInElementsArray)
+            {
+                bInElementsArray = false;
+            }
+
+            if (Depth == 0)
+            {
+                bComplete = true;
+                ConsistentPrefixLength = BufferBase + ScanIndex + 1;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    CompactBuffer();
+    return true;
+}
+
+bool FLayoutLensStreamingRoomPlanParser::OnFragmentClosed(
+    int32 Start, int32 End, TArray<FLayoutLensElement>& OutNewElements, FString& OutError)
+{
+    const FString FragmentText = Buffer.Mid(Start, End - Start);
+
+    TSharedPtr<FJsonObject> FragmentObject;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FragmentText);
+    if (!FJsonSerializer::Deserialize(Reader, FragmentObject) || !FragmentObject.IsValid())
+    {
+        // A malformed fragment is skipped like a non-object element in the full parser.
+        ConsistentPrefixLength = BufferBase + End;
+        return true;
+    }
+
+    if (bInElementsArray)
+    {
+        FLayoutLensElement Element;
+        FLayoutLensRoomPlanJson::ParseElement(FragmentObject, Element);
+
+        if (FLayoutLensRoomPlanJson::AcceptElementId(ElementIds, Element.Id))
+        {
+            Plan.Elements.Add(Element);
+            OutNewElements.Add(MoveTemp(Element));
+        }
+    }
+    else
+    {
+        if (!FLayoutLensRoomPlanJson::ParseSpace(FragmentObject, Plan, OutError))
+        {
+            return false;
+        }
+        bHasSpace = true;
+    }
+
+    ConsistentPrefixLength = BufferBase + End;
+    return true;
+}
+
+void FLayoutLensStreamingRoomPlanParser::CompactBuffer()
+{
+    int32 KeepFrom = ScanIndex;
+
+    if (FragmentStart != INDEX_NONE)
+    {
+        KeepFrom = FMath::Min(KeepFrom, FragmentStart);
+    }
+
+    if (bInString && StringStart != INDEX_NONE)
+    {
+        KeepFrom = FMath::Min(KeepFrom, StringStart);
+    }
+
+    const int32 MinimumDropChars = 16 * 1024;
+    if (KeepFrom < MinimumDropChars)
+    {
+        return;
+    }
+
+    Buffer.RightChopInline(KeepFrom, EAllowShrinking::No);
+    BufferBase += KeepFrom;
+    ScanIndex -= KeepFrom;
+
+    if (FragmentStart != INDEX_NONE)
+    {
+        FragmentStart -= KeepFrom;
+    }
+
+    if (StringStart != INDEX_NONE)
+    {
+        StringStart -= KeepFrom;
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LayoutLensRoomPlanTypes.h"
+
+/*
+ * Tolerant parser for a room_plan.json that is still being written.
+ *
+ * Text is fed in chunks with AppendText. Only the new characters are scanned; a small amount of
+ * state (nesting depth, string/escape flags, the last key at root level) carries over between calls.
+ * Whenever "space" or one element of "elements" closes, that fragment alone is handed to the regular
+ * JSON parser, so a truncated tail never produces a half-filled element.
+ */
+class FLayoutLensStreamingRoomPlanParser
+{
+public:
+    void Reset();
+
+    // Returns false only when the document can no longer become valid (e.g. unbalanced brackets).
+    bool AppendText(const FString& NewText, TArray<FLayoutLensElement>& OutNewElements, FString& OutError);
+
+    bool HasSpace() const { return bHasSpace; }
+    bool IsComplete() const { return bComplete; }
+
+    const FLayoutLensRoomPlan& GetPlan() const { return Plan; }
+
+    // Characters of the document covered by the last fully parsed fragment.
+    int64 GetConsistentPrefixLength() const { return ConsistentPrefixLength; }
+    int64 GetScannedLength() const { return BufferBase + ScanIndex; }
+
+private:
+    bool OnFragmentClosed(int32 Start, int32 End, TArray<FLayoutLensElement>& OutNewElements, FString& OutError);
+    void CompactBuffer();
+
+private:
+    FLayoutLensRoomPlan Plan;
+    TSet<FString> ElementIds;
+
+    FString Buffer;
+    int64 BufferBase = 0;
+    int32 ScanIndex = 0;
+
+    int32 Depth = 0;
+    bool bInString = false;
+    bool bEscape = false;
+    bool bRootStarted = false;
+    bool bComplete = false;
+    bool bHasSpace = false;
+
+    int32 StringStart = INDEX_NONE;
+    FString LastRootString;
+    FString CurrentRootKey;
+
+    bool bInElementsArray = false;
+    int32 FragmentStart = INDEX_NONE;
+    int32 FragmentDepth = 0;
+
+    int64 ConsistentPrefixLength = 0;
+};
@@ -1,30 +1,259 @@
 #include "LayoutLensVisualizerActor.h"
 
+#include "LayoutLensCollisionComponent.h"
+#include "LayoutLensDistanceField.h"
+#include "LayoutLensElementPicker.h"
+#include "LayoutLensFurnitureMesh.h"
+#include "LayoutLensHeatmapComponent.h"
+#include "LayoutLensMassRepresentation.h"
+#include "LayoutLensMeshCatalog.h"
+#include "LayoutLensMeshSubstitution.h"
+#include "LayoutLensNavObstacleComponent.h"
+#include "LayoutLensOccupancyGrid.h"
+#include "LayoutLensOverlapResolver.h"
+#include "LayoutLensAabbTree.h"
+#include "LayoutLensPlacementIndex.h"
 #include "LayoutLensPlaceholderActor.h"
+#include "LayoutLensPlanAsset.h"
+#include "LayoutLensPlanGeometry.h"
+#include "LayoutLensProxyMesh.h"
+#include "LayoutLensRoomPlanCache.h"
+#include "LayoutLensRoomPlanJson.h"
+#include "LayoutLensRoomPlanPatch.h"
+#include "LayoutLensSlabMesh.h"
+#include "LayoutLensStreamingRoomPlanParser.h"
+#include "LayoutLensWalkability.h"
+#include "SLayoutLensLabelLayer.h"
 #include "SSLayoutLensOverlayWidget.h"
 
+#include "Async/Async.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/LineBatchComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Containers/Ticker.h"
 #include "Engine/Engine.h"
 #include "Engine/GameViewportClient.h"
-#include "DrawDebugHelpers.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformFileManager.h"
 #include "InputCoreTypes.h"
-#include "Json.h"
+#include "Materials/MaterialInterface.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "NavigationPath.h"
+#include "NavigationSystem.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "TimerManager.h"
+#include "UObject/ConstructorHelpers.h"
+#include "UObject/ObjectSaveContext.h"
 #include "Widgets/SWeakWidget.h"
 
+namespace
+{
+    // Bump when the baked blob written by Serialize or the baked instance order changes.
+    const int32 BakedLayoutFormatVersion = 3;
+
+    // PerInstanceCustomData 0..3 of ElementInstances: placement, footprint kind, issue severity, selection state.
+    const int32 ElementCustomDataFloatCount = 4;
+    const int32 SeverityCustomDataIndex = 2;
+    const int32 SelectionCustomDataIndex = 3;
+
+    const int32 StreamingSampleBytes = 4096;
+
+    int32 FindCompleteUtf8Length(const TArray<uint8>& Bytes)
+    {
+        const int32 ByteCount = Bytes.Num();
+
+        for (int32 Index = ByteCount - 1; Index >= FMath::Max(ByteCount - 4, 0); Index--)
+        {
+            const uint8 Byte = Bytes[Index];
+            if ((Byte & 0xC0) == 0x80)
+            {
+                continue;
+            }
+
+            const int32 SequenceLength =
+                (Byte & 0x80) == 0x00 ? 1 :
+                (Byte & 0xE0) == 0xC0 ? 2 :
+                (Byte & 0xF0) == 0xE0 ? 3 : 4;
+
+            return Index + SequenceLength > ByteCount ? Index : ByteCount;
+        }
+
+        return ByteCount;
+    }
+
+    // Baked components keep their contents in actor space and follow the actor; so do live ones with
+    // UseActorTransform. The rest sit at the world origin.
+    void SetFollowsActor(USceneComponent* Component, bool bFollowsActor)
+    {
+        if (Component == nullptr || Component->IsUsingAbsoluteLocation() != bFollowsActor)
+        {
+            return;
+        }
+
+        Component->SetUsingAbsoluteLocation(!bFollowsActor);
+        Component->SetUsingAbsoluteRotation(!bFollowsActor);
+        Component->UpdateComponentToWorld();
+    }
+
+    FLayoutLensBox ToComponentBox(const USceneComponent& Component, const FLayoutLensBox& WorldBox)
+    {
+        if (Component.IsUsingAbsoluteLocation())
+        {
+            return WorldBox;
+        }
+
+        const FTransform ComponentToWorld(Component.GetComponentRotation(), Component.GetComponentLocation());
+
+        FLayoutLensBox ComponentBox = WorldBox;
+        ComponentBox.CenterCm = ComponentToWorld.InverseTransformPosition(WorldBox.CenterCm);
+        ComponentBox.Rotation = ComponentToWorld.InverseTransformRotation(WorldBox.Rotation.Quaternion()).Rotator();
+        return ComponentBox;
+    }
+}
+
 ALayoutLensVisualizerActor::ALayoutLensVisualizerActor()
 {
     PrimaryActorTick.bCanEverTick = false;
 
     RoomPlanFilePath = TEXT("output/latest/room_plan.json");
+
+    Root = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+    SetRootComponent(Root);
+
+    // Plan boxes are already in world space, so the instance components ignore the actor transform until a bake.
+    ElementInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("ElementInstances"));
+    ElementInstances->SetupAttachment(Root);
+    ElementInstances->SetUsingAbsoluteLocation(true);
+    ElementInstances->SetUsingAbsoluteRotation(true);
+    ElementInstances->SetUsingAbsoluteScale(true);
+    ElementInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    ElementInstances->NumCustomDataFloats = ElementCustomDataFloatCount;
+
+    WallInstances = CreateDefaultSubobject<UInstancedStaticMeshComponent>(TEXT("WallInstances"));
+    WallInstances->SetupAttachment(Root);
+    WallInstances->SetUsingAbsoluteLocation(true);
+    WallInstances->SetUsingAbsoluteRotation(true);
+    WallInstances->SetUsingAbsoluteScale(true);
+    WallInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+    ProxyMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ProxyMesh"));
+    ProxyMesh->SetupAttachment(Root);
+    ProxyMesh->SetUsingAbsoluteLocation(true);
+    ProxyMesh->SetUsingAbsoluteRotation(true);
+    ProxyMesh->SetUsingAbsoluteScale(true);
+    ProxyMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    ProxyMesh->SetVisibility(false);
+
+    // Built in plan space and moved with GetPlanToWorld, so moving the actor never rebuilds it.
+    Slabs = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Slabs"));
+    Slabs->SetupAttachment(Root);
+    Slabs->SetUsingAbsoluteLocation(true);
+    Slabs->SetUsingAbsoluteRotation(true);
+    Slabs->SetUsingAbsoluteScale(true);
+    Slabs->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+    // Plan space like the slabs; the body itself is built at runtime.
+    WalkthroughCollision = CreateDefaultSubobject<ULayoutLensCollisionComponent>(TEXT("WalkthroughCollision"));
+    WalkthroughCollision->SetupAttachment(Root);
+    WalkthroughCollision->SetUsingAbsoluteLocation(true);
+    WalkthroughCollision->SetUsingAbsoluteRotation(true);
+    WalkthroughCollision->SetUsingAbsoluteScale(true);
+
+    Heatmap = CreateDefaultSubobject<ULayoutLensHeatmapComponent>(TEXT("Heatmap"));
+    Heatmap->SetupAttachment(Root);
+
+    // Owned per visualizer so several rooms can redraw their outlines without flushing each other.
+    PlanLines = CreateDefaultSubobject<ULineBatchComponent>(TEXT("PlanLines"));
+    PlanLines->SetupAttachment(Root);
+
+    static ConstructorHelpers::FObjectFinder<UStaticMesh> CubeMeshFinder(TEXT("/Engine/BasicShapes/Cube.Cube"));
+    if (CubeMeshFinder.Succeeded())
+    {
+        ElementInstances->SetStaticMesh(CubeMeshFinder.Object);
+        WallInstances->SetStaticMesh(CubeMeshFinder.Object);
+    }
 }
 
 void ALayoutLensVisualizerActor::BeginPlay()
 {
     Super::BeginPlay();
 
+    ElementPool.Initialize(ElementInstances, true);
+    WallPool.Initialize(WallInstances, true);
+    UpdateComponentSpace();
+
+    // A play session copies the editor preview along with the level; only baked instances are meant to survive.
+    if (!LayoutBaked)
+    {
+        ClearSpawnedActors();
+    }
+
+    // Levels baked before custom data existed load with none; this also sizes it for the baked instances.
+    if (ElementInstances->NumCustomDataFloats != ElementCustomDataFloatCount)
+    {
+        ElementInstances->SetNumCustomDataFloats(ElementCustomDataFloatCount);
+    }
+
+    if (ElementMaterial != nullptr)
+    {
+        ElementInstances->SetMaterial(0, ElementMaterial);
+    }
+
+    if (Representation == ELayoutLensRepresentation::Mass)
+    {
+        MassRepresentation = MakeShared<FLayoutLensMassRepresentation>();
+
+        // Same setup as ElementInstances, but a pool of its own so resets on either side cannot free the other's slots.
+        MassInstances = NewObject<UInstancedStaticMeshComponent>(this, TEXT("MassInstances"), RF_Transient);
+        MassInstances->SetupAttachment(Root);
+        MassInstances->SetUsingAbsoluteLocation(true);
+        MassInstances->SetUsingAbsoluteRotation(true);
+        MassInstances->SetUsingAbsoluteScale(true);
+        MassInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        MassInstances->SetStaticMesh(ElementInstances->GetStaticMesh());
+        MassInstances->SetMaterial(0, ElementInstances->GetMaterial(0));
+        MassInstances->RegisterComponent();
+
+        if (MassRepresentation->Initialize(GetWorld(), MassInstances))
+        {
+            MassRepresentation->SetPlanToWorld(GetPlanToWorld());
+
+            GetWorldTimerManager().SetTimer(
+                MassLodTimerHandle, this, &ALayoutLensVisualizerActor::UpdateMassLod,
+                FMath::Max(MassLodUpdateIntervalSeconds, 0.01f), true);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("LayoutLens: Mass entity subsystem unavailable, falling back to instanced representation."));
+            MassRepresentation.Reset();
+            MassInstances->DestroyComponent();
+            MassInstances = nullptr;
+            Representation = ELayoutLensRepresentation::Instanced;
+        }
+    }
+
+    if (!MassRepresentation.IsValid())
+    {
+        InitializeMeshSubstitution();
+    }
+
     BindReloadHotkey();
 
+    if (SpawnLabels && GEngine != nullptr && GEngine->GameViewport != nullptr)
+    {
+        LabelLayer = SNew(SLayoutLensLabelLayer)
+            .World(GetWorld())
+            .FadeStartCm(LabelFadeStartMeters * 100.0f)
+            .MaxDistanceCm(LabelMaxDistanceMeters * 100.0f)
+            .MaxVisibleLabels(MaxVisibleLabels);
+
+        LabelLayerContainer = SNew(SWeakWidget).PossiblyNullContent(LabelLayer.ToSharedRef());
+
+        GEngine->GameViewport->AddViewportWidgetContent(LabelLayerContainer.ToSharedRef(), 40);
+    }
+
     if (ShowOverlay && GEngine != nullptr && GEngine->GameViewport != nullptr)
     {
         const TSharedRef<SLayoutLensOverlayWidget> NewOverlayWidget =
@@ -37,9 +266,34 @@ void ALayoutLensVisualizerActor::BeginPlay()
         GEngine->GameViewport->AddViewportWidgetContent(OverlayContainer.ToSharedRef(), 50);
     }
 
-    if (AutoLoadOnBeginPlay)
+    if (EnableLod)
     {
-        ReloadLayout();
+        GetWorldTimerManager().SetTimer(
+            LodTimerHandle, this, &ALayoutLensVisualizerActor::UpdateRoomLod,
+            FMath::Max(LodUpdateIntervalSeconds, 0.05f), true);
+    }
+
+    if (EnablePicking)
+    {
+        GetWorldTimerManager().SetTimer(
+            HoverTimerHandle, this, &ALayoutLensVisualizerActor::UpdateHoveredElement,
+            FMath::Max(HoverPickIntervalSeconds, 0.01f), true);
+    }
+
+    if (LayoutBaked && SkipRuntimeLoadWhenBaked)
+    {
+        RestoreBakedLayout();
+    }
+    else if (AutoLoadOnBeginPlay)
+    {
+        if (StreamRoomPlanFile)
+        {
+            BeginStreamingLayout();
+        }
+        else
+        {
+            ReloadLayout();
+        }
     }
 }
 
@@ -50,7 +304,43 @@ void ALayoutLensVisualizerActor::EndPlay(const EEndPlayReason::Type EndPlayReaso
         GEngine->GameViewport->RemoveViewportWidgetContent(OverlayContainer.ToSharedRef());
     }
 
+    if (GEngine != nullptr && GEngine->GameViewport != nullptr && LabelLayerContainer.IsValid())
+    {
+        GEngine->GameViewport->RemoveViewportWidgetContent(LabelLayerContainer.ToSharedRef());
+    }
+
+    GetWorldTimerManager().ClearTimer(MassLodTimerHandle);
+    GetWorldTimerManager().ClearTimer(LodTimerHandle);
+    GetWorldTimerManager().ClearTimer(HoverTimerHandle);
+    GetWorldTimerManager().ClearTimer(AnalysisTimerHandle);
+    bAnalysisDirty = false;
+
+    StopStreamingLayout();
     ClearSpawnedActors();
+    ClearNavObstacles();
+    ClearWalkthroughCollision();
+
+    // Nothing will drain the pool once this actor is gone.
+    for (ALayoutLensPlaceholderActor* Placeholder : RetiredPlaceholders)
+    {
+        if (Placeholder != nullptr)
+        {
+            Placeholder->Destroy();
+        }
+    }
+    RetiredPlaceholders.Empty();
+    ColdPlaceholderCount = 0;
+    GetWorldTimerManager().ClearTimer(TeardownTimerHandle);
+
+    MeshSubstitution.Reset();
+    MassRepresentation.Reset();
+    if (MassInstances != nullptr)
+    {
+        MassInstances->DestroyComponent();
+        MassInstances = nullptr;
+    }
+    LabelLayer.Reset();
+    LabelLayerContainer.Reset();
 
     Super::EndPlay(EndPlayReason);
 }
@@ -65,444 +355,2565 @@ void ALayoutLensVisualizerActor::SetRoomPlanFilePath(const FString& NewPath)
     RoomPlanFilePath = NewPath;
 }
 
+void ALayoutLensVisualizerActor::InitializeAsBuildingRoom(const FString& PlanFilePath, ELayoutLensRepresentation InRepresentation)
+{
+    RoomPlanFilePath = PlanFilePath;
+    Representation = InRepresentation;
+    UseActorTransform = true;
+    AutoLoadOnBeginPlay = true;
+    StreamRoomPlanFile = false;
+    ShowOverlay = false;
+}
+
+FTransform ALayoutLensVisualizerActor::GetPlanToWorld() const
+{
+    return UseActorTransform ? FTransform(GetActorRotation(), GetActorLocation()) : FTransform::Identity;
+}
+
+FVector ALayoutLensVisualizerActor::ToWorldPoint(const FVector& PlanPointCm) const
+{
+    return UseActorTransform ? GetPlanToWorld().TransformPosition(PlanPointCm) : PlanPointCm;
+}
+
+FLayoutLensBox ALayoutLensVisualizerActor::ToWorldBox(const FLayoutLensBox& PlanBox) const
+{
+    if (!UseActorTransform)
+    {
+        return PlanBox;
+    }
+
+    const FTransform PlanToWorld = GetPlanToWorld();
+
+    FLayoutLensBox WorldBox = PlanBox;
+    WorldBox.CenterCm = PlanToWorld.TransformPosition(PlanBox.CenterCm);
+    WorldBox.Rotation = (PlanToWorld.GetRotation() * PlanBox.Rotation.Quaternion()).Rotator();
+    return WorldBox;
+}
+
+const FLayoutLensInstanceMetadata* ALayoutLensVisualizerActor::FindElementByInstance(int32 InstanceIndex) const
+{
+    if (!ElementMetadataByInstance.IsValidIndex(InstanceIndex) || ElementMetadataByInstance[InstanceIndex].Id.IsEmpty())
+    {
+        return nullptr;
+    }
+
+    return &ElementMetadataByInstance[InstanceIndex];
+}
+
 bool ALayoutLensVisualizerActor::ReloadLayout()
 {
+    StopStreamingLayout();
+
+    if (KeepPreviousLayoutForUndo && bHasCurrentPlan)
+    {
+        PreviousPlan = CurrentPlan;
+        PreviousPlanVersion = CurrentPlanVersion;
+        bHasPreviousPlan = true;
+    }
+
     ClearSpawnedActors();
+    bHasCurrentPlan = false;
 
-    FString JsonText;
-    FString ErrorText;
+    TSharedPtr<const FLayoutLensRoomPlan> Plan;
+    uint64 PlanVersion = 0;
 
-    const bool bLoaded = LoadJsonTextFromFile(JsonText, ErrorText);
-    if (!bLoaded)
+    if (!LoadPlan(Plan, PlanVersion))
     {
-        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to load file. %s"), *ErrorText);
+        ClearNavObstacles();
+        ClearWalkthroughCollision();
         return false;
     }
 
-    FLayoutLensRoomPlan Plan;
-    const bool bParsed = ParseRoomPlanJson(JsonText, Plan, ErrorText);
-    if (!bParsed)
+    CurrentPlan = Plan.ToSharedRef();
+    FLayoutLensRoomPlanPatcher::BuildElementIndex(*CurrentPlan, ElementIndexById);
+    CurrentPlanVersion = PlanVersion;
+    LastPatchSequence = 0;
+    bHasCurrentPlan = true;
+
+    SpawnCurrentPlan();
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Loaded %d elements (version %s)."),
+        CurrentPlan->Elements.Num(), *FLayoutLensRoomPlanJson::VersionToString(CurrentPlanVersion));
+    return true;
+}
+
+bool ALayoutLensVisualizerActor::UndoReload()
+{
+    if (!bHasPreviousPlan)
     {
-        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to parse JSON. %s"), *ErrorText);
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: No previous layout to return to."));
         return false;
     }
 
-    if (DrawRoomBoundary)
+    StopStreamingLayout();
+    ClearSpawnedActors();
+
+    // Swapping keeps the undone layout as the new previous one, so a second call redoes.
+    Swap(CurrentPlan, PreviousPlan);
+    Swap(CurrentPlanVersion, PreviousPlanVersion);
+
+    FLayoutLensRoomPlanPatcher::BuildElementIndex(*CurrentPlan, ElementIndexById);
+    LastPatchSequence = 0;
+    bHasCurrentPlan = true;
+
+    SpawnCurrentPlan();
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Returned to %d elements (version %s)."),
+        CurrentPlan->Elements.Num(), *FLayoutLensRoomPlanJson::VersionToString(CurrentPlanVersion));
+    return true;
+}
+
+bool ALayoutLensVisualizerActor::IsEditorPreview() const
+{
+    const UWorld* World = GetWorld();
+    return World != nullptr && World->WorldType == EWorldType::Editor && !IsTemplate();
+}
+
+void ALayoutLensVisualizerActor::OnConstruction(const FTransform& Transform)
+{
+    Super::OnConstruction(Transform);
+
+    if (!IsEditorPreview())
     {
-        SpawnRoomOutline(Plan);
+        return;
     }
 
-    if (SpawnWalls)
+    UpdateComponentSpace();
+
+    // The instances, slabs, heatmap and collision follow the actor; only the world-space outlines and
+    // navigation obstacles are placed again.
+    if (UseActorTransform && !Transform.Equals(LastPreviewTransform))
+    {
+        PendingPreviewStages |= ELayoutLensPreviewStage::Lines | ELayoutLensPreviewStage::Obstacles;
+    }
+    LastPreviewTransform = Transform;
+
+    UpdateEditorPreview();
+}
+
+void ALayoutLensVisualizerActor::PreSave(FObjectPreSaveContext SaveContext)
+{
+    Super::PreSave(SaveContext);
+
+    // Preview instances would be saved into the level; drop them and rebuild once the save is done.
+    if (!IsEditorPreview() || LayoutBaked || !bHasCurrentPlan)
+    {
+        return;
+    }
+
+    ClearSpawnedActors();
+    bHasCurrentPlan = false;
+    PendingPreviewStages = ELayoutLensPreviewStage::All;
+
+    if (!SaveContext.IsProceduralSave())
+    {
+        TWeakObjectPtr<ALayoutLensVisualizerActor> WeakThis(this);
+        FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float)
+        {
+            if (ALayoutLensVisualizerActor* Visualizer = WeakThis.Get())
+            {
+                Visualizer->UpdateEditorPreview();
+            }
+            return false;
+        }));
+    }
+}
+
+#if WITH_EDITOR
+void ALayoutLensVisualizerActor::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    const FName PropertyName = PropertyChangedEvent.GetMemberPropertyName();
+
+    if (PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, RoomPlanFilePath) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, PlanAsset) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, PreviewInEditor))
+    {
+        PendingPreviewStages |= ELayoutLensPreviewStage::Plan;
+    }
+    else if (PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, WallThicknessCm))
+    {
+        // Wall elements are snapped against the wall thickness; floor and "on" elements do not move.
+        PendingPreviewStages |= ELayoutLensPreviewStage::Walls | ELayoutLensPreviewStage::WallElements | ELayoutLensPreviewStage::Obstacles;
+    }
+    else if (PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, SpawnWalls))
+    {
+        PendingPreviewStages |= ELayoutLensPreviewStage::Walls | ELayoutLensPreviewStage::Obstacles;
+    }
+    else if (PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, SpawnFloor) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, SpawnCeiling))
+    {
+        PendingPreviewStages |= ELayoutLensPreviewStage::Slabs;
+    }
+    else if (PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, UseActorTransform))
+    {
+        PendingPreviewStages |= ELayoutLensPreviewStage::Walls | ELayoutLensPreviewStage::Elements | ELayoutLensPreviewStage::Slabs |
+            ELayoutLensPreviewStage::Lines | ELayoutLensPreviewStage::Analysis;
+    }
+    else if (PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, DrawRoomBoundary) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, DrawOpenings))
+    {
+        PendingPreviewStages |= ELayoutLensPreviewStage::Lines;
+    }
+    else if (PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, OccupancyCellSizeMeters) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, EgressClearanceMeters) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, EnableNavigation) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, NavObstacleCellMeters) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, EnableWalkthroughCollision))
+    {
+        PendingPreviewStages |= ELayoutLensPreviewStage::Analysis;
+    }
+    else if (PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, AnalysisOverlay))
+    {
+        PendingPreviewStages |= ELayoutLensPreviewStage::Heatmap;
+    }
+    else if (PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, ElementMaterial) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, FloorMaterial) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, CeilingMaterial))
+    {
+        PendingPreviewStages |= ELayoutLensPreviewStage::Material;
+    }
+    else if (PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, MeshCatalog) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, GenerateFurnitureMeshes) ||
+        PropertyName == GET_MEMBER_NAME_CHECKED(ALayoutLensVisualizerActor, FurnitureMeshStepCm))
+    {
+        PendingPreviewStages |= ELayoutLensPreviewStage::Elements;
+    }
+
+    // Labels, LOD and representation settings only apply in game, so they leave the preview alone.
+    bPreviewInteractive = PropertyChangedEvent.ChangeType == EPropertyChangeType::Interactive;
+
+    // Reruns construction, which applies the pending stages.
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    bPreviewInteractive = false;
+}
+
+void ALayoutLensVisualizerActor::PostEditMove(bool bFinished)
+{
+    // Dragging reruns construction every frame; navigation and collision wait for the drop like a slider's analysis.
+    bPreviewInteractive = !bFinished;
+
+    Super::PostEditMove(bFinished);
+
+    bPreviewInteractive = false;
+}
+#endif
+
+void ALayoutLensVisualizerActor::UpdateEditorPreview()
+{
+    if (!IsEditorPreview() || LayoutBaked)
+    {
+        return;
+    }
+
+    if (!PreviewInEditor)
+    {
+        if (bHasCurrentPlan)
+        {
+            ClearSpawnedActors();
+            ClearNavObstacles();
+            ClearWalkthroughCollision();
+            bHasCurrentPlan = false;
+        }
+        PendingPreviewStages = ELayoutLensPreviewStage::All;
+        return;
+    }
+
+    ELayoutLensPreviewStage Stages = bHasCurrentPlan ? PendingPreviewStages : ELayoutLensPreviewStage::All;
+
+    // Keep slider and actor drags interactive on large plans: analysis, navigation and collision run once the
+    // value is committed or the actor dropped.
+    if (bPreviewInteractive)
+    {
+        Stages &= ~(ELayoutLensPreviewStage::Analysis | ELayoutLensPreviewStage::Obstacles);
+    }
+
+    PendingPreviewStages &= ~Stages;
+    if (Stages == ELayoutLensPreviewStage::None)
+    {
+        return;
+    }
+
+    ElementPool.Initialize(ElementInstances, true);
+    WallPool.Initialize(WallInstances, true);
+
+    // Both stages respawn every element, which also picks up changed mesh settings.
+    if (!MeshSubstitution.IsValid() || EnumHasAnyFlags(Stages, ELayoutLensPreviewStage::Plan | ELayoutLensPreviewStage::Elements))
+    {
+        InitializeMeshSubstitution();
+    }
+
+    const double StartSeconds = FPlatformTime::Seconds();
+
+    if (EnumHasAnyFlags(Stages, ELayoutLensPreviewStage::Material))
+    {
+        ElementInstances->SetMaterial(0, ElementMaterial);
+
+        for (UInstancedStaticMeshComponent* MeshInstances : CatalogMeshInstances)
+        {
+            if (MeshInstances != nullptr && FLayoutLensFurnitureMeshCache::IsGeneratedMesh(MeshInstances->GetStaticMesh()))
+            {
+                MeshInstances->SetMaterial(0, ElementMaterial);
+            }
+        }
+
+        Slabs->SetMaterial(0, FloorMaterial);
+        Slabs->SetMaterial(1, CeilingMaterial);
+    }
+
+    if (EnumHasAnyFlags(Stages, ELayoutLensPreviewStage::Plan))
+    {
+        ClearSpawnedActors();
+        bHasCurrentPlan = false;
+
+        TSharedPtr<const FLayoutLensRoomPlan> Plan;
+        uint64 PlanVersion = 0;
+        if (!LoadPlan(Plan, PlanVersion))
+        {
+            return;
+        }
+
+        CurrentPlan = Plan.ToSharedRef();
+        FLayoutLensRoomPlanPatcher::BuildElementIndex(*CurrentPlan, ElementIndexById);
+        CurrentPlanVersion = PlanVersion;
+        LastPatchSequence = 0;
+        bHasCurrentPlan = true;
+
+        SpawnCurrentPlan();
+
+        UE_LOG(LogTemp, Log, TEXT("LayoutLens: Editor preview of %d elements in %.2f ms."),
+            CurrentPlan->Elements.Num(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+        return;
+    }
+
+    if (EnumHasAnyFlags(Stages, ELayoutLensPreviewStage::Walls))
+    {
+        ClearWallActors();
+        if (SpawnWalls)
+        {
+            SpawnWallMeshes(*CurrentPlan);
+        }
+    }
+
+    if (EnumHasAnyFlags(Stages, ELayoutLensPreviewStage::WallElements) && PlacementIndex.IsValid())
+    {
+        PlacementIndex->SetWallThickness(WallThicknessCm);
+        UpdateWallElements();
+    }
+
+    if (EnumHasAnyFlags(Stages, ELayoutLensPreviewStage::Slabs))
+    {
+        UpdateSlabs();
+    }
+
+    if (EnumHasAnyFlags(Stages, ELayoutLensPreviewStage::Elements))
+    {
+        // One batched add instead of an instance update per element.
+        ElementPool.Reset();
+        MeshSubstitution->Reset();
+        ElementInstanceById.Empty();
+        ElementMetadataByInstance.Empty();
+        SpawnFloorElements(*CurrentPlan);
+    }
+
+    if (EnumHasAnyFlags(Stages, ELayoutLensPreviewStage::Lines))
+    {
+        RedrawDebugLines(*CurrentPlan);
+    }
+
+    if (EnumHasAnyFlags(Stages, ELayoutLensPreviewStage::Analysis))
+    {
+        RefreshAnalysis();
+        return;
+    }
+
+    if (EnumHasAnyFlags(Stages, ELayoutLensPreviewStage::Obstacles))
     {
-        SpawnWallMeshes(Plan);
+        UpdateNavObstacles();
+        UpdateWalkthroughCollision();
+    }
+
+    if (EnumHasAnyFlags(Stages, ELayoutLensPreviewStage::Heatmap))
+    {
+        UpdateHeatmap();
+    }
+}
+
+void ALayoutLensVisualizerActor::UpdateComponentSpace()
+{
+    // Baked instances are stored in actor space and follow the actor either way.
+    const bool bBakedFollowActor = UseActorTransform || LayoutBaked;
+    SetFollowsActor(ElementInstances, bBakedFollowActor);
+    SetFollowsActor(WallInstances, bBakedFollowActor);
+    SetFollowsActor(ProxyMesh, bBakedFollowActor);
+
+    SetFollowsActor(Slabs, UseActorTransform);
+    SetFollowsActor(Heatmap, UseActorTransform);
+    SetFollowsActor(WalkthroughCollision, UseActorTransform);
+
+    for (UInstancedStaticMeshComponent* MeshInstances : CatalogMeshInstances)
+    {
+        SetFollowsActor(MeshInstances, UseActorTransform);
+    }
+}
+
+void ALayoutLensVisualizerActor::SpawnCurrentPlan()
+{
+    RebuildPlacementIndex();
+    RedrawDebugLines(*CurrentPlan);
+
+    if (SpawnWalls)
+    {
+        SpawnWallMeshes(*CurrentPlan);
+    }
+
+    UpdateSlabs();
+    SpawnFloorElements(*CurrentPlan);
+    RefreshAnalysis();
+}
+
+bool ALayoutLensVisualizerActor::LoadPlan(TSharedPtr<const FLayoutLensRoomPlan>& OutPlan, uint64& OutPlanVersion) const
+{
+    if (PlanAsset != nullptr)
+    {
+        OutPlan = PlanAsset->GetSharedPlan();
+        OutPlanVersion = PlanAsset->GetSourceHash();
+        return true;
+    }
+
+    const FString AbsolutePath = GetAbsoluteFilePath(RoomPlanFilePath);
+
+    FString ErrorText;
+
+    if (!FLayoutLensRoomPlanCache::Get().LoadRoomPlan(AbsolutePath, OutPlan, OutPlanVersion, ErrorText))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to load room plan. %s"), *ErrorText);
+        return false;
+    }
+
+    return true;
+}
+
+FLayoutLensRoomPlan& ALayoutLensVisualizerActor::EditCurrentPlan()
+{
+    if (!CurrentPlan.IsUnique())
+    {
+        CurrentPlan = MakeShared<FLayoutLensRoomPlan>(*CurrentPlan);
+    }
+
+    // Only this actor holds it now, so writing through it cannot reach a cached or undo plan.
+    return const_cast<FLayoutLensRoomPlan&>(*CurrentPlan);
+}
+
+void ALayoutLensVisualizerActor::RestoreBakedLayout()
+{
+    CurrentPlan = BakedPlan;
+    FLayoutLensRoomPlanPatcher::BuildElementIndex(*CurrentPlan, ElementIndexById);
+    CurrentPlanVersion = BakedPlanVersion;
+    LastPatchSequence = 0;
+    bHasCurrentPlan = true;
+
+    RebuildPlacementIndex();
+    RedrawDebugLines(*CurrentPlan);
+    UpdateSlabs();
+
+    // The bake stores each instance's element id, so the side table is rebuilt without touching the instances.
+    if (BakedElementIds.Num() != ElementInstances->GetInstanceCount())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: %s has %d baked element ids for %d instances; loading the plan instead. Bake it again."),
+            *GetActorNameOrLabel(), BakedElementIds.Num(), ElementInstances->GetInstanceCount());
+        ReloadLayout();
+        return;
+    }
+
+    for (int32 InstanceIndex = 0; InstanceIndex < BakedElementIds.Num(); InstanceIndex++)
+    {
+        if (const int32* ElementIndex = ElementIndexById.Find(BakedElementIds[InstanceIndex]))
+        {
+            SetElementInstanceMetadata(InstanceIndex, CurrentPlan->Elements[*ElementIndex]);
+        }
+    }
+
+    for (const FLayoutLensElement& Element : CurrentPlan->Elements)
+    {
+        if (FLayoutLensPlanGeometry::IsPlacedElement(Element))
+        {
+            UpdateElementLabel(Element, ToWorldBox(MakeElementBox(Element)));
+        }
+    }
+
+    WallInstanceSlots.Empty(WallInstances->GetInstanceCount());
+    for (int32 WallIndex = 0; WallIndex < WallInstances->GetInstanceCount(); WallIndex++)
+    {
+        WallInstanceSlots.Add(WallIndex);
+    }
+
+    bProxyMeshDirty = ProxyMesh->GetStaticMesh() == nullptr;
+    RefreshAnalysis();
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Using baked layout with %d elements (version %s)."),
+        CurrentPlan->Elements.Num(), *FLayoutLensRoomPlanJson::VersionToString(CurrentPlanVersion));
+}
+
+void ALayoutLensVisualizerActor::Serialize(FArchive& Ar)
+{
+    Super::Serialize(Ar);
+
+    if (Ar.IsObjectReferenceCollector() || !LayoutBaked)
+    {
+        return;
+    }
+
+    // Stored as a blob so a format change only drops the bake instead of breaking the level load.
+    TArray<uint8> BakedBytes;
+
+    if (Ar.IsSaving())
+    {
+        FMemoryWriter Writer(BakedBytes);
+        int32 FormatVersion = BakedLayoutFormatVersion;
+        Writer << FormatVersion;
+        Writer << BakedPlanVersion;
+        Writer << const_cast<FLayoutLensRoomPlan&>(*BakedPlan);
+        Writer << BakedElementIds;
+    }
+
+    Ar << BakedBytes;
+
+    if (Ar.IsLoading())
+    {
+        FMemoryReader Reader(BakedBytes);
+        int32 FormatVersion = 0;
+        Reader << FormatVersion;
+
+        if (FormatVersion != BakedLayoutFormatVersion)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("LayoutLens: %s has baked layout format %d, expected %d. Bake it again."),
+                *GetPathName(), FormatVersion, BakedLayoutFormatVersion);
+            LayoutBaked = false;
+            return;
+        }
+
+        const TSharedRef<FLayoutLensRoomPlan> LoadedPlan = MakeShared<FLayoutLensRoomPlan>();
+        Reader << BakedPlanVersion;
+        Reader << *LoadedPlan;
+        Reader << BakedElementIds;
+        BakedPlan = LoadedPlan;
+    }
+}
+
+void ALayoutLensVisualizerActor::BakeLayout()
+{
+#if WITH_EDITOR
+    TSharedPtr<const FLayoutLensRoomPlan> Plan;
+    uint64 PlanVersion = 0;
+
+    if (!LoadPlan(Plan, PlanVersion))
+    {
+        return;
+    }
+
+    Modify();
+    ElementInstances->Modify();
+    WallInstances->Modify();
+    ProxyMesh->Modify();
+
+    // The preview's instances and side tables are replaced by the baked ones.
+    if (IsEditorPreview())
+    {
+        ClearSpawnedActors();
+        bHasCurrentPlan = false;
+    }
+
+    // Baked in actor space, so moving the actor in the level carries the baked geometry with it.
+    SetFollowsActor(ElementInstances, true);
+    SetFollowsActor(WallInstances, true);
+    SetFollowsActor(ProxyMesh, true);
+
+    TArray<FTransform> ElementTransforms;
+    TArray<FTransform> WallTransforms;
+    TArray<FLayoutLensBox> ProxyBoxes;
+    TArray<FString> ElementIds;
+
+    FLayoutLensPlacementIndex BakePlacement;
+    BakePlacement.Build(*Plan, WallThicknessCm);
+
+    for (const FLayoutLensElement& Element : Plan->Elements)
+    {
+        if (FLayoutLensPlanGeometry::IsPlacedElement(Element))
+        {
+            const FLayoutLensBox Box = ToComponentBox(*ElementInstances, ToWorldBox(BakePlacement.MakeElementBox(Element)));
+            ElementTransforms.Add(Box.ToCubeTransform());
+            ElementIds.Add(Element.Id);
+            ProxyBoxes.Add(Box);
+        }
+    }
+
+    if (SpawnWalls)
+    {
+        TArray<FLayoutLensBox> WallBoxes;
+        FLayoutLensPlanGeometry::BuildWallBoxes(*Plan, WallThicknessCm, WallBoxes);
+
+        for (const FLayoutLensBox& PlanWallBox : WallBoxes)
+        {
+            const FLayoutLensBox WallBox = ToComponentBox(*WallInstances, ToWorldBox(PlanWallBox));
+            WallTransforms.Add(WallBox.ToCubeTransform());
+            ProxyBoxes.Add(WallBox);
+        }
+    }
+
+    ElementInstances->ClearInstances();
+    ElementInstances->AddInstances(ElementTransforms, false);
+    ElementInstances->bEnableAutoLODGeneration = true;
+
+    WallInstances->ClearInstances();
+    WallInstances->AddInstances(WallTransforms, false);
+    WallInstances->bEnableAutoLODGeneration = true;
+
+    // The merged mesh is the far LOD at runtime; HLOD builders use the instance components above.
+    ProxyMesh->SetStaticMesh(FLayoutLensProxyMesh::BakeMergedBoxMesh(this, TEXT("BakedProxyMesh"), ProxyBoxes));
+    ProxyMesh->bEnableAutoLODGeneration = false;
+
+    BakedPlan = Plan.ToSharedRef();
+    BakedPlanVersion = PlanVersion;
+    BakedElementIds = MoveTemp(ElementIds);
+    LayoutBaked = true;
+    Representation = ELayoutLensRepresentation::Instanced;
+
+    MarkPackageDirty();
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Baked %d elements and %d walls into %s."),
+        ElementTransforms.Num(), WallTransforms.Num(), *GetActorNameOrLabel());
+#endif
+}
+
+void ALayoutLensVisualizerActor::ClearBakedLayout()
+{
+#if WITH_EDITOR
+    Modify();
+    ElementInstances->Modify();
+    WallInstances->Modify();
+    ProxyMesh->Modify();
+
+    ElementInstances->ClearInstances();
+    WallInstances->ClearInstances();
+    ProxyMesh->SetStaticMesh(nullptr);
+
+    BakedPlan = MakeShared<FLayoutLensRoomPlan>();
+    BakedPlanVersion = 0;
+    BakedElementIds.Empty();
+    LayoutBaked = false;
+    UpdateComponentSpace();
+
+    MarkPackageDirty();
+
+    PendingPreviewStages = ELayoutLensPreviewStage::All;
+    UpdateEditorPreview();
+#endif
+}
+
+void ALayoutLensVisualizerActor::ResolveOverlaps()
+{
+    if (PlanAsset != nullptr)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: ResolveOverlaps writes JSON next to RoomPlanFilePath; clear PlanAsset first."));
+        return;
+    }
+
+    const FString SourcePath = GetAbsoluteFilePath(RoomPlanFilePath);
+
+    // The source file is only a template for fields the plan does not carry; the live plan already has every
+    // patch applied since it was loaded.
+    FString SourceText;
+    if (!FFileHelper::LoadFileToString(SourceText, *SourcePath) && !bHasCurrentPlan)
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to load room plan: %s"), *SourcePath);
+        return;
+    }
+
+    FString ErrorText;
+
+    FLayoutLensRoomPlan Plan;
+    if (bHasCurrentPlan)
+    {
+        Plan = *CurrentPlan;
+    }
+    else if (!FLayoutLensRoomPlanJson::ParseRoomPlan(SourceText, Plan, ErrorText))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to parse room plan. %s"), *ErrorText);
+        return;
+    }
+
+    const double StartSeconds = FPlatformTime::Seconds();
+
+    FLayoutLensOverlapResolveResult Result;
+    const bool bResolved = FLayoutLensOverlapResolver::Resolve(Plan, FLayoutLensOverlapResolveSettings(), Result);
+
+    const double ResolveMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+    FString ResolvedText;
+    if (!FLayoutLensRoomPlanJson::WriteRoomPlan(SourceText, Plan, ResolvedText, ErrorText))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to write resolved plan. %s"), *ErrorText);
+        return;
+    }
+
+    // Resolving a resolved plan again overwrites it instead of stacking suffixes.
+    FString ResolvedName = FPaths::GetBaseFilename(RoomPlanFilePath);
+    if (!ResolvedName.EndsWith(TEXT(".resolved")))
+    {
+        ResolvedName += TEXT(".resolved");
+    }
+
+    const FString ResolvedFilePath = FPaths::Combine(FPaths::GetPath(RoomPlanFilePath), ResolvedName + TEXT(".json"));
+    const FString ResolvedPath = GetAbsoluteFilePath(ResolvedFilePath);
+    if (!FFileHelper::SaveStringToFile(ResolvedText, *ResolvedPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to save %s"), *ResolvedPath);
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Resolved overlaps in %d iterations (%.2f ms), moved %d elements, wrote %s."),
+        Result.Iterations, ResolveMs, Result.MovedElementIds.Num(), *ResolvedPath);
+
+    if (!bResolved)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: %d overlaps and %d out-of-bounds elements remain after resolving."),
+            Result.RemainingOverlapCount, Result.RemainingOutsideCount);
+    }
+
+    // The resolved file is now the document the plan and its version describe, so reloads and resyncs read it.
+    Modify();
+    RoomPlanFilePath = ResolvedFilePath;
+
+    if (!bHasCurrentPlan)
+    {
+        return;
+    }
+
+    for (const FString& MovedId : Result.MovedElementIds)
+    {
+        const int32* ElementIndex = ElementIndexById.Find(MovedId);
+        const FLayoutLensElement* ResolvedElement = Plan.Elements.FindByPredicate(
+            [&MovedId](const FLayoutLensElement& Element) { return Element.Id == MovedId; });
+
+        if (ElementIndex != nullptr && ResolvedElement != nullptr)
+        {
+            EditCurrentPlan().Elements[*ElementIndex].Transform = ResolvedElement->Transform;
+        }
+    }
+
+    CurrentPlanVersion = FLayoutLensRoomPlanJson::HashDocument(ResolvedText);
+    LastPatchSequence = 0;
+
+    UpdatePlacement(Result.MovedElementIds, TArray<FString>());
+
+    for (const FString& MovedId : Result.MovedElementIds)
+    {
+        if (const int32* ElementIndex = ElementIndexById.Find(MovedId))
+        {
+            SpawnOrUpdateElementActor(CurrentPlan->Elements[*ElementIndex]);
+        }
+    }
+
+    MarkAnalysisDirty();
+}
+
+bool ALayoutLensVisualizerActor::BeginStreamingLayout()
+{
+    StopStreamingLayout();
+    ClearSpawnedActors();
+    ResetStreamingState();
+
+    UWorld* World = GetWorld();
+    if (World == nullptr)
+    {
+        return false;
+    }
+
+    World->GetTimerManager().SetTimer(
+        StreamingTimerHandle, this, &ALayoutLensVisualizerActor::PollStreamingFile,
+        FMath::Max(StreamPollIntervalSeconds, 0.01f), true, 0.0f);
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Streaming %s"), *GetAbsoluteFilePath(RoomPlanFilePath));
+    return true;
+}
+
+void ALayoutLensVisualizerActor::StopStreamingLayout()
+{
+    UWorld* World = GetWorld();
+    if (World != nullptr)
+    {
+        World->GetTimerManager().ClearTimer(StreamingTimerHandle);
+    }
+
+    StreamingParser.Reset();
+    StreamingPendingBytes.Empty();
+}
+
+void ALayoutLensVisualizerActor::ResetStreamingState()
+{
+    StreamingParser = MakeShared<FLayoutLensStreamingRoomPlanParser>();
+    StreamingReadOffset = 0;
+    StreamingHash = FLayoutLensRoomPlanJson::BeginHash();
+    StreamingPendingBytes.Empty();
+    StreamingHeadBytes.Empty();
+    StreamingTailBytes.Empty();
+    StreamingFileTimestamp = FDateTime::MinValue();
+    bStreamingSpaceBuilt = false;
+
+    CurrentPlan = MakeShared<FLayoutLensRoomPlan>();
+    ElementIndexById.Empty();
+    CurrentPlanVersion = 0;
+    LastPatchSequence = 0;
+    bHasCurrentPlan = false;
+}
+
+void ALayoutLensVisualizerActor::PollStreamingFile()
+{
+    if (!StreamingParser.IsValid())
+    {
+        return;
+    }
+
+    const FString AbsolutePath = GetAbsoluteFilePath(RoomPlanFilePath);
+
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    const TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenRead(*AbsolutePath, true));
+    if (!FileHandle.IsValid())
+    {
+        return;
+    }
+
+    const int64 FileSize = FileHandle->Size();
+    const FDateTime FileTimestamp = PlatformFile.GetTimeStamp(*AbsolutePath);
+
+    if (FileSize == StreamingReadOffset && FileTimestamp == StreamingFileTimestamp)
+    {
+        return;
+    }
+
+    if (FileSize < StreamingReadOffset || !IsStreamedPrefixUnchanged(*FileHandle))
+    {
+        UE_LOG(LogTemp, Log, TEXT("LayoutLens: %s was truncated or rewritten, restarting stream."), *AbsolutePath);
+        ClearSpawnedActors();
+        ResetStreamingState();
+    }
+
+    StreamingFileTimestamp = FileTimestamp;
+
+    if (FileSize == StreamingReadOffset)
+    {
+        return;
+    }
+
+    TArray<uint8> NewBytes;
+    NewBytes.SetNumUninitialized(FileSize - StreamingReadOffset);
+    if (!FileHandle->Seek(StreamingReadOffset) || !FileHandle->Read(NewBytes.GetData(), NewBytes.Num()))
+    {
+        return;
+    }
+
+    StreamingReadOffset = FileSize;
+
+    if (StreamingHeadBytes.Num() < StreamingSampleBytes)
+    {
+        StreamingHeadBytes.Append(NewBytes.GetData(), FMath::Min(NewBytes.Num(), StreamingSampleBytes - StreamingHeadBytes.Num()));
+    }
+
+    StreamingTailBytes.Append(NewBytes);
+    if (StreamingTailBytes.Num() > StreamingSampleBytes)
+    {
+        StreamingTailBytes.RemoveAt(0, StreamingTailBytes.Num() - StreamingSampleBytes, EAllowShrinking::No);
+    }
+    StreamingHash = FLayoutLensRoomPlanJson::ContinueHash(StreamingHash, NewBytes.GetData(), NewBytes.Num());
+    StreamingPendingBytes.Append(NewBytes);
+
+    const int32 CompleteByteCount = FindCompleteUtf8Length(StreamingPendingBytes);
+    if (CompleteByteCount == 0)
+    {
+        return;
+    }
+
+    const FUTF8ToTCHAR Converter((const ANSICHAR*)StreamingPendingBytes.GetData(), CompleteByteCount);
+    const FString NewText(Converter.Length(), Converter.Get());
+    StreamingPendingBytes.RemoveAt(0, CompleteByteCount, EAllowShrinking::No);
+
+    TArray<FLayoutLensElement> NewElements;
+    FString ErrorText;
+    if (!StreamingParser->AppendText(NewText, NewElements, ErrorText))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Streaming parse failed. %s"), *ErrorText);
+        StopStreamingLayout();
+        return;
+    }
+
+    if (StreamingParser->HasSpace() && !bStreamingSpaceBuilt)
+    {
+        const FLayoutLensRoomPlan& StreamedPlan = StreamingParser->GetPlan();
+        FLayoutLensRoomPlan& Plan = EditCurrentPlan();
+        Plan.RoomHeightMeters = StreamedPlan.RoomHeightMeters;
+        Plan.Boundary = StreamedPlan.Boundary;
+        Plan.Openings = StreamedPlan.Openings;
+        bStreamingSpaceBuilt = true;
+
+        RebuildPlacementIndex();
+
+        // Wall items that came before the space were placed without walls.
+        UpdateAttachedElements();
+
+        RedrawDebugLines(*CurrentPlan);
+
+        if (SpawnWalls)
+        {
+            SpawnWallMeshes(*CurrentPlan);
+        }
+        UpdateSlabs();
+    }
+
+    const int32 FirstNewElement = CurrentPlan->Elements.Num();
+    TArray<FString> NewElementIds;
+    NewElementIds.Reserve(NewElements.Num());
+
+    for (FLayoutLensElement& Element : NewElements)
+    {
+        FLayoutLensRoomPlan& Plan = EditCurrentPlan();
+        NewElementIds.Add(Element.Id);
+        ElementIndexById.Add(Element.Id, Plan.Elements.Num());
+        Plan.Elements.Add(MoveTemp(Element));
+    }
+
+    // Accessories that arrived before their support are re-placed as it lands; the support tree itself is
+    // only rebuilt once the footprints added since outgrow a quarter of it, and once more at the end.
+    if (NewElementIds.Num() > 0)
+    {
+        UpdatePlacement(NewElementIds, TArray<FString>());
+    }
+
+    for (int32 ElementIndex = FirstNewElement; ElementIndex < CurrentPlan->Elements.Num(); ElementIndex++)
+    {
+        SpawnOrUpdateElementActor(CurrentPlan->Elements[ElementIndex]);
+    }
+
+    if (StreamingParser->IsComplete())
+    {
+        CurrentPlanVersion = StreamingHash;
+        LastPatchSequence = 0;
+        bHasCurrentPlan = true;
+
+        StopStreamingLayout();
+
+        if (PlacementIndex.IsValid())
+        {
+            PlacementIndex->CompactSupports(true);
+        }
+        MarkAnalysisDirty();
+
+        UE_LOG(LogTemp, Log, TEXT("LayoutLens: Streamed %d elements (version %s)."),
+            CurrentPlan->Elements.Num(), *FLayoutLensRoomPlanJson::VersionToString(CurrentPlanVersion));
+    }
+}
+
+bool ALayoutLensVisualizerActor::IsStreamedPrefixUnchanged(IFileHandle& FileHandle) const
+{
+    if (StreamingReadOffset == 0)
+    {
+        return true;
+    }
+
+    // Appends leave both samples alone; a new run almost always differs at the start or where the old one stopped.
+    TArray<uint8> Sample;
+
+    Sample.SetNumUninitialized(StreamingHeadBytes.Num());
+    if (!FileHandle.Seek(0) || !FileHandle.Read(Sample.GetData(), Sample.Num()) || Sample != StreamingHeadBytes)
+    {
+        return false;
+    }
+
+    Sample.SetNumUninitialized(StreamingTailBytes.Num());
+    if (!FileHandle.Seek(StreamingReadOffset - Sample.Num()) || !FileHandle.Read(Sample.GetData(), Sample.Num()) || Sample != StreamingTailBytes)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+bool ALayoutLensVisualizerActor::ApplyPlanPatchFile(const FString& PatchFilePath)
+{
+    const FString AbsolutePath = GetAbsoluteFilePath(PatchFilePath);
+
+    FString PatchJsonText;
+    if (!FFileHelper::LoadFileToString(PatchJsonText, *AbsolutePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to load patch file: %s"), *AbsolutePath);
+        return false;
+    }
+
+    return ApplyPlanPatch(PatchJsonText);
+}
+
+bool ALayoutLensVisualizerActor::ApplyPlanPatch(const FString& PatchJsonText)
+{
+    FString ErrorText;
+
+    FLayoutLensRoomPlanPatch Patch;
+    if (!FLayoutLensRoomPlanPatcher::ParsePatch(PatchJsonText, Patch, ErrorText))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to parse patch. %s"), *ErrorText);
+        return false;
+    }
+
+    const bool bInSequence = bHasCurrentPlan &&
+        Patch.Sequence == LastPatchSequence + 1 &&
+        Patch.BaseVersion == CurrentPlanVersion;
+
+    if (!bInSequence)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: Patch %lld (base %s) does not follow %lld (version %s). Resyncing."),
+            Patch.Sequence, *FLayoutLensRoomPlanJson::VersionToString(Patch.BaseVersion),
+            LastPatchSequence, *FLayoutLensRoomPlanJson::VersionToString(CurrentPlanVersion));
+        return ReloadLayout();
+    }
+
+    FLayoutLensPatchResult Result;
+    if (!FLayoutLensRoomPlanPatcher::ApplyPatch(Patch, EditCurrentPlan(), ElementIndexById, Result, ErrorText))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: Patch %lld rejected (%s). Resyncing."), Patch.Sequence, *ErrorText);
+        return ReloadLayout();
+    }
+
+    LastPatchSequence = Patch.Sequence;
+    CurrentPlanVersion = Patch.ResultVersion;
+
+    for (const FString& RemovedId : Result.RemovedIds)
+    {
+        DestroyElementActor(RemovedId);
+    }
+
+    // A new boundary moves every wall item; element changes only move what stands on the changed footprints.
+    if (Result.bSpaceReplaced)
+    {
+        RebuildPlacementIndex();
+    }
+    else
+    {
+        TArray<FString> ChangedIds = Result.AddedIds;
+        ChangedIds.Append(Result.UpdatedIds);
+        UpdatePlacement(ChangedIds, Result.RemovedIds);
+    }
+
+    for (const FString& AddedId : Result.AddedIds)
+    {
+        SpawnOrUpdateElementActor(CurrentPlan->Elements[ElementIndexById.FindChecked(AddedId)]);
+    }
+
+    for (const FString& UpdatedId : Result.UpdatedIds)
+    {
+        SpawnOrUpdateElementActor(CurrentPlan->Elements[ElementIndexById.FindChecked(UpdatedId)]);
+    }
+
+    if (Result.bSpaceReplaced)
+    {
+        ClearWallActors();
+
+        if (SpawnWalls)
+        {
+            SpawnWallMeshes(*CurrentPlan);
+        }
+        UpdateSlabs();
+    }
+
+    if (Result.bSpaceReplaced || Result.bOpeningsReplaced)
+    {
+        RedrawDebugLines(*CurrentPlan);
+    }
+
+    if (Result.bSpaceReplaced)
+    {
+        UpdateAttachedElements();
+    }
+    MarkAnalysisDirty();
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Applied patch %lld (+%d ~%d -%d)."),
+        Patch.Sequence, Result.AddedIds.Num(), Result.UpdatedIds.Num(), Result.RemovedIds.Num());
+    return true;
+}
+
+FString ALayoutLensVisualizerActor::GetAbsoluteFilePath(const FString& AnyPath) const
+{
+    FString CleanPath = AnyPath;
+    CleanPath.TrimStartAndEndInline();
+
+    if (FPaths::IsRelative(CleanPath))
+    {
+        const FString FullPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), CleanPath);
+        return FullPath;
+    }
+
+    return CleanPath;
+}
+
+void ALayoutLensVisualizerActor::ClearSpawnedActors()
+{
+    const int32 RetiredBefore = RetiredPlaceholders.Num();
+
+    ClearWallActors();
+
+    for (const TPair<FString, TObjectPtr<ALayoutLensPlaceholderActor>>& Pair : ElementActorsById)
+    {
+        RetirePlaceholder(Pair.Value);
+    }
+    ElementActorsById.Empty();
+
+    ColdPlaceholderCount = KeepPreviousLayoutForUndo ? RetiredPlaceholders.Num() - RetiredBefore : 0;
+
+    if (MassRepresentation.IsValid())
+    {
+        MassRepresentation->Reset();
+    }
+
+    if (MeshSubstitution.IsValid())
+    {
+        MeshSubstitution->Reset();
+    }
+
+    ElementPool.Reset();
+    ElementInstanceById.Empty();
+    ElementMetadataByInstance.Empty();
+
+    if (LabelLayer.IsValid())
+    {
+        LabelLayer->ClearLabels();
+    }
+
+    PlanLines->Flush();
+    Heatmap->ClearCells();
+
+    if (Picker.IsValid())
+    {
+        Picker->Reset();
+    }
+    HoveredElement = FLayoutLensPickResult();
+    SelectedElement = FLayoutLensPickResult();
+
+    ProxyMesh->SetStaticMesh(nullptr);
+    Slabs->SetStaticMesh(nullptr);
+    MarkRoomLodDirty();
+}
+
+void ALayoutLensVisualizerActor::ClearWallActors()
+{
+    for (AActor* Actor : SpawnedActors)
+    {
+        RetirePlaceholder(Actor);
+    }
+    SpawnedActors.Empty();
+
+    WallPool.Reset();
+    WallInstanceSlots.Empty();
+}
+
+void ALayoutLensVisualizerActor::RedrawDebugLines(const FLayoutLensRoomPlan& Plan)
+{
+    PlanLines->Flush();
+
+    if (DrawRoomBoundary)
+    {
+        SpawnRoomOutline(Plan);
+    }
+
+    if (DrawOpenings)
+    {
+        SpawnOpenings(Plan);
+    }
+}
+
+void ALayoutLensVisualizerActor::SpawnRoomOutline(const FLayoutLensRoomPlan& Plan)
+{
+    const float Z = 5.0f;
+    const int32 Count = Plan.Boundary.Num();
+    if (Count < 2)
+    {
+        return;
+    }
+
+    for (int32 Index = 0; Index < Count; Index++)
+    {
+        const int32 NextIndex = (Index + 1) % Count;
+
+        const FVector A = FVector(Plan.Boundary[Index].X * 100.0f, Plan.Boundary[Index].Y * 100.0f, Z);
+        const FVector B = FVector(Plan.Boundary[NextIndex].X * 100.0f, Plan.Boundary[NextIndex].Y * 100.0f, Z);
+
+        PlanLines->DrawLine(ToWorldPoint(A), ToWorldPoint(B), FColor::Cyan, 100, 4.0f);
+    }
+}
+
+void ALayoutLensVisualizerActor::SpawnOpenings(const FLayoutLensRoomPlan& Plan)
+{
+    const int32 PointCount = Plan.Boundary.Num();
+    if (PointCount < 2)
+    {
+        return;
+    }
+
+    const float RoomHeightCm = Plan.RoomHeightMeters * 100.0f;
+    const float WallOffsetCm = (WallThicknessCm * 0.5f) + 2.0f;
+
+    for (const FLayoutLensOpening& Opening : Plan.Openings)
+    {
+        const int32 EdgeIndex = FMath::Clamp(Opening.EdgeIndex, 0, PointCount - 1);
+        const int32 NextIndex = (EdgeIndex + 1) % PointCount;
+
+        const FVector EdgeA = FVector(Plan.Boundary[EdgeIndex].X * 100.0f, Plan.Boundary[EdgeIndex].Y * 100.0f, 0.0f);
+        const FVector EdgeB = FVector(Plan.Boundary[NextIndex].X * 100.0f, Plan.Boundary[NextIndex].Y * 100.0f, 0.0f);
+
+        FVector EdgeDelta = EdgeB - EdgeA;
+        EdgeDelta.Z = 0.0f;
+
+        const float EdgeLengthCm = EdgeDelta.Size();
+        if (EdgeLengthCm < 1.0f)
+        {
+            continue;
+        }
+
+        const FVector EdgeDirectionUnit = EdgeDelta / EdgeLengthCm;
+        const FVector WallNormalUnit = FVector(-EdgeDirectionUnit.Y, EdgeDirectionUnit.X, 0.0f).GetSafeNormal();
+
+        const float CenterDistanceCm = FMath::Clamp(Opening.Center01, 0.0f, 1.0f) * EdgeLengthCm;
+        const FVector CenterPoint = EdgeA + (EdgeDirectionUnit * CenterDistanceCm) + (WallNormalUnit * WallOffsetCm);
+
+        const float HalfWidthCm = (Opening.WidthMeters * 100.0f) * 0.5f;
+        const FVector A2D = CenterPoint - (EdgeDirectionUnit * HalfWidthCm);
+        const FVector B2D = CenterPoint + (EdgeDirectionUnit * HalfWidthCm);
+
+        const bool IsDoor = Opening.Kind.Equals(TEXT("door"), ESearchCase::IgnoreCase);
+        const bool IsWindow = Opening.Kind.Equals(TEXT("window"), ESearchCase::IgnoreCase);
+
+        float BottomZCm = 0.0f;
+        float TopZCm = 150.0f;
+
+        if (IsDoor)
+        {
+            BottomZCm = 0.0f;
+            TopZCm = FMath::Min(RoomHeightCm, 210.0f);
+        }
+        else if (IsWindow)
+        {
+            const float SillZCm = 100.0f;
+            const float WindowHeightCm = 100.0f;
+
+            BottomZCm = FMath::Clamp(SillZCm, 0.0f, FMath::Max(RoomHeightCm - 20.0f, 0.0f));
+            TopZCm = FMath::Min(RoomHeightCm - 10.0f, BottomZCm + WindowHeightCm);
+        }
+        else
+        {
+            BottomZCm = 0.0f;
+            TopZCm = FMath::Min(RoomHeightCm, 150.0f);
+        }
+
+        const FVector ABottom = FVector(A2D.X, A2D.Y, BottomZCm);
+        const FVector BBottom = FVector(B2D.X, B2D.Y, BottomZCm);
+        const FVector ATop = FVector(A2D.X, A2D.Y, TopZCm);
+        const FVector BTop = FVector(B2D.X, B2D.Y, TopZCm);
+
+        const FColor Color = IsDoor ? FColor::Green : (IsWindow ? FColor::Yellow : FColor::White);
+
+        PlanLines->DrawLine(ToWorldPoint(ABottom), ToWorldPoint(BBottom), Color, 8, 10.0f);
+        PlanLines->DrawLine(ToWorldPoint(ATop), ToWorldPoint(BTop), Color, 8, 10.0f);
+        PlanLines->DrawLine(ToWorldPoint(ABottom), ToWorldPoint(ATop), Color, 8, 10.0f);
+        PlanLines->DrawLine(ToWorldPoint(BBottom), ToWorldPoint(BTop), Color, 8, 10.0f);
+    }
+}
+
+void ALayoutLensVisualizerActor::SpawnFloorElements(const FLayoutLensRoomPlan& Plan)
+{
+    if (MassRepresentation.IsValid())
+    {
+        MassRepresentation->SyncElements(Plan.Elements, *PlacementIndex);
+        UpdateMassLod();
+        return;
+    }
+
+    if (Representation != ELayoutLensRepresentation::Instanced && !IsEditorPreview())
+    {
+        for (const FLayoutLensElement& Element : Plan.Elements)
+        {
+            SpawnOrUpdateElementActor(Element);
+        }
+        return;
+    }
+
+    // New elements are added in one batch so the instance buffer is rebuilt once per load.
+    TArray<FTransform> NewTransforms;
+    TArray<const FLayoutLensElement*> NewElements;
+
+    for (const FLayoutLensElement& Element : Plan.Elements)
+    {
+        if (!FLayoutLensPlanGeometry::IsPlacedElement(Element) || ElementInstanceById.Contains(Element.Id))
+        {
+            SpawnOrUpdateElementActor(Element);
+            continue;
+        }
+
+        const FLayoutLensBox Box = ToWorldBox(MakeElementBox(Element));
+        NewTransforms.Add(MakeElementInstanceTransform(Element, Box));
+        NewElements.Add(&Element);
+
+        UpdateElementLabel(Element, Box);
+    }
+
+    TArray<int32> NewSlots;
+    ElementPool.Acquire(NewTransforms, NewSlots);
+
+    for (int32 Index = 0; Index < NewSlots.Num(); Index++)
+    {
+        SetElementInstanceMetadata(NewSlots[Index], *NewElements[Index]);
+    }
+}
+
+void ALayoutLensVisualizerActor::SpawnOrUpdateElementActor(const FLayoutLensElement& Element)
+{
+    if (MassRepresentation.IsValid())
+    {
+        if (!PlacementIndex.IsValid())
+        {
+            RebuildPlacementIndex();
+        }
+
+        MassRepresentation->SetElement(Element, *PlacementIndex);
+        return;
+    }
+
+    if (!FLayoutLensPlanGeometry::IsPlacedElement(Element))
+    {
+        DestroyElementActor(Element.Id);
+        return;
+    }
+
+    const FLayoutLensBox Box = ToWorldBox(MakeElementBox(Element));
+
+    if (Representation == ELayoutLensRepresentation::Instanced || IsEditorPreview())
+    {
+        SpawnOrUpdateElementInstance(Element, Box);
+        UpdateElementLabel(Element, Box);
+        return;
+    }
+
+    ALayoutLensPlaceholderActor* Placeholder = nullptr;
+
+    if (const TObjectPtr<ALayoutLensPlaceholderActor>* ExistingPointer = ElementActorsById.Find(Element.Id))
+    {
+        Placeholder = *ExistingPointer;
+    }
+
+    if (Placeholder != nullptr)
+    {
+        Placeholder->SetActorLocationAndRotation(Box.CenterCm, Box.Rotation);
+        Placeholder->SetBoxSizeCm(Box.SizeCm);
+    }
+    else
+    {
+        Placeholder = AcquirePlaceholder(Box);
+        if (Placeholder == nullptr)
+        {
+            return;
+        }
+
+        ElementActorsById.Add(Element.Id, Placeholder);
+    }
+
+    FTransform MeshTransform;
+    UStaticMesh* CatalogMesh = MeshSubstitution.IsValid() ? MeshSubstitution->ResolveMesh(Element, Box.SizeCm, MeshTransform) : nullptr;
+    if (CatalogMesh != nullptr)
+    {
+        Placeholder->SetDisplayMesh(CatalogMesh, MeshTransform);
+    }
+
+    MarkRoomLodDirty();
+
+    UpdateElementLabel(Element, Box);
+}
+
+void ALayoutLensVisualizerActor::SpawnOrUpdateElementInstance(const FLayoutLensElement& Element, const FLayoutLensBox& Box)
+{
+    MarkRoomLodDirty();
+
+    const FTransform InstanceTransform = MakeElementInstanceTransform(Element, Box);
+
+    if (const int32* ExistingSlot = ElementInstanceById.Find(Element.Id))
+    {
+        ElementPool.Update(*ExistingSlot, InstanceTransform);
+        SetElementInstanceMetadata(*ExistingSlot, Element);
+        return;
+    }
+
+    TArray<int32> NewSlots;
+    ElementPool.Acquire({ InstanceTransform }, NewSlots);
+
+    if (NewSlots.Num() == 1)
+    {
+        SetElementInstanceMetadata(NewSlots[0], Element);
+    }
+}
+
+void ALayoutLensVisualizerActor::SetElementInstanceMetadata(int32 InstanceIndex, const FLayoutLensElement& Element)
+{
+    if (ElementMetadataByInstance.Num() <= InstanceIndex)
+    {
+        ElementMetadataByInstance.SetNum(InstanceIndex + 1);
+    }
+
+    FLayoutLensInstanceMetadata& Metadata = ElementMetadataByInstance[InstanceIndex];
+    Metadata.Id = Element.Id;
+    Metadata.Label = Element.Label;
+
+    // An element keeping its slot keeps its last severity, so a catalogue mesh arriving between analyses
+    // shows the right one; RefreshAnalysis rewrites it either way.
+    const int32* PreviousInstanceIndex = ElementInstanceById.Find(Element.Id);
+    const int32 SeverityDataIndex = InstanceIndex * ElementCustomDataFloatCount + SeverityCustomDataIndex;
+    const int32 Severity = PreviousInstanceIndex != nullptr && *PreviousInstanceIndex == InstanceIndex &&
+        ElementInstances->PerInstanceSMCustomData.IsValidIndex(SeverityDataIndex)
+        ? (int32)ElementInstances->PerInstanceSMCustomData[SeverityDataIndex]
+        : 0;
+
+    ElementInstanceById.Add(Element.Id, InstanceIndex);
+
+    // The transform change that got here already dirtied the render state.
+    WriteElementCustomData(InstanceIndex, Element, Severity);
+}
+
+void ALayoutLensVisualizerActor::WriteElementCustomData(int32 InstanceIndex, const FLayoutLensElement& Element, int32 Severity)
+{
+    if (!ElementInstances->IsValidInstance(InstanceIndex))
+    {
+        return;
+    }
+
+    const float PlacementValue =
+        FLayoutLensPlanGeometry::IsOnElement(Element) ? 1.0f :
+        FLayoutLensPlanGeometry::IsWallElement(Element) ? 2.0f : 0.0f;
+
+    const float FootprintKindValue = Element.FootprintKind.Equals(TEXT("poly"), ESearchCase::IgnoreCase) ? 1.0f : 0.0f;
+
+    const float CustomData[ElementCustomDataFloatCount] =
+    {
+        PlacementValue,
+        FootprintKindValue,
+        (float)Severity,
+        GetSelectionCustomData(Element.Id)
+    };
+
+    ElementInstances->SetCustomData(InstanceIndex, MakeArrayView(CustomData, ElementCustomDataFloatCount), false);
+
+    if (MeshSubstitution.IsValid())
+    {
+        MeshSubstitution->SetCustomData(Element.Id, MakeArrayView(CustomData, ElementCustomDataFloatCount));
+    }
+}
+
+float ALayoutLensVisualizerActor::GetSelectionCustomData(const FString& ElementId) const
+{
+    if (!SelectedElement.Id.IsEmpty() && SelectedElement.Id == ElementId)
+    {
+        return 2.0f;
+    }
+
+    return !HoveredElement.Id.IsEmpty() && HoveredElement.Id == ElementId ? 1.0f : 0.0f;
+}
+
+void ALayoutLensVisualizerActor::UpdateInstanceCustomData()
+{
+    if (ElementInstanceById.Num() == 0)
+    {
+        return;
+    }
+
+    TSet<FString> UnreachableIds;
+    if (WalkabilityField.IsValid())
+    {
+        UnreachableIds.Append(WalkabilityField->GetUnreachableElementIds());
+    }
+
+    for (const TPair<FString, int32>& Pair : ElementInstanceById)
+    {
+        if (const int32* ElementIndex = ElementIndexById.Find(Pair.Key))
+        {
+            const int32 Severity = CollectElementIssues(*ElementIndex, UnreachableIds.Contains(Pair.Key), nullptr);
+            WriteElementCustomData(Pair.Value, CurrentPlan->Elements[*ElementIndex], Severity);
+        }
+    }
+
+    // One upload of the custom data buffer for the whole plan.
+    ElementInstances->MarkRenderStateDirty();
+
+    if (MeshSubstitution.IsValid())
+    {
+        MeshSubstitution->MarkRenderStateDirty();
+    }
+}
+
+void ALayoutLensVisualizerActor::UpdateSelectionCustomData(const FString& ElementId)
+{
+    const int32* InstanceIndex = ElementInstanceById.Find(ElementId);
+    if (InstanceIndex != nullptr && ElementInstances->IsValidInstance(*InstanceIndex))
+    {
+        ElementInstances->SetCustomDataValue(*InstanceIndex, SelectionCustomDataIndex, GetSelectionCustomData(ElementId), true);
+    }
+
+    if (MeshSubstitution.IsValid())
+    {
+        MeshSubstitution->SetCustomDataValue(ElementId, SelectionCustomDataIndex, GetSelectionCustomData(ElementId));
+    }
+}
+
+void ALayoutLensVisualizerActor::UpdateElementLabel(const FLayoutLensElement& Element, const FLayoutLensBox& Box)
+{
+    if (LabelLayer.IsValid())
+    {
+        const FVector LabelLocation = Box.CenterCm + FVector(0.0f, 0.0f, Box.SizeCm.Z * 0.5f + 30.0f);
+        const FString LabelText = FString::Printf(TEXT("%s (%s)"), *Element.Label, *Element.Id);
+        LabelLayer->SetLabel(Element.Id, LabelLocation, LabelText);
+    }
+}
+
+FTransform ALayoutLensVisualizerActor::MakeElementInstanceTransform(const FLayoutLensElement& Element, const FLayoutLensBox& Box)
+{
+    if (MeshSubstitution.IsValid() && MeshSubstitution->SetInstance(Element, Box))
+    {
+        // The cube keeps its slot, since picking, custom data and metadata are all keyed by it.
+        return FTransform(FRotator::ZeroRotator, Box.CenterCm, FVector::ZeroVector);
+    }
+
+    return Box.ToCubeTransform();
+}
+
+void ALayoutLensVisualizerActor::InitializeMeshSubstitution()
+{
+    if (!MeshSubstitution.IsValid())
+    {
+        MeshSubstitution = MakeShared<FLayoutLensMeshSubstitution>();
+    }
+
+    TWeakObjectPtr<ALayoutLensVisualizerActor> WeakThis(this);
+
+    MeshSubstitution->Initialize(
+        MeshCatalog,
+        GenerateFurnitureMeshes ? FMath::Max(FurnitureMeshStepCm, 1.0f) : 0.0f,
+        [WeakThis](UStaticMesh* Mesh, bool bGenerated) -> UInstancedStaticMeshComponent*
+        {
+            ALayoutLensVisualizerActor* Visualizer = WeakThis.Get();
+            return Visualizer != nullptr ? Visualizer->CreateCatalogMeshInstances(Mesh, bGenerated) : nullptr;
+        },
+        [WeakThis](const FString& ElementId)
+        {
+            if (ALayoutLensVisualizerActor* Visualizer = WeakThis.Get())
+            {
+                Visualizer->HandleCatalogMeshReady(ElementId);
+            }
+        });
+
+    MeshSubstitution->SetVisibility(CurrentRoomLod == ELayoutLensRoomLod::Full);
+}
+
+UInstancedStaticMeshComponent* ALayoutLensVisualizerActor::CreateCatalogMeshInstances(UStaticMesh* Mesh, bool bGenerated)
+{
+    // Same setup as ElementInstances, so the element material conventions carry over to catalogue meshes.
+    UInstancedStaticMeshComponent* MeshInstances = NewObject<UInstancedStaticMeshComponent>(this, NAME_None, RF_Transient);
+    MeshInstances->SetupAttachment(Root);
+    MeshInstances->SetUsingAbsoluteScale(true);
+    SetFollowsActor(MeshInstances, UseActorTransform);
+    MeshInstances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    MeshInstances->NumCustomDataFloats = ElementCustomDataFloatCount;
+    MeshInstances->SetStaticMesh(Mesh);
+
+    // Generated furniture stands in for the boxes, so it is shaded like them.
+    if (bGenerated && ElementMaterial != nullptr)
+    {
+        MeshInstances->SetMaterial(0, ElementMaterial);
+    }
+
+    MeshInstances->RegisterComponent();
+
+    CatalogMeshInstances.Add(MeshInstances);
+    return MeshInstances;
+}
+
+void ALayoutLensVisualizerActor::HandleCatalogMeshReady(const FString& ElementId)
+{
+    if (const int32* ElementIndex = ElementIndexById.Find(ElementId))
+    {
+        SpawnOrUpdateElementActor(CurrentPlan->Elements[*ElementIndex]);
+    }
+}
+
+void ALayoutLensVisualizerActor::DestroyElementActor(const FString& ElementId)
+{
+    TObjectPtr<ALayoutLensPlaceholderActor> Placeholder;
+    if (ElementActorsById.RemoveAndCopyValue(ElementId, Placeholder))
+    {
+        RetirePlaceholder(Placeholder);
+    }
+
+    if (MassRepresentation.IsValid())
+    {
+        MassRepresentation->RemoveElement(ElementId);
+    }
+
+    if (MeshSubstitution.IsValid())
+    {
+        MeshSubstitution->RemoveElement(ElementId);
+    }
+
+    int32 InstanceIndex = INDEX_NONE;
+    if (ElementInstanceById.RemoveAndCopyValue(ElementId, InstanceIndex))
+    {
+        ElementMetadataByInstance[InstanceIndex] = FLayoutLensInstanceMetadata();
+
+        TArray<int32> ReleasedSlots = { InstanceIndex };
+        ElementPool.Release(ReleasedSlots);
+    }
+
+    if (LabelLayer.IsValid())
+    {
+        LabelLayer->RemoveLabel(ElementId);
+    }
+
+    MarkRoomLodDirty();
+}
+
+void ALayoutLensVisualizerActor::SpawnWallMeshes(const FLayoutLensRoomPlan& Plan)
+{
+    TArray<FLayoutLensBox> WallBoxes;
+    FLayoutLensPlanGeometry::BuildWallBoxes(Plan, WallThicknessCm, WallBoxes);
+
+    MarkRoomLodDirty();
+
+    if (Representation != ELayoutLensRepresentation::Actors || IsEditorPreview())
+    {
+        TArray<FTransform> WallTransforms;
+        WallTransforms.Reserve(WallBoxes.Num());
+
+        for (const FLayoutLensBox& WallBox : WallBoxes)
+        {
+            WallTransforms.Add(ToWorldBox(WallBox).ToCubeTransform());
+        }
+
+        WallPool.Acquire(WallTransforms, WallInstanceSlots);
+        return;
+    }
+
+    for (const FLayoutLensBox& PlanWallBox : WallBoxes)
+    {
+        ALayoutLensPlaceholderActor* WallActor = AcquirePlaceholder(ToWorldBox(PlanWallBox));
+        if (WallActor != nullptr)
+        {
+            SpawnedActors.Add(WallActor);
+        }
+    }
+}
+
+void ALayoutLensVisualizerActor::UpdateSlabs()
+{
+    const uint64 NewSlabMeshKey = FLayoutLensSlabMesh::ComputeSlabKey(*CurrentPlan, SpawnFloor, SpawnCeiling);
+
+    if (SlabMesh == nullptr || NewSlabMeshKey != SlabMeshKey)
+    {
+        const double StartSeconds = FPlatformTime::Seconds();
+
+        // A plan asset's triangulation comes from the DDC or its cooked package.
+        const TArray<int32>* BoundaryTriangles = PlanAsset != nullptr ? PlanAsset->FindBoundaryTriangles(CurrentPlan->Boundary) : nullptr;
+
+        SlabMesh = FLayoutLensSlabMesh::BuildSlabMesh(this, *CurrentPlan, SpawnFloor, SpawnCeiling, BoundaryTriangles);
+        SlabMeshKey = NewSlabMeshKey;
+
+        if (SlabMesh != nullptr)
+        {
+            UE_LOG(LogTemp, Log, TEXT("LayoutLens: Built floor and ceiling (%d boundary points, %s triangulation) in %.2f ms."),
+                CurrentPlan->Boundary.Num(), BoundaryTriangles != nullptr ? TEXT("cached") : TEXT("new"),
+                (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+        }
+    }
+
+    Slabs->SetWorldTransform(GetPlanToWorld());
+    Slabs->SetStaticMesh(SlabMesh);
+    Slabs->SetMaterial(0, FloorMaterial);
+    Slabs->SetMaterial(1, CeilingMaterial);
+}
+
+ALayoutLensPlaceholderActor* ALayoutLensVisualizerActor::AcquirePlaceholder(const FLayoutLensBox& Box)
+{
+    ALayoutLensPlaceholderActor* Placeholder = nullptr;
+
+    while (Placeholder == nullptr && RetiredPlaceholders.Num() > 0)
+    {
+        Placeholder = RetiredPlaceholders.Pop(EAllowShrinking::No);
+    }
+
+    if (Placeholder != nullptr)
+    {
+        Placeholder->SetActorLocationAndRotation(Box.CenterCm, Box.Rotation);
+        ColdPlaceholderCount = FMath::Min(ColdPlaceholderCount, RetiredPlaceholders.Num());
+    }
+    else
+    {
+        FActorSpawnParameters SpawnParams;
+        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        Placeholder = GetWorld()->SpawnActor<ALayoutLensPlaceholderActor>(Box.CenterCm, Box.Rotation, SpawnParams);
+        if (Placeholder == nullptr)
+        {
+            return nullptr;
+        }
+    }
+
+    Placeholder->SetBoxSizeCm(Box.SizeCm);
+    Placeholder->SetActorHiddenInGame(CurrentRoomLod != ELayoutLensRoomLod::Full);
+    return Placeholder;
+}
+
+void ALayoutLensVisualizerActor::RetirePlaceholder(AActor* Actor)
+{
+    if (Actor == nullptr)
+    {
+        return;
+    }
+
+    ALayoutLensPlaceholderActor* Placeholder = Cast<ALayoutLensPlaceholderActor>(Actor);
+    if (Placeholder == nullptr)
+    {
+        Actor->Destroy();
+        return;
+    }
+
+    Placeholder->SetActorHiddenInGame(true);
+    RetiredPlaceholders.Add(Placeholder);
+
+    // One timer for the whole pool; the next layout usually reclaims most of it before the drain gets there.
+    UWorld* World = GetWorld();
+    if (World != nullptr && !World->GetTimerManager().TimerExists(TeardownTimerHandle))
+    {
+        TeardownTimerHandle = World->GetTimerManager().SetTimerForNextTick(this, &ALayoutLensVisualizerActor::DrainRetiredPlaceholders);
+    }
+}
+
+void ALayoutLensVisualizerActor::DrainRetiredPlaceholders()
+{
+    const int32 KeepCount = KeepPreviousLayoutForUndo ? ColdPlaceholderCount : 0;
+    const double DeadlineSeconds = FPlatformTime::Seconds() + FMath::Max(TeardownBudgetMs, 0.1f) / 1000.0;
+
+    // At least one per frame so a tiny budget still finishes.
+    do
+    {
+        if (RetiredPlaceholders.Num() <= KeepCount)
+        {
+            break;
+        }
+
+        if (ALayoutLensPlaceholderActor* Placeholder = RetiredPlaceholders.Pop(EAllowShrinking::No))
+        {
+            Placeholder->Destroy();
+        }
+    }
+    while (FPlatformTime::Seconds() < DeadlineSeconds);
+
+    if (RetiredPlaceholders.Num() > KeepCount)
+    {
+        TeardownTimerHandle = GetWorldTimerManager().SetTimerForNextTick(this, &ALayoutLensVisualizerActor::DrainRetiredPlaceholders);
+    }
+    else
+    {
+        RetiredPlaceholders.Shrink();
+    }
+}
+
+void ALayoutLensVisualizerActor::RebuildPlacementIndex()
+{
+    if (!PlacementIndex.IsValid())
+    {
+        PlacementIndex = MakeShared<FLayoutLensPlacementIndex>();
+    }
+
+    PlacementIndex->Build(*CurrentPlan, WallThicknessCm);
+}
+
+FLayoutLensBox ALayoutLensVisualizerActor::MakeElementBox(const FLayoutLensElement& Element) const
+{
+    return PlacementIndex.IsValid() ? PlacementIndex->MakeElementBox(Element) : FLayoutLensPlanGeometry::MakeElementBox(Element);
+}
+
+void ALayoutLensVisualizerActor::UpdatePlacement(const TArray<FString>& ChangedIds, const TArray<FString>& RemovedIds)
+{
+    if (!PlacementIndex.IsValid())
+    {
+        RebuildPlacementIndex();
+        UpdateAttachedElements();
+        return;
+    }
+
+    TArray<FBox2D> ChangedSupportBounds;
+
+    for (const FString& RemovedId : RemovedIds)
+    {
+        PlacementIndex->RemoveElement(RemovedId, ChangedSupportBounds);
+    }
+
+    for (const FString& ChangedId : ChangedIds)
+    {
+        if (const int32* ElementIndex = ElementIndexById.Find(ChangedId))
+        {
+            PlacementIndex->SetElement(CurrentPlan->Elements[*ElementIndex], ChangedSupportBounds);
+        }
+    }
+
+    PlacementIndex->CompactSupports();
+    UpdateAttachedElements(ChangedSupportBounds, TSet<FString>(ChangedIds));
+}
+
+void ALayoutLensVisualizerActor::UpdateAttachedElements()
+{
+    for (const FLayoutLensElement& Element : CurrentPlan->Elements)
+    {
+        if (FLayoutLensPlanGeometry::IsOnElement(Element) || FLayoutLensPlanGeometry::IsWallElement(Element))
+        {
+            SpawnOrUpdateElementActor(Element);
+        }
+    }
+}
+
+void ALayoutLensVisualizerActor::UpdateWallElements()
+{
+    for (const FLayoutLensElement& Element : CurrentPlan->Elements)
+    {
+        if (FLayoutLensPlanGeometry::IsWallElement(Element))
+        {
+            SpawnOrUpdateElementActor(Element);
+        }
+    }
+}
+
+void ALayoutLensVisualizerActor::UpdateAttachedElements(const TArray<FBox2D>& ChangedSupportBounds, const TSet<FString>& SkippedIds)
+{
+    if (ChangedSupportBounds.Num() == 0)
+    {
+        return;
+    }
+
+    FLayoutLensAabbTree ChangedTree;
+    ChangedTree.Build(ChangedSupportBounds);
+
+    TArray<int32> Hits;
+    for (const FLayoutLensElement& Element : CurrentPlan->Elements)
+    {
+        if (!FLayoutLensPlanGeometry::IsOnElement(Element) || SkippedIds.Contains(Element.Id))
+        {
+            continue;
+        }
+
+        Hits.Reset();
+        ChangedTree.QueryPoint(FVector2D(Element.Transform.X, Element.Transform.Y), Hits);
+        if (Hits.Num() > 0)
+        {
+            SpawnOrUpdateElementActor(Element);
+        }
+    }
+}
+
+void ALayoutLensVisualizerActor::MarkRoomLodDirty()
+{
+    bRoomBoundsDirty = true;
+    bProxyMeshDirty = true;
+}
+
+void ALayoutLensVisualizerActor::UpdateRoomLod()
+{
+    const APlayerController* PlayerController = GetWorld() != nullptr ? GetWorld()->GetFirstPlayerController() : nullptr;
+    if (PlayerController == nullptr)
+    {
+        return;
+    }
+
+    if (bRoomBoundsDirty)
+    {
+        RoomBoundsCm = FLayoutLensPlanGeometry::ComputeBoundsCm(*CurrentPlan);
+        bRoomBoundsDirty = false;
+    }
+
+    if (!RoomBoundsCm.bIsValid)
+    {
+        return;
+    }
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+    const FVector PlanViewLocation = GetPlanToWorld().InverseTransformPosition(ViewLocation);
+    const float DistanceCm = FMath::Sqrt(RoomBoundsCm.ComputeSquaredDistanceToPoint(FVector2D(PlanViewLocation.X, PlanViewLocation.Y)));
+
+    const float ProxyDistanceCm = ProxyDistanceMeters * 100.0f;
+    const float OutlineDistanceCm = FMath::Max(OutlineOnlyDistanceMeters, ProxyDistanceMeters) * 100.0f;
+
+    const ELayoutLensRoomLod NewLod =
+        DistanceCm <= ProxyDistanceCm ? ELayoutLensRoomLod::Full :
+        DistanceCm <= OutlineDistanceCm ? ELayoutLensRoomLod::Proxy : ELayoutLensRoomLod::Outline;
+
+    if (NewLod == ELayoutLensRoomLod::Proxy && bProxyMeshDirty)
+    {
+        RebuildProxyMesh();
+    }
+
+    if (NewLod != CurrentRoomLod)
+    {
+        CurrentRoomLod = NewLod;
+        ApplyRoomLod();
+    }
+}
+
+void ALayoutLensVisualizerActor::ApplyRoomLod()
+{
+    const bool bDetailHidden = CurrentRoomLod != ELayoutLensRoomLod::Full;
+
+    for (const TPair<FString, TObjectPtr<ALayoutLensPlaceholderActor>>& Pair : ElementActorsById)
+    {
+        if (Pair.Value != nullptr)
+        {
+            Pair.Value->SetActorHiddenInGame(bDetailHidden);
+        }
+    }
+
+    for (AActor* Actor : SpawnedActors)
+    {
+        if (Actor != nullptr)
+        {
+            Actor->SetActorHiddenInGame(bDetailHidden);
+        }
+    }
+
+    // Mass elements run their own LOD and are never part of the room proxy.
+    if (!MassRepresentation.IsValid())
+    {
+        ElementInstances->SetVisibility(!bDetailHidden);
+    }
+
+    if (MeshSubstitution.IsValid())
+    {
+        MeshSubstitution->SetVisibility(!bDetailHidden);
+    }
+
+    WallInstances->SetVisibility(!bDetailHidden);
+    Slabs->SetVisibility(CurrentRoomLod != ELayoutLensRoomLod::Outline);
+    ProxyMesh->SetVisibility(CurrentRoomLod == ELayoutLensRoomLod::Proxy);
+
+    if (LabelLayer.IsValid())
+    {
+        LabelLayer->SetVisibility(bDetailHidden ? EVisibility::Collapsed : EVisibility::HitTestInvisible);
+    }
+}
+
+void ALayoutLensVisualizerActor::RebuildProxyMesh()
+{
+    TArray<FLayoutLensBox> ProxyBoxes;
+
+    if (SpawnWalls)
+    {
+        FLayoutLensPlanGeometry::BuildWallBoxes(*CurrentPlan, WallThicknessCm, ProxyBoxes);
+    }
+
+    if (!MassRepresentation.IsValid())
+    {
+        for (const FLayoutLensElement& Element : CurrentPlan->Elements)
+        {
+            if (FLayoutLensPlanGeometry::IsPlacedElement(Element))
+            {
+                ProxyBoxes.Add(MakeElementBox(Element));
+            }
+        }
+    }
+
+    for (FLayoutLensBox& ProxyBox : ProxyBoxes)
+    {
+        ProxyBox = ToComponentBox(*ProxyMesh, ToWorldBox(ProxyBox));
+    }
+
+    ProxyMesh->SetStaticMesh(FLayoutLensProxyMesh::BuildMergedBoxMesh(this, ProxyBoxes));
+    bProxyMeshDirty = false;
+}
+
+void ALayoutLensVisualizerActor::MarkAnalysisDirty()
+{
+    UWorld* World = GetWorld();
+    if (World == nullptr || !HasActorBegunPlay())
+    {
+        RefreshAnalysis();
+        return;
+    }
+
+    bAnalysisDirty = true;
+
+    // A burst of patches in one frame costs a single rasterization.
+    if (!World->GetTimerManager().TimerExists(AnalysisTimerHandle))
+    {
+        AnalysisTimerHandle = World->GetTimerManager().SetTimerForNextTick(this, &ALayoutLensVisualizerActor::RefreshAnalysisIfDirty);
+    }
+}
+
+void ALayoutLensVisualizerActor::RefreshAnalysisIfDirty()
+{
+    AnalysisTimerHandle.Invalidate();
+
+    if (bAnalysisDirty && bHasCurrentPlan)
+    {
+        RefreshAnalysis();
+    }
+    bAnalysisDirty = false;
+}
+
+void ALayoutLensVisualizerActor::RefreshAnalysis()
+{
+    bAnalysisDirty = false;
+    if (AnalysisTimerHandle.IsValid())
+    {
+        GetWorldTimerManager().ClearTimer(AnalysisTimerHandle);
+    }
+
+    if (!OccupancyGrid.IsValid())
+    {
+        OccupancyGrid = MakeShared<FLayoutLensOccupancyGrid>();
+        WalkabilityField = MakeShared<FLayoutLensWalkabilityField>();
+        DistanceField = MakeShared<FLayoutLensDistanceField>();
+    }
+
+    const double StartSeconds = FPlatformTime::Seconds();
+    OccupancyGrid->Build(*CurrentPlan, OccupancyCellSizeMeters);
+    const double OccupancyMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+    WalkabilityField->Build(*CurrentPlan, *OccupancyGrid, EgressClearanceMeters);
+    const double EgressMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0 - OccupancyMs;
+
+    DistanceField->Build(*CurrentPlan, *OccupancyGrid);
+    const double DistanceMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0 - OccupancyMs - EgressMs;
+
+    if (OccupancyGrid->IsValid())
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("LayoutLens: Occupancy %dx%d cells in %.2f ms, %.1f%% of the floor covered."),
+            OccupancyGrid->GetWidth(), OccupancyGrid->GetHeight(), OccupancyMs, OccupancyGrid->GetCoverage() * 100.0f);
+
+        UE_LOG(LogTemp, Verbose, TEXT("LayoutLens: Egress from %d doors in %.2f ms, farthest cell %.1f m."),
+            WalkabilityField->GetDoorCount(), EgressMs, WalkabilityField->GetMaxEgressDistanceMeters());
+
+        int32 TightestIndex = INDEX_NONE;
+        for (int32 ElementIndex = 0; ElementIndex < CurrentPlan->Elements.Num(); ElementIndex++)
+        {
+            const float Clearance = DistanceField->GetElementClearanceMeters(ElementIndex);
+            if (Clearance >= 0.0f && (TightestIndex == INDEX_NONE || Clearance < DistanceField->GetElementClearanceMeters(TightestIndex)))
+            {
+                TightestIndex = ElementIndex;
+            }
+        }
+
+        UE_LOG(LogTemp, Verbose, TEXT("LayoutLens: Distance field in %.2f ms, tightest element %s (%.2f m)."),
+            DistanceMs,
+            TightestIndex != INDEX_NONE ? *CurrentPlan->Elements[TightestIndex].Id : TEXT("none"),
+            TightestIndex != INDEX_NONE ? DistanceField->GetElementClearanceMeters(TightestIndex) : 0.0f);
     }
 
-    if (DrawOpenings)
+    for (const FString& ElementId : WalkabilityField->GetUnreachableElementIds())
     {
-        SpawnOpenings(Plan);
+        UE_LOG(LogTemp, Warning, TEXT("LayoutLens: Element %s cannot be reached from any door."), *ElementId);
     }
 
-    SpawnFloorElements(Plan);
+    RebuildPicker();
+    UpdateInstanceCustomData();
+    UpdateHeatmap();
+    UpdateNavObstacles();
+    UpdateWalkthroughCollision();
+}
 
-    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Loaded %d elements."), Plan.Elements.Num());
-    return true;
+float ALayoutLensVisualizerActor::GetOccupancyCoverage() const
+{
+    return OccupancyGrid.IsValid() ? OccupancyGrid->GetCoverage() : 0.0f;
 }
 
-bool ALayoutLensVisualizerActor::LoadJsonTextFromFile(FString& OutJsonText, FString& OutError) const
+TArray<FString> ALayoutLensVisualizerActor::GetUnreachableElementIds() const
 {
-    const FString AbsolutePath = GetAbsoluteFilePath(RoomPlanFilePath);
+    return WalkabilityField.IsValid() ? WalkabilityField->GetUnreachableElementIds() : TArray<FString>();
+}
 
-    if (!FPaths::FileExists(AbsolutePath))
+bool ALayoutLensVisualizerActor::GetElementClearance(const FString& ElementId, float& OutWallDistanceMeters, float& OutClearanceMeters) const
+{
+    const int32* ElementIndex = ElementIndexById.Find(ElementId);
+    if (ElementIndex == nullptr || bAnalysisDirty || !DistanceField.IsValid() || !DistanceField->IsValid())
     {
-        OutError = FString::Printf(TEXT("File not found: %s"), *AbsolutePath);
         return false;
     }
 
-    const bool bOk = FFileHelper::LoadFileToString(OutJsonText, *AbsolutePath);
-    if (!bOk)
+    OutWallDistanceMeters = DistanceField->GetElementWallDistanceMeters(*ElementIndex);
+    OutClearanceMeters = DistanceField->GetElementClearanceMeters(*ElementIndex);
+    return OutClearanceMeters >= 0.0f || OutWallDistanceMeters >= 0.0f;
+}
+
+void ALayoutLensVisualizerActor::RebuildPicker()
+{
+    if (!Picker.IsValid())
     {
-        OutError = FString::Printf(TEXT("LoadFileToString failed: %s"), *AbsolutePath);
-        return false;
+        Picker = MakeShared<FLayoutLensElementPicker>();
     }
 
-    return true;
-}
+    const double StartSeconds = FPlatformTime::Seconds();
 
-FString ALayoutLensVisualizerActor::GetAbsoluteFilePath(const FString& AnyPath) const
-{
-    FString CleanPath = AnyPath;
-    CleanPath.TrimStartAndEndInline();
+    TArray<FLayoutLensBox> Boxes;
+    TArray<int32> ElementIndices;
+    Boxes.Reserve(CurrentPlan->Elements.Num());
+    ElementIndices.Reserve(CurrentPlan->Elements.Num());
 
-    if (FPaths::IsRelative(CleanPath))
+    for (int32 ElementIndex = 0; ElementIndex < CurrentPlan->Elements.Num(); ElementIndex++)
     {
-        const FString FullPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), CleanPath);
-        return FullPath;
+        const FLayoutLensElement& Element = CurrentPlan->Elements[ElementIndex];
+        if (FLayoutLensPlanGeometry::IsPlacedElement(Element))
+        {
+            Boxes.Add(ToWorldBox(MakeElementBox(Element)));
+            ElementIndices.Add(ElementIndex);
+        }
     }
 
-    return CleanPath;
+    Picker->Build(Boxes, ElementIndices);
+
+    UE_LOG(LogTemp, Verbose, TEXT("LayoutLens: Picking tree over %d boxes in %.2f ms."),
+        Picker->GetBoxCount(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+
+    // Ids and issues may have changed under both; the hover timer picks again on its next tick.
+    HoveredElement = FLayoutLensPickResult();
+
+    const int32* SelectedIndex = ElementIndexById.Find(SelectedElement.Id);
+    SelectedElement = SelectedIndex != nullptr ? MakePickResult(*SelectedIndex, SelectedElement.HitLocation) : FLayoutLensPickResult();
 }
 
-bool ALayoutLensVisualizerActor::ParseRoomPlanJson(const FString& JsonText, FLayoutLensRoomPlan& OutPlan, FString& OutError) const
+void ALayoutLensVisualizerActor::UpdateNavObstacles()
 {
-    TSharedPtr<FJsonObject> RootObject;
+    if (!EnableNavigation || !bHasCurrentPlan)
+    {
+        ClearNavObstacles();
+        return;
+    }
+
+    const double StartSeconds = FPlatformTime::Seconds();
 
-    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonText);
-    const bool bOk = FJsonSerializer::Deserialize(Reader, RootObject);
-    if (!bOk || !RootObject.IsValid())
+    TArray<FLayoutLensBox> PlanBoxes;
+    if (SpawnWalls)
     {
-        OutError = TEXT("FJsonSerializer::Deserialize failed.");
-        return false;
+        FLayoutLensPlanGeometry::BuildWallBoxesWithDoorGaps(*CurrentPlan, WallThicknessCm, PlanBoxes);
     }
 
-    const TSharedPtr<FJsonObject>* SpaceObjectPointer = nullptr;
+    for (const FLayoutLensElement& Element : CurrentPlan->Elements)
+    {
+        if (FLayoutLensPlanGeometry::IsFloorElement(Element))
+        {
+            PlanBoxes.Add(MakeElementBox(Element));
+        }
+    }
 
-    if (!RootObject->TryGetObjectField(TEXT("space"), SpaceObjectPointer) ||
-        SpaceObjectPointer == nullptr || !SpaceObjectPointer->IsValid())
+    TArray<FLayoutLensBox> Boxes;
+    Boxes.Reserve(PlanBoxes.Num());
+    for (const FLayoutLensBox& PlanBox : PlanBoxes)
     {
-        OutError = TEXT("Missing 'space' object.");
-        return false;
+        Boxes.Add(ToWorldBox(PlanBox));
     }
 
-    const TSharedPtr<FJsonObject>& SpaceObject = *SpaceObjectPointer;
+    TMap<FIntPoint, TArray<FLayoutLensBox>> Cells;
+    ULayoutLensNavObstacleComponent::BucketObstacles(Boxes, NavObstacleCellMeters * 100.0f, Cells);
 
-    OutPlan.RoomHeightMeters = (float)SpaceObject->GetNumberField(TEXT("height"));
+    int32 ChangedCellCount = 0;
 
-    const TArray<TSharedPtr<FJsonValue>>* BoundaryArray = nullptr;
-    if (!SpaceObject->TryGetArrayField(TEXT("boundary"), BoundaryArray) || BoundaryArray == nullptr)
+    for (auto It = NavObstacleCells.CreateIterator(); It; ++It)
     {
-        OutError = TEXT("Missing 'space.boundary' array.");
-        return false;
+        if (!Cells.Contains(It.Key()))
+        {
+            if (It.Value() != nullptr)
+            {
+                It.Value()->DestroyComponent();
+            }
+            It.RemoveCurrent();
+            ChangedCellCount++;
+        }
     }
 
-    OutPlan.Boundary.Empty();
-    for (const TSharedPtr<FJsonValue>& PointValue : *BoundaryArray)
+    for (TPair<FIntPoint, TArray<FLayoutLensBox>>& Cell : Cells)
     {
-        const TSharedPtr<FJsonObject> PointObject = PointValue->AsObject();
-        if (!PointObject.IsValid())
+        TObjectPtr<ULayoutLensNavObstacleComponent>& Component = NavObstacleCells.FindOrAdd(Cell.Key);
+        if (Component == nullptr)
         {
-            continue;
+            Component = NewObject<ULayoutLensNavObstacleComponent>(this, NAME_None, RF_Transient);
+        }
+
+        const uint64 CellHash = FLayoutLensPlanGeometry::HashBoxes(Cell.Value);
+        if (Component->SetObstacles(MoveTemp(Cell.Value), CellHash))
+        {
+            ChangedCellCount++;
         }
 
-        FLayoutLensPoint2D Point;
-        Point.X = (float)PointObject->GetNumberField(TEXT("x"));
-        Point.Y = (float)PointObject->GetNumberField(TEXT("y"));
-        OutPlan.Boundary.Add(Point);
+        if (!Component->IsRegistered())
+        {
+            Component->RegisterComponent();
+        }
     }
 
-    const TArray<TSharedPtr<FJsonValue>>* OpeningsArray = nullptr;
-    if (SpaceObject->TryGetArrayField(TEXT("openings"), OpeningsArray) && OpeningsArray != nullptr)
+    if (ChangedCellCount > 0)
     {
-        OutPlan.Openings.Empty();
-        for (const TSharedPtr<FJsonValue>& OpeningValue : *OpeningsArray)
-        {
-            const TSharedPtr<FJsonObject> OpeningObject = OpeningValue->AsObject();
-            if (!OpeningObject.IsValid())
-            {
-                continue;
-            }
+        UE_LOG(LogTemp, Verbose, TEXT("LayoutLens: Navigation obstacles: %d boxes, %d of %d cells changed in %.2f ms."),
+            Boxes.Num(), ChangedCellCount, NavObstacleCells.Num(), (FPlatformTime::Seconds() - StartSeconds) * 1000.0);
+    }
+}
 
-            FLayoutLensOpening Opening;
-            Opening.Kind = OpeningObject->GetStringField(TEXT("kind"));
-            Opening.EdgeIndex = OpeningObject->GetIntegerField(TEXT("edge_index"));
-            Opening.Center01 = (float)OpeningObject->GetNumberField(TEXT("center"));
-            Opening.WidthMeters = (float)OpeningObject->GetNumberField(TEXT("width"));
-            OutPlan.Openings.Add(Opening);
+void ALayoutLensVisualizerActor::ClearNavObstacles()
+{
+    for (const TPair<FIntPoint, TObjectPtr<ULayoutLensNavObstacleComponent>>& Cell : NavObstacleCells)
+    {
+        if (Cell.Value != nullptr)
+        {
+            Cell.Value->DestroyComponent();
         }
     }
+    NavObstacleCells.Empty();
+}
 
-    const TArray<TSharedPtr<FJsonValue>>* ElementsArray = nullptr;
-    if (!RootObject->TryGetArrayField(TEXT("elements"), ElementsArray) || ElementsArray == nullptr)
+void ALayoutLensVisualizerActor::UpdateWalkthroughCollision()
+{
+    if (!EnableWalkthroughCollision || !bHasCurrentPlan)
     {
-        OutError = TEXT("Missing 'elements' array.");
-        return false;
+        ClearWalkthroughCollision();
+        return;
     }
 
-    OutPlan.Elements.Empty();
+    // The worker gets the room's space and the floor element boxes, which read the placement index and so are made here.
+    FLayoutLensRoomPlan SpacePlan;
+    SpacePlan.RoomHeightMeters = CurrentPlan->RoomHeightMeters;
+    SpacePlan.Boundary = CurrentPlan->Boundary;
+    SpacePlan.Openings = CurrentPlan->Openings;
 
-    for (const TSharedPtr<FJsonValue>& ElementValue : *ElementsArray)
+    TArray<FLayoutLensBox> ElementBoxes;
+    ElementBoxes.Reserve(CurrentPlan->Elements.Num());
+    for (const FLayoutLensElement& Element : CurrentPlan->Elements)
     {
-        const TSharedPtr<FJsonObject> ElementObject = ElementValue->AsObject();
-        if (!ElementObject.IsValid())
+        if (FLayoutLensPlanGeometry::IsFloorElement(Element))
         {
-            continue;
+            ElementBoxes.Add(MakeElementBox(Element));
         }
+    }
+
+    const uint32 Generation = ++WalkthroughCollisionGeneration;
+    const TWeakObjectPtr<ALayoutLensVisualizerActor> WeakThis(this);
+    const bool bWalls = SpawnWalls;
+    const float WallThickness = WallThicknessCm;
 
-        FLayoutLensElement Element;
-        Element.Id = ElementObject->GetStringField(TEXT("id"));
-        Element.Label = ElementObject->GetStringField(TEXT("label"));
-        Element.Placement = ElementObject->GetStringField(TEXT("placement"));
-        Element.HeightMeters = (float)ElementObject->GetNumberField(TEXT("height"));
+    Async(EAsyncExecution::ThreadPool, [WeakThis, Generation, bWalls, WallThickness, SpacePlan = MoveTemp(SpacePlan), ElementBoxes = MoveTemp(ElementBoxes)]()
+    {
+        const double StartSeconds = FPlatformTime::Seconds();
 
-        const TSharedPtr<FJsonObject>* TransformObjectPointer = nullptr;
-        if (ElementObject->TryGetObjectField(TEXT("transform"), TransformObjectPointer) &&
-            TransformObjectPointer != nullptr && TransformObjectPointer->IsValid())
+        TArray<FLayoutLensBox> Boxes;
+        if (bWalls)
         {
-            const TSharedPtr<FJsonObject>& TransformObject = *TransformObjectPointer;
-            Element.Transform.X = (float)TransformObject->GetNumberField(TEXT("x"));
-            Element.Transform.Y = (float)TransformObject->GetNumberField(TEXT("y"));
-            Element.Transform.YawDeg = (float)TransformObject->GetNumberField(TEXT("yaw_deg"));
+            FLayoutLensPlanGeometry::BuildWallBoxesWithDoorGaps(SpacePlan, WallThickness, Boxes);
         }
+        Boxes.Append(ElementBoxes);
 
-        const TSharedPtr<FJsonObject>* FootprintObjectPointer = nullptr;
-        if (ElementObject->TryGetObjectField(TEXT("footprint"), FootprintObjectPointer) &&
-            FootprintObjectPointer != nullptr && FootprintObjectPointer->IsValid())
-        {
-            const TSharedPtr<FJsonObject>& FootprintObject = *FootprintObjectPointer;
-            Element.FootprintKind = FootprintObject->GetStringField(TEXT("kind"));
+        const uint64 Key = FLayoutLensPlanGeometry::HashBoxes(Boxes);
 
-            if (Element.FootprintKind.Equals(TEXT("rect"), ESearchCase::IgnoreCase))
+        FKAggregateGeom Geometry;
+        ULayoutLensCollisionComponent::BuildAggregate(Boxes, Geometry);
+
+        const double BuildMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Generation, Key, BuildMs, Geometry = MoveTemp(Geometry)]() mutable
+        {
+            ALayoutLensVisualizerActor* Visualizer = WeakThis.Get();
+            if (Visualizer == nullptr || Generation != Visualizer->WalkthroughCollisionGeneration)
             {
-                Element.WidthMeters = (float)FootprintObject->GetNumberField(TEXT("width"));
-                Element.DepthMeters = (float)FootprintObject->GetNumberField(TEXT("depth"));
+                return;
             }
-            else if (Element.FootprintKind.Equals(TEXT("poly"), ESearchCase::IgnoreCase))
+
+            Visualizer->WalkthroughCollision->SetWorldTransform(Visualizer->GetPlanToWorld());
+
+            if (Key == Visualizer->WalkthroughCollisionKey)
             {
-                const TArray<TSharedPtr<FJsonValue>>* PointsArray = nullptr;
-                if (FootprintObject->TryGetArrayField(TEXT("points"), PointsArray) && PointsArray != nullptr)
-                {
-                    Element.PolygonPoints.Empty();
-
-                    for (const TSharedPtr<FJsonValue>& PolyPointValue : *PointsArray)
-                    {
-                        const TSharedPtr<FJsonObject> PolyPointObject = PolyPointValue->AsObject();
-                        if (!PolyPointObject.IsValid())
-                        {
-                            continue;
-                        }
-
-                        FLayoutLensPoint2D PolyPoint;
-                        PolyPoint.X = (float)PolyPointObject->GetNumberField(TEXT("x"));
-                        PolyPoint.Y = (float)PolyPointObject->GetNumberField(TEXT("y"));
-                        Element.PolygonPoints.Add(PolyPoint);
-                    }
-
-                    float MinX = 0.0f;
-                    float MaxX = 0.0f;
-                    float MinY = 0.0f;
-                    float MaxY = 0.0f;
-
-                    if (Element.PolygonPoints.Num() > 0)
-                    {
-                        MinX = Element.PolygonPoints[0].X;
-                        MaxX = Element.PolygonPoints[0].X;
-                        MinY = Element.PolygonPoints[0].Y;
-                        MaxY = Element.PolygonPoints[0].Y;
-
-                        for (const FLayoutLensPoint2D& P : Element.PolygonPoints)
-                        {
-                            MinX = FMath::Min(MinX, P.X);
-                            MaxX = FMath::Max(MaxX, P.X);
-                            MinY = FMath::Min(MinY, P.Y);
-                            MaxY = FMath::Max(MaxY, P.Y);
-                        }
-
-                        Element.WidthMeters = FMath::Max(MaxX - MinX, 0.01f);
-                        Element.DepthMeters = FMath::Max(MaxY - MinY, 0.01f);
-                    }
-                }
+                return;
             }
-        }
 
-        OutPlan.Elements.Add(Element);
-    }
+            const double SwapStartSeconds = FPlatformTime::Seconds();
+            Visualizer->WalkthroughCollision->SetAggregate(MoveTemp(Geometry));
+            Visualizer->WalkthroughCollisionKey = Key;
 
-    return true;
+            UE_LOG(LogTemp, Verbose, TEXT("LayoutLens: Walkthrough collision of %d boxes built in %.2f ms, physics state in %.2f ms."),
+                Visualizer->WalkthroughCollision->GetBoxCount(), BuildMs, (FPlatformTime::Seconds() - SwapStartSeconds) * 1000.0);
+        });
+    });
 }
 
-void ALayoutLensVisualizerActor::ClearSpawnedActors()
+void ALayoutLensVisualizerActor::ClearWalkthroughCollision()
 {
-    for (AActor* Actor : SpawnedActors)
-    {
-        if (Actor != nullptr)
-        {
-            Actor->Destroy();
-        }
-    }
-    SpawnedActors.Empty();
+    // Drops any build still on its way.
+    WalkthroughCollisionGeneration++;
+    WalkthroughCollisionKey = 0;
+    WalkthroughCollision->ClearAggregate();
 }
 
-void ALayoutLensVisualizerActor::SpawnRoomOutline(const FLayoutLensRoomPlan& Plan)
+bool ALayoutLensVisualizerActor::FindWalkthroughPath(const FVector2D& FromPlanMeters, const FVector2D& ToPlanMeters, TArray<FVector>& OutPathPoints) const
 {
-    const float Z = 5.0f;
-    const int32 Count = Plan.Boundary.Num();
-    if (Count < 2)
-    {
-        return;
-    }
+    OutPathPoints.Reset();
 
-    for (int32 Index = 0; Index < Count; Index++)
+    UWorld* World = GetWorld();
+    UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(World);
+    if (NavSys == nullptr)
     {
-        const int32 NextIndex = (Index + 1) % Count;
+        return false;
+    }
 
-        const FVector A = FVector(Plan.Boundary[Index].X * 100.0f, Plan.Boundary[Index].Y * 100.0f, Z);
-        const FVector B = FVector(Plan.Boundary[NextIndex].X * 100.0f, Plan.Boundary[NextIndex].Y * 100.0f, Z);
+    const FVector FromCm = ToWorldPoint(FVector(FromPlanMeters * 100.0, 0.0));
+    const FVector ToCm = ToWorldPoint(FVector(ToPlanMeters * 100.0, 0.0));
 
-        DrawDebugLine(GetWorld(), A, B, FColor::Cyan, true, 0.0f, 100, 4.0f);
+    const UNavigationPath* Path = NavSys->FindPathToLocationSynchronously(World, FromCm, ToCm);
+    if (Path == nullptr || !Path->IsValid() || Path->IsPartial())
+    {
+        return false;
     }
+
+    OutPathPoints = Path->PathPoints;
+    return true;
 }
 
-void ALayoutLensVisualizerActor::SpawnOpenings(const FLayoutLensRoomPlan& Plan)
+FLayoutLensPickResult ALayoutLensVisualizerActor::MakePickResult(int32 ElementIndex, const FVector& HitLocation) const
 {
-    const int32 PointCount = Plan.Boundary.Num();
-    if (PointCount < 2)
-    {
-        return;
-    }
+    const FLayoutLensElement& Element = CurrentPlan->Elements[ElementIndex];
 
-    const float RoomHeightCm = Plan.RoomHeightMeters * 100.0f;
-    const float WallOffsetCm = (WallThicknessCm * 0.5f) + 2.0f;
+    FLayoutLensPickResult Result;
+    Result.Id = Element.Id;
+    Result.Label = Element.Label;
+    Result.Placement = Element.Placement;
+    Result.SizeMeters = FVector(Element.WidthMeters, Element.DepthMeters, Element.HeightMeters);
+    Result.HitLocation = HitLocation;
 
-    for (const FLayoutLensOpening& Opening : Plan.Openings)
-    {
-        const int32 EdgeIndex = FMath::Clamp(Opening.EdgeIndex, 0, PointCount - 1);
-        const int32 NextIndex = (EdgeIndex + 1) % PointCount;
+    const bool bUnreachable = WalkabilityField.IsValid() && WalkabilityField->GetUnreachableElementIds().Contains(Element.Id);
+    CollectElementIssues(ElementIndex, bUnreachable, &Result.Issues);
 
-        const FVector EdgeA = FVector(Plan.Boundary[EdgeIndex].X * 100.0f, Plan.Boundary[EdgeIndex].Y * 100.0f, 0.0f);
-        const FVector EdgeB = FVector(Plan.Boundary[NextIndex].X * 100.0f, Plan.Boundary[NextIndex].Y * 100.0f, 0.0f);
+    return Result;
+}
 
-        FVector EdgeDelta = EdgeB - EdgeA;
-        EdgeDelta.Z = 0.0f;
+int32 ALayoutLensVisualizerActor::CollectElementIssues(int32 ElementIndex, bool bUnreachable, TArray<FString>* OutIssues) const
+{
+    int32 Severity = 0;
 
-        const float EdgeLengthCm = EdgeDelta.Size();
-        if (EdgeLengthCm < 1.0f)
+    if (bUnreachable)
+    {
+        Severity = 2;
+        if (OutIssues != nullptr)
         {
-            continue;
+            OutIssues->Add(TEXT("Not reachable from any door"));
         }
+    }
 
-        const FVector EdgeDirectionUnit = EdgeDelta / EdgeLengthCm;
-        const FVector WallNormalUnit = FVector(-EdgeDirectionUnit.Y, EdgeDirectionUnit.X, 0.0f).GetSafeNormal();
-
-        const float CenterDistanceCm = FMath::Clamp(Opening.Center01, 0.0f, 1.0f) * EdgeLengthCm;
-        const FVector CenterPoint = EdgeA + (EdgeDirectionUnit * CenterDistanceCm) + (WallNormalUnit * WallOffsetCm);
-
-        const float HalfWidthCm = (Opening.WidthMeters * 100.0f) * 0.5f;
-        const FVector A2D = CenterPoint - (EdgeDirectionUnit * HalfWidthCm);
-        const FVector B2D = CenterPoint + (EdgeDirectionUnit * HalfWidthCm);
-
-        const bool IsDoor = Opening.Kind.Equals(TEXT("door"), ESearchCase::IgnoreCase);
-        const bool IsWindow = Opening.Kind.Equals(TEXT("window"), ESearchCase::IgnoreCase);
+    if (bAnalysisDirty || !DistanceField.IsValid() || !DistanceField->IsValid())
+    {
+        return Severity;
+    }
 
-        float BottomZCm = 0.0f;
-        float TopZCm = 150.0f;
+    // Same limits the pipeline's GeometryService validates against, at the resolution of the analysis grid.
+    const FLayoutLensOverlapResolveSettings Limits;
 
-        if (IsDoor)
+    const float WallDistanceMeters = DistanceField->GetElementWallDistanceMeters(ElementIndex);
+    if (WallDistanceMeters >= 0.0f && WallDistanceMeters < Limits.BoundaryMarginMeters)
+    {
+        Severity = FMath::Max(Severity, WallDistanceMeters > 0.0f ? 1 : 2);
+        if (OutIssues != nullptr)
         {
-            BottomZCm = 0.0f;
-            TopZCm = FMath::Min(RoomHeightCm, 210.0f);
+            OutIssues->Add(FString::Printf(TEXT("Wall gap %.2f m (minimum %.2f m)"), WallDistanceMeters, Limits.BoundaryMarginMeters));
         }
-        else if (IsWindow)
-        {
-            const float SillZCm = 100.0f;
-            const float WindowHeightCm = 100.0f;
+    }
 
-            BottomZCm = FMath::Clamp(SillZCm, 0.0f, FMath::Max(RoomHeightCm - 20.0f, 0.0f));
-            TopZCm = FMath::Min(RoomHeightCm - 10.0f, BottomZCm + WindowHeightCm);
-        }
-        else
+    const float ClearanceMeters = DistanceField->GetElementClearanceMeters(ElementIndex);
+    if (ClearanceMeters >= 0.0f && ClearanceMeters < Limits.SeparationMarginMeters)
+    {
+        Severity = FMath::Max(Severity, ClearanceMeters > 0.0f ? 1 : 2);
+        if (OutIssues != nullptr)
         {
-            BottomZCm = 0.0f;
-            TopZCm = FMath::Min(RoomHeightCm, 150.0f);
+            OutIssues->Add(FString::Printf(TEXT("Clearance %.2f m (minimum %.2f m)"), ClearanceMeters, Limits.SeparationMarginMeters));
         }
+    }
 
-        const FVector ABottom = FVector(A2D.X, A2D.Y, BottomZCm);
-        const FVector BBottom = FVector(B2D.X, B2D.Y, BottomZCm);
-        const FVector ATop = FVector(A2D.X, A2D.Y, TopZCm);
-        const FVector BTop = FVector(B2D.X, B2D.Y, TopZCm);
+    return Severity;
+}
 
-        const FColor Color = IsDoor ? FColor::Green : (IsWindow ? FColor::Yellow : FColor::White);
+bool ALayoutLensVisualizerActor::PickElement(const FVector& RayOrigin, const FVector& RayDirection, FLayoutLensPickResult& OutResult) const
+{
+    // The tree still holds the indices from before the last patch until the refresh runs.
+    if (!Picker.IsValid() || bAnalysisDirty)
+    {
+        return false;
+    }
 
-        DrawDebugLine(GetWorld(), ABottom, BBottom, Color, true, 0.0f, 8, 10.0f);
-        DrawDebugLine(GetWorld(), ATop, BTop, Color, true, 0.0f, 8, 10.0f);
-        DrawDebugLine(GetWorld(), ABottom, ATop, Color, true, 0.0f, 8, 10.0f);
-        DrawDebugLine(GetWorld(), BBottom, BTop, Color, true, 0.0f, 8, 10.0f);
+    double HitDistanceCm = 0.0;
+    const int32 ElementIndex = Picker->RayCast(RayOrigin, RayDirection, PickMaxDistanceMeters * 100.0, HitDistanceCm);
+    if (!CurrentPlan->Elements.IsValidIndex(ElementIndex))
+    {
+        return false;
     }
+
+    OutResult = MakePickResult(ElementIndex, RayOrigin + RayDirection.GetSafeNormal() * HitDistanceCm);
+    return true;
 }
 
-void ALayoutLensVisualizerActor::SpawnFloorElements(const FLayoutLensRoomPlan& Plan)
+bool ALayoutLensVisualizerActor::PickElementUnderCursor(FLayoutLensPickResult& OutResult) const
 {
-    for (const FLayoutLensElement& Element : Plan.Elements)
+    const APlayerController* PlayerController = GetWorld() != nullptr ? GetWorld()->GetFirstPlayerController() : nullptr;
+
+    FVector RayOrigin;
+    FVector RayDirection;
+    if (PlayerController == nullptr || !PlayerController->DeprojectMousePositionToWorld(RayOrigin, RayDirection))
     {
-        if (!Element.Placement.Equals(TEXT("floor"), ESearchCase::IgnoreCase))
-        {
-            continue;
-        }
+        return false;
+    }
 
-        const float WidthCm = Element.WidthMeters * 100.0f;
-        const float DepthCm = Element.DepthMeters * 100.0f;
-        const float HeightCm = Element.HeightMeters * 100.0f;
+    return PickElement(RayOrigin, RayDirection, OutResult);
+}
 
-        const float Z = HeightCm * 0.5f;
-        const FVector Location = FVector(Element.Transform.X * 100.0f, Element.Transform.Y * 100.0f, Z);
-        const FRotator Rotation = FRotator(0.0f, Element.Transform.YawDeg, 0.0f);
+bool ALayoutLensVisualizerActor::GetHoveredElement(FLayoutLensPickResult& OutResult) const
+{
+    OutResult = HoveredElement;
+    return !HoveredElement.Id.IsEmpty();
+}
 
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+bool ALayoutLensVisualizerActor::GetSelectedElement(FLayoutLensPickResult& OutResult) const
+{
+    OutResult = SelectedElement;
+    return !SelectedElement.Id.IsEmpty();
+}
 
-        ALayoutLensPlaceholderActor* Placeholder = GetWorld()->SpawnActor<ALayoutLensPlaceholderActor>(Location, Rotation, SpawnParams);
-        if (Placeholder == nullptr)
-        {
-            continue;
-        }
+FString ALayoutLensVisualizerActor::GetPickSummary() const
+{
+    const auto Describe = [](const TCHAR* Prefix, const FLayoutLensPickResult& Result)
+    {
+        return FString::Printf(TEXT("%s: %s (%s) %.2f x %.2f x %.2f m%s%s"),
+            Prefix, *Result.Id, *Result.Label,
+            Result.SizeMeters.X, Result.SizeMeters.Y, Result.SizeMeters.Z,
+            Result.Issues.Num() > 0 ? TEXT(" - ") : TEXT(""),
+            *FString::Join(Result.Issues, TEXT(", ")));
+    };
+
+    TArray<FString> Lines;
+    if (!HoveredElement.Id.IsEmpty())
+    {
+        Lines.Add(Describe(TEXT("Hover"), HoveredElement));
+    }
+    if (!SelectedElement.Id.IsEmpty())
+    {
+        Lines.Add(Describe(TEXT("Selected"), SelectedElement));
+    }
 
-        Placeholder->SetBoxSizeCm(FVector(WidthCm, DepthCm, HeightCm));
+    return FString::Join(Lines, TEXT("\n"));
+}
 
-        if (SpawnLabels)
-        {
-            const FString LabelText = FString::Printf(TEXT("%s\n(%s)"), *Element.Label, *Element.Id);
-            Placeholder->SetLabelText(LabelText);
-        }
-        else
-        {
-            Placeholder->SetLabelText(TEXT(""));
-        }
+void ALayoutLensVisualizerActor::UpdateHoveredElement()
+{
+    FLayoutLensPickResult Result;
+    const FString PreviousId = HoveredElement.Id;
+    HoveredElement = PickElementUnderCursor(Result) ? MoveTemp(Result) : FLayoutLensPickResult();
 
-        SpawnedActors.Add(Placeholder);
+    if (HoveredElement.Id != PreviousId)
+    {
+        UpdateSelectionCustomData(PreviousId);
+        UpdateSelectionCustomData(HoveredElement.Id);
     }
 }
 
-void ALayoutLensVisualizerActor::SpawnWallMeshes(const FLayoutLensRoomPlan& Plan)
+void ALayoutLensVisualizerActor::UpdateHeatmap()
 {
-    const int32 PointCount = Plan.Boundary.Num();
-    if (PointCount < 2)
+    if (AnalysisOverlay == ELayoutLensAnalysisOverlay::None || !OccupancyGrid.IsValid() || !OccupancyGrid->IsValid())
     {
+        Heatmap->ClearCells();
         return;
     }
 
-    const float WallHeightCm = Plan.RoomHeightMeters * 100.0f;
-    const float WallZ = WallHeightCm * 0.5f;
+    const FColor FreeColor(40, 200, 90, 110);
+    const FColor OccupiedColor(220, 60, 50, 150);
+    const FColor NoClearanceColor(90, 90, 90, 110);
+    const FColor UnreachableColor(230, 40, 230, 150);
 
-    for (int32 Index = 0; Index < PointCount; Index++)
-    {
-        const int32 NextIndex = (Index + 1) % PointCount;
+    const int32 Width = OccupancyGrid->GetWidth();
+    const int32 Height = OccupancyGrid->GetHeight();
+    const float MaxEgressMeters = FMath::Max(WalkabilityField->GetMaxEgressDistanceMeters(), 0.01f);
+    const float MaxClearanceMeters = FMath::Max(DistanceField->GetMaxDistanceMeters(), 0.01f);
 
-        const FVector PointA = FVector(Plan.Boundary[Index].X * 100.0f, Plan.Boundary[Index].Y * 100.0f, WallZ);
-        const FVector PointB = FVector(Plan.Boundary[NextIndex].X * 100.0f, Plan.Boundary[NextIndex].Y * 100.0f, WallZ);
+    TArray<FColor> Colors;
+    Colors.SetNumZeroed(Width * Height);
 
-        const FVector Delta = PointB - PointA;
-        const float LengthCm = Delta.Size();
-        if (LengthCm < 1.0f)
+    for (int32 Y = 0; Y < Height; Y++)
+    {
+        for (int32 X = 0; X < Width; X++)
         {
-            continue;
-        }
-
-        const FVector Center = (PointA + PointB) * 0.5f;
-        const float YawDeg = FMath::RadiansToDegrees(FMath::Atan2(Delta.Y, Delta.X));
-        const FRotator Rotation = FRotator(0.0f, YawDeg, 0.0f);
+            FColor& Color = Colors[Y * Width + X];
 
-        FActorSpawnParameters SpawnParams;
-        SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+            if (!OccupancyGrid->IsInside(X, Y))
+            {
+                continue;
+            }
 
-        ALayoutLensPlaceholderActor* WallActor = GetWorld()->SpawnActor<ALayoutLensPlaceholderActor>(Center, Rotation, SpawnParams);
-        if (WallActor == nullptr)
-        {
-            continue;
+            if (OccupancyGrid->IsOccupied(X, Y))
+            {
+                Color = OccupiedColor;
+            }
+            else if (AnalysisOverlay == ELayoutLensAnalysisOverlay::Occupancy)
+            {
+                Color = FreeColor;
+            }
+            else if (AnalysisOverlay == ELayoutLensAnalysisOverlay::Clearance)
+            {
+                // Red against walls and elements through green to blue in the most open spot.
+                const float Normalized = DistanceField->GetSignedDistanceMeters(X, Y) / MaxClearanceMeters;
+                Color = FLinearColor::LerpUsingHSV(FLinearColor(1.0f, 0.1f, 0.05f), FLinearColor(0.1f, 0.3f, 1.0f), Normalized).ToFColor(true);
+                Color.A = 130;
+            }
+            else if (!WalkabilityField->IsWalkable(X, Y))
+            {
+                Color = NoClearanceColor;
+            }
+            else if (!WalkabilityField->IsReachable(X, Y))
+            {
+                Color = UnreachableColor;
+            }
+            else
+            {
+                // Green at the doors through yellow to orange at the farthest reachable cell.
+                const float Normalized = WalkabilityField->GetEgressDistanceMeters(X, Y) / MaxEgressMeters;
+                Color = FLinearColor::LerpUsingHSV(FLinearColor(0.1f, 0.8f, 0.2f), FLinearColor(1.0f, 0.45f, 0.0f), Normalized).ToFColor(true);
+                Color.A = 130;
+            }
         }
+    }
 
-        WallActor->SetBoxSizeCm(FVector(LengthCm, WallThicknessCm, WallHeightCm));
-        WallActor->SetLabelText(TEXT(""));
+    Heatmap->SetCells(
+        Width,
+        Height,
+        OccupancyGrid->GetOriginMeters() * 100.0f,
+        OccupancyGrid->GetCellSizeMeters() * 100.0f,
+        Colors,
+        GetPlanToWorld());
+}
 
-        SpawnedActors.Add(WallActor);
+void ALayoutLensVisualizerActor::UpdateMassLod()
+{
+    const APlayerController* PlayerController = GetWorld() != nullptr ? GetWorld()->GetFirstPlayerController() : nullptr;
+    if (!MassRepresentation.IsValid() || PlayerController == nullptr)
+    {
+        return;
     }
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+    MassRepresentation->UpdateLod(
+        ViewLocation,
+        MassFullDetailDistanceMeters * 100.0f,
+        MassCullDistanceMeters * 100.0f,
+        MassMaxLodChangesPerUpdate);
 }
 
 void ALayoutLensVisualizerActor::BindReloadHotkey()
@@ -518,10 +2929,43 @@ void ALayoutLensVisualizerActor::BindReloadHotkey()
     if (InputComponent != nullptr)
     {
         InputComponent->BindKey(EKeys::R, IE_Pressed, this, &ALayoutLensVisualizerActor::ReloadLayoutHotkey);
+
+        if (EnablePicking)
+        {
+            InputComponent->BindKey(EKeys::LeftMouseButton, IE_Pressed, this, &ALayoutLensVisualizerActor::SelectElementHotkey);
+        }
     }
 }
 
 void ALayoutLensVisualizerActor::ReloadLayoutHotkey()
 {
-    ReloadLayout();
-}
\ No newline at end of file
+    if (StreamRoomPlanFile)
+    {
+        BeginStreamingLayout();
+    }
+    else
+    {
+        ReloadLayout();
+    }
+}
+
+void ALayoutLensVisualizerActor::SelectElementHotkey()
+{
+    FLayoutLensPickResult Result;
+    const FString PreviousId = SelectedElement.Id;
+    const bool bPicked = PickElementUnderCursor(Result);
+    SelectedElement = bPicked ? MoveTemp(Result) : FLayoutLensPickResult();
+
+    UpdateSelectionCustomData(PreviousId);
+    UpdateSelectionCustomData(SelectedElement.Id);
+
+    if (!bPicked)
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("LayoutLens: Selected %s (%s), %.2f x %.2f x %.2f m, %s."),
+        *SelectedElement.Id, *SelectedElement.Label,
+        SelectedElement.SizeMeters.X, SelectedElement.SizeMeters.Y, SelectedElement.SizeMeters.Z,
+        SelectedElement.Issues.Num() > 0 ? *FString::Join(SelectedElement.Issues, TEXT(", ")) : TEXT("no issues"));
+}
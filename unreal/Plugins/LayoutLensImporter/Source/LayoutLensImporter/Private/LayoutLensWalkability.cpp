@@ -0,0 +1,378 @@
+#include "LayoutLensWalkability.h"
+
+#include "LayoutLensOccupancyGrid.h"
+#include "LayoutLensPlanGeometry.h"
+
+#include "Async/ParallelFor.h"
+
+namespace
+{
+    const int32 StraightStepCost = 2;
+    const int32 DiagonalStepCost = 3;
+
+    // Smaller buckets are relaxed on the calling thread; task overhead would dominate.
+    const int32 MinCellsPerChunk = 512;
+    const int32 MaxChunks = 64;
+
+    const int32 NeighbourOffsetX[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+    const int32 NeighbourOffsetY[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+}
+
+void FLayoutLensWalkabilityField::Reset()
+{
+    Width = 0;
+    Height = 0;
+    DoorCount = 0;
+    MaxDistance = 0;
+    Walkable.Empty();
+    Distance.Empty();
+    UnreachableElementIds.Empty();
+}
+
+void FLayoutLensWalkabilityField::Build(const FLayoutLensRoomPlan& Plan, const FLayoutLensOccupancyGrid& Grid, float ClearanceRadiusMeters)
+{
+    Reset();
+
+    if (!Grid.IsValid())
+    {
+        return;
+    }
+
+    Width = Grid.GetWidth();
+    Height = Grid.GetHeight();
+    CellSizeMeters = Grid.GetCellSizeMeters();
+
+    const float RadiusMeters = FMath::Max(ClearanceRadiusMeters, 0.0f);
+
+    BuildWalkableMask(Grid, RadiusMeters);
+
+    TArray<int32> Seeds;
+    SeedDoors(Plan, Grid, RadiusMeters, Seeds);
+    PropagateDistances(Seeds);
+
+    if (DoorCount > 0)
+    {
+        FindUnreachableElements(Plan, Grid, RadiusMeters);
+    }
+}
+
+void FLayoutLensWalkabilityField::BuildWalkableMask(const FLayoutLensOccupancyGrid& Grid, float ClearanceRadiusMeters)
+{
+    const float RadiusCells = ClearanceRadiusMeters / CellSizeMeters;
+    const float RadiusSquaredCells = FMath::Square(RadiusCells);
+    const int32 RadiusRows = FMath::FloorToInt(RadiusCells);
+    const int32 DistanceCap = RadiusRows + 1;
+
+    // Distance in cells to the nearest blocked cell of the same row, capped; the grid border counts as blocked.
+    TArray<int32> RowDistance;
+    RowDistance.SetNumUninitialized(Width * Height);
+
+    ParallelFor(Height, [&](int32 Y)
+    {
+        int32* Row = &RowDistance[Y * Width];
+
+        int32 Running = 0;
+        for (int32 X = 0; X < Width; X++)
+        {
+            Running = Grid.IsFree(X, Y) ? FMath::Min(Running + 1, DistanceCap) : 0;
+            Row[X] = Running;
+        }
+
+        Running = 0;
+        for (int32 X = Width - 1; X >= 0; X--)
+        {
+            Running = Row[X] == 0 ? 0 : FMath::Min(Running + 1, DistanceCap);
+            Row[X] = FMath::Min(Row[X], Running);
+        }
+    });
+
+    Walkable.SetNumZeroed(Width * Height);
+
+    ParallelFor(Height, [&](int32 Y)
+    {
+        for (int32 X = 0; X < Width; X++)
+        {
+            if (RowDistance[Y * Width + X] == 0)
+            {
+                continue;
+            }
+
+            bool bClear = true;
+            for (int32 OffsetY = -RadiusRows; OffsetY <= RadiusRows && bClear; OffsetY++)
+            {
+                const int32 OtherY = Y + OffsetY;
+                const int32 Horizontal = (OtherY >= 0 && OtherY < Height) ? RowDistance[OtherY * Width + X] : 0;
+
+                bClear = FMath::Square((float)Horizontal) + FMath::Square((float)OffsetY) > RadiusSquaredCells;
+            }
+
+            Walkable[Y * Width + X] = bClear ? 1 : 0;
+        }
+    });
+}
+
+void FLayoutLensWalkabilityField::SeedDoors(
+    const FLayoutLensRoomPlan& Plan,
+    const FLayoutLensOccupancyGrid& Grid,
+    float ClearanceRadiusMeters,
+    TArray<int32>& OutSeeds)
+{
+    const int32 PointCount = Plan.Boundary.Num();
+    if (PointCount < 2)
+    {
+        return;
+    }
+
+    // The clearance band along the wall is not walkable, so each door sample marches inward to the first walkable cell.
+    const int32 MaxInwardSteps = FMath::CeilToInt(ClearanceRadiusMeters / CellSizeMeters) + 2;
+
+    for (const FLayoutLensOpening& Opening : Plan.Openings)
+    {
+        if (!Opening.Kind.Equals(TEXT("door"), ESearchCase::IgnoreCase))
+        {
+            continue;
+        }
+
+        DoorCount++;
+
+        const int32 EdgeIndex = FMath::Clamp(Opening.EdgeIndex, 0, PointCount - 1);
+        const int32 NextIndex = (EdgeIndex + 1) % PointCount;
+
+        const FVector2D EdgeA(Plan.Boundary[EdgeIndex].X, Plan.Boundary[EdgeIndex].Y);
+        const FVector2D EdgeB(Plan.Boundary[NextIndex].X, Plan.Boundary[NextIndex].Y);
+
+        const float EdgeLength = FVector2D::Distance(EdgeA, EdgeB);
+        if (EdgeLength < 0.01f)
+        {
+            continue;
+        }
+
+        const FVector2D EdgeDirection = (EdgeB - EdgeA) / EdgeLength;
+        const FVector2D DoorCenter = EdgeA + EdgeDirection * (FMath::Clamp(Opening.Center01, 0.0f, 1.0f) * EdgeLength);
+
+        FVector2D InwardNormal(-EdgeDirection.Y, EdgeDirection.X);
+
+        int32 ProbeX = 0;
+        int32 ProbeY = 0;
+        if (!Grid.PointToCell(DoorCenter + InwardNormal * CellSizeMeters, ProbeX, ProbeY) || !Grid.IsInside(ProbeX, ProbeY))
+        {
+            InwardNormal = -InwardNormal;
+        }
+
+        const int32 SampleCount = FMath::Max(FMath::CeilToInt(Opening.WidthMeters / CellSizeMeters), 1);
+
+        for (int32 SampleIndex = 0; SampleIndex < SampleCount; SampleIndex++)
+        {
+            const float Along = ((SampleIndex + 0.5f) / SampleCount - 0.5f) * Opening.WidthMeters;
+            const FVector2D DoorPoint = DoorCenter + EdgeDirection * Along;
+
+            for (int32 Step = 0; Step < MaxInwardSteps; Step++)
+            {
+                int32 CellX = 0;
+                int32 CellY = 0;
+                if (!Grid.PointToCell(DoorPoint + InwardNormal * ((Step + 0.5f) * CellSizeMeters), CellX, CellY) ||
+                    Grid.IsOccupied(CellX, CellY))
+                {
+                    break;
+                }
+
+                if (Walkable[CellY * Width + CellX] != 0)
+                {
+                    OutSeeds.Add(CellY * Width + CellX);
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void FLayoutLensWalkabilityField::PropagateDistances(const TArray<int32>& Seeds)
+{
+    Distance.Init(MAX_int32, Width * Height);
+
+    // Relaxing bucket D only writes D + 2 or D + 3, so four rotating buckets are enough.
+    TArray<int32> Buckets[4];
+    int32 PendingCount = 0;
+
+    for (const int32 Seed : Seeds)
+    {
+        if (Distance[Seed] != 0)
+        {
+            Distance[Seed] = 0;
+            Buckets[0].Add(Seed);
+            PendingCount++;
+        }
+    }
+
+    TArray<TArray<int32>> StraightOut;
+    TArray<TArray<int32>> DiagonalOut;
+    StraightOut.SetNum(MaxChunks);
+    DiagonalOut.SetNum(MaxChunks);
+
+    int32 Current = 0;
+
+    while (PendingCount > 0)
+    {
+        TArray<int32>& Bucket = Buckets[Current & 3];
+        const int32 BucketCount = Bucket.Num();
+
+        const int32 ChunkCount = FMath::Clamp(BucketCount / MinCellsPerChunk, 1, MaxChunks);
+        const int32 CellsPerChunk = FMath::DivideAndRoundUp(BucketCount, ChunkCount);
+
+        ParallelFor(ChunkCount, [&](int32 ChunkIndex)
+        {
+            TArray<int32>& ChunkStraight = StraightOut[ChunkIndex];
+            TArray<int32>& ChunkDiagonal = DiagonalOut[ChunkIndex];
+            ChunkStraight.Reset();
+            ChunkDiagonal.Reset();
+
+            const int32 First = ChunkIndex * CellsPerChunk;
+            const int32 Last = FMath::Min(First + CellsPerChunk, BucketCount);
+
+            for (int32 EntryIndex = First; EntryIndex < Last; EntryIndex++)
+            {
+                const int32 Cell = Bucket[EntryIndex];
+                if (Distance[Cell] != Current)
+                {
+                    continue;
+                }
+
+                const int32 CellX = Cell % Width;
+                const int32 CellY = Cell / Width;
+
+                for (int32 Neighbour = 0; Neighbour < 8; Neighbour++)
+                {
+                    const int32 NeighbourX = CellX + NeighbourOffsetX[Neighbour];
+                    const int32 NeighbourY = CellY + NeighbourOffsetY[Neighbour];
+
+                    if (NeighbourX < 0 || NeighbourY < 0 || NeighbourX >= Width || NeighbourY >= Height)
+                    {
+                        continue;
+                    }
+
+                    const int32 NeighbourCell = NeighbourY * Width + NeighbourX;
+                    if (Walkable[NeighbourCell] == 0)
+                    {
+                        continue;
+                    }
+
+                    const bool bDiagonal = Neighbour >= 4;
+                    const int32 NewDistance = Current + (bDiagonal ? DiagonalStepCost : StraightStepCost);
+
+                    int32 OldDistance = FPlatformAtomics::AtomicRead(&Distance[NeighbourCell]);
+                    while (NewDistance < OldDistance)
+                    {
+                        const int32 SeenDistance = FPlatformAtomics::InterlockedCompareExchange(&Distance[NeighbourCell], NewDistance, OldDistance);
+                        if (SeenDistance == OldDistance)
+                        {
+                            (bDiagonal ? ChunkDiagonal : ChunkStraight).Add(NeighbourCell);
+                            break;
+                        }
+                        OldDistance = SeenDistance;
+                    }
+                }
+            }
+        }, ChunkCount == 1);
+
+        PendingCount -= BucketCount;
+        Bucket.Reset();
+
+        for (int32 ChunkIndex = 0; ChunkIndex < ChunkCount; ChunkIndex++)
+        {
+            Buckets[(Current + StraightStepCost) & 3].Append(StraightOut[ChunkIndex]);
+            Buckets[(Current + DiagonalStepCost) & 3].Append(DiagonalOut[ChunkIndex]);
+            PendingCount += StraightOut[ChunkIndex].Num() + DiagonalOut[ChunkIndex].Num();
+        }
+
+        Current++;
+    }
+
+    MaxDistance = 0;
+    for (const int32 CellDistance : Distance)
+    {
+        if (CellDistance != MAX_int32)
+        {
+            MaxDistance = FMath::Max(MaxDistance, CellDistance);
+        }
+    }
+}
+
+void FLayoutLensWalkabilityField::FindUnreachableElements(
+    const FLayoutLensRoomPlan& Plan,
+    const FLayoutLensOccupancyGrid& Grid,
+    float ClearanceRadiusMeters)
+{
+    // An element counts as reachable when a reached cell lies within its footprint bounds grown by the clearance.
+    const float ReachMeters = ClearanceRadiusMeters + CellSizeMeters * 1.5f;
+
+    TArray<uint8> Unreachable;
+    Unreachable.SetNumZeroed(Plan.Elements.Num());
+
+    ParallelFor(Plan.Elements.Num(), [&](int32 ElementIndex)
+    {
+        const FLayoutLensElement& Element = Plan.Elements[ElementIndex];
+        if (!FLayoutLensPlanGeometry::IsFloorElement(Element))
+        {
+            return;
+        }
+
+        TArray<FVector2D> Footprint;
+        FLayoutLensPlanGeometry::BuildElementFootprint(Element, Footprint);
+
+        FBox2D Bounds(Footprint);
+        Bounds = Bounds.ExpandBy(ReachMeters);
+
+        int32 MinX = 0;
+        int32 MinY = 0;
+        int32 MaxX = 0;
+        int32 MaxY = 0;
+        Grid.PointToCell(Bounds.Min, MinX, MinY);
+        Grid.PointToCell(Bounds.Max, MaxX, MaxY);
+
+        MinX = FMath::Clamp(MinX, 0, Width - 1);
+        MinY = FMath::Clamp(MinY, 0, Height - 1);
+        MaxX = FMath::Clamp(MaxX, 0, Width - 1);
+        MaxY = FMath::Clamp(MaxY, 0, Height - 1);
+
+        for (int32 Y = MinY; Y <= MaxY; Y++)
+        {
+            for (int32 X = MinX; X <= MaxX; X++)
+            {
+                if (Distance[Y * Width + X] != MAX_int32)
+                {
+                    return;
+                }
+            }
+        }
+
+        Unreachable[ElementIndex] = 1;
+    });
+
+    for (int32 ElementIndex = 0; ElementIndex < Plan.Elements.Num(); ElementIndex++)
+    {
+        if (Unreachable[ElementIndex] != 0)
+        {
+            UnreachableElementIds.Add(Plan.Elements[ElementIndex].Id);
+        }
+    }
+}
+
+bool FLayoutLensWalkabilityField::IsWalkable(int32 X, int32 Y) const
+{
+    return X >= 0 && Y >= 0 && X < Width && Y < Height && Walkable[Y * Width + X] != 0;
+}
+
+bool FLayoutLensWalkabilityField::IsReachable(int32 X, int32 Y) const
+{
+    return X >= 0 && Y >= 0 && X < Width && Y < Height && Distance[Y * Width + X] != MAX_int32;
+}
+
+float FLayoutLensWalkabilityField::GetEgressDistanceMeters(int32 X, int32 Y) const
+{
+    return IsReachable(X, Y) ? Distance[Y * Width + X] * CellSizeMeters / StraightStepCost : -1.0f;
+}
+
+float FLayoutLensWalkabilityField::GetMaxEgressDistanceMeters() const
+{
+    return MaxDistance * CellSizeMeters / StraightStepCost;
+}
@@ -0,0 +1,224 @@
+#include "SLayoutLensLabelLayer.h"
+
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "GameFramework/PlayerController.h"
+#include "Rendering/DrawElements.h"
+#include "SceneView.h"
+#include "Styling/CoreStyle.h"
+
+namespace
+{
+    const float DeclutterCellSize = 8.0f;
+    const FVector2D LabelPadding = FVector2D(4.0f, 2.0f);
+}
+
+void SLayoutLensLabelLayer::Construct(const FArguments& InArgs)
+{
+    World = InArgs._World;
+    MaxDistanceCm = InArgs._MaxDistanceCm;
+    FadeStartCm = FMath::Min(InArgs._FadeStartCm, MaxDistanceCm);
+    MaxVisibleLabels = InArgs._MaxVisibleLabels;
+
+    Font = FCoreStyle::GetDefaultFontStyle("Regular", 10);
+
+    SetVisibility(EVisibility::HitTestInvisible);
+}
+
+void SLayoutLensLabelLayer::SetLabel(const FString& Id, const FVector& WorldLocation, const FString& Text)
+{
+    int32 LabelIndex = INDEX_NONE;
+
+    if (const int32* ExistingIndex = LabelIndexById.Find(Id))
+    {
+        LabelIndex = *ExistingIndex;
+    }
+    else
+    {
+        LabelIndex = Labels.AddDefaulted();
+        Labels[LabelIndex].Id = Id;
+        LabelIndexById.Add(Id, LabelIndex);
+    }
+
+    FLabel& Label = Labels[LabelIndex];
+    Label.WorldLocation = WorldLocation;
+
+    if (Label.Text != Text || Label.SizeSlate.IsZero())
+    {
+        Label.Text = Text;
+
+        const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+        Label.SizeSlate = FontMeasure->Measure(Text, Font) + LabelPadding * 2.0f;
+    }
+}
+
+void SLayoutLensLabelLayer::RemoveLabel(const FString& Id)
+{
+    int32 LabelIndex = INDEX_NONE;
+    if (!LabelIndexById.RemoveAndCopyValue(Id, LabelIndex))
+    {
+        return;
+    }
+
+    Labels.RemoveAtSwap(LabelIndex);
+
+    if (Labels.IsValidIndex(LabelIndex))
+    {
+        LabelIndexById.Add(Labels[LabelIndex].Id, LabelIndex);
+    }
+}
+
+void SLayoutLensLabelLayer::ClearLabels()
+{
+    Labels.Empty();
+    LabelIndexById.Empty();
+}
+
+FVector2D SLayoutLensLabelLayer::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+    return FVector2D::ZeroVector;
+}
+
+int32 SLayoutLensLabelLayer::OnPaint(
+    const FPaintArgs& Args,
+    const FGeometry& AllottedGeometry,
+    const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements,
+    int32 LayerId,
+    const FWidgetStyle& InWidgetStyle,
+    bool bParentEnabled) const
+{
+    DrawnLabelCount = 0;
+
+    const UWorld* LabelWorld = World.Get();
+    const APlayerController* PlayerController = LabelWorld != nullptr ? LabelWorld->GetFirstPlayerController() : nullptr;
+    const ULocalPlayer* LocalPlayer = PlayerController != nullptr ? PlayerController->GetLocalPlayer() : nullptr;
+
+    if (Labels.Num() == 0 || LocalPlayer == nullptr || LocalPlayer->ViewportClient == nullptr)
+    {
+        return LayerId;
+    }
+
+    FSceneViewProjectionData ProjectionData;
+    if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+    {
+        return LayerId;
+    }
+
+    const FMatrix ViewProjectionMatrix = ProjectionData.ComputeViewProjectionMatrix();
+    const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+    const FVector ViewOrigin = ProjectionData.ViewOrigin;
+    const float MaxDistanceSquared = FMath::Square(MaxDistanceCm);
+
+    Candidates.Reset();
+
+    for (int32 LabelIndex = 0; LabelIndex < Labels.Num(); LabelIndex++)
+    {
+        const FLabel& Label = Labels[LabelIndex];
+
+        const float DistanceSquared = FVector::DistSquared(Label.WorldLocation, ViewOrigin);
+        if (DistanceSquared > MaxDistanceSquared)
+        {
+            continue;
+        }
+
+        FVector2D ScreenPixel;
+        if (!FSceneView::ProjectWorldToScreen(Label.WorldLocation, ViewRect, ViewProjectionMatrix, ScreenPixel))
+        {
+            continue;
+        }
+
+        FCandidate& Candidate = Candidates.AddDefaulted_GetRef();
+        Candidate.LabelIndex = LabelIndex;
+        Candidate.DistanceSquared = DistanceSquared;
+        Candidate.ScreenPixel = ScreenPixel;
+    }
+
+    Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistanceSquared < B.DistanceSquared; });
+
+    const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
+    const int32 CellsX = FMath::Max(1, FMath::CeilToInt(LocalSize.X / DeclutterCellSize));
+    const int32 CellsY = FMath::Max(1, FMath::CeilToInt(LocalSize.Y / DeclutterCellSize));
+    OccupiedCells.Init(false, CellsX * CellsY);
+
+    const float PixelToLocal = AllottedGeometry.Scale > 0.0f ? 1.0f / AllottedGeometry.Scale : 1.0f;
+    const FSlateBrush* BackgroundBrush = FCoreStyle::Get().GetBrush("WhiteBrush");
+
+    for (const FCandidate& Candidate : Candidates)
+    {
+        if (DrawnLabelCount >= MaxVisibleLabels)
+        {
+            break;
+        }
+
+        const FLabel& Label = Labels[Candidate.LabelIndex];
+
+        const float DistanceCm = FMath::Sqrt(Candidate.DistanceSquared);
+        const float Opacity = MaxDistanceCm > FadeStartCm
+            ? FMath::Clamp(1.0f - (DistanceCm - FadeStartCm) / (MaxDistanceCm - FadeStartCm), 0.0f, 1.0f)
+            : 1.0f;
+
+        if (Opacity <= 0.0f)
+        {
+            continue;
+        }
+
+        const FVector2D Center = (Candidate.ScreenPixel - FVector2D(ViewRect.Min)) * PixelToLocal;
+        const FVector2D TopLeft = Center - Label.SizeSlate * 0.5f;
+
+        const int32 MinCellX = FMath::Clamp(FMath::FloorToInt(TopLeft.X / DeclutterCellSize), 0, CellsX - 1);
+        const int32 MinCellY = FMath::Clamp(FMath::FloorToInt(TopLeft.Y / DeclutterCellSize), 0, CellsY - 1);
+        const int32 MaxCellX = FMath::Clamp(FMath::FloorToInt((TopLeft.X + Label.SizeSlate.X) / DeclutterCellSize), 0, CellsX - 1);
+        const int32 MaxCellY = FMath::Clamp(FMath::FloorToInt((TopLeft.Y + Label.SizeSlate.Y) / DeclutterCellSize), 0, CellsY - 1);
+
+        bool bOverlaps = false;
+        for (int32 CellY = MinCellY; CellY <= MaxCellY && !bOverlaps; CellY++)
+        {
+            for (int32 CellX = MinCellX; CellX <= MaxCellX; CellX++)
+            {
+                if (OccupiedCells[CellY * CellsX + CellX])
+                {
+                    bOverlaps = true;
+                    break;
+                }
+            }
+        }
+
+        if (bOverlaps)
+        {
+            continue;
+        }
+
+        for (int32 CellY = MinCellY; CellY <= MaxCellY; CellY++)
+        {
+            for (int32 CellX = MinCellX; CellX <= MaxCellX; CellX++)
+            {
+                OccupiedCells[CellY * CellsX + CellX] = true;
+            }
+        }
+
+        FSlateDrawElement::MakeBox(
+            OutDrawElements,
+            LayerId,
+            AllottedGeometry.ToPaintGeometry(Label.SizeSlate, FSlateLayoutTransform(TopLeft)),
+            BackgroundBrush,
+            ESlateDrawEffect::None,
+            FLinearColor(0.0f, 0.0f, 0.0f, 0.55f * Opacity));
+
+        FSlateDrawElement::MakeText(
+            OutDrawElements,
+            LayerId + 1,
+            AllottedGeometry.ToPaintGeometry(Label.SizeSlate - LabelPadding * 2.0f, FSlateLayoutTransform(TopLeft + LabelPadding)),
+            Label.Text,
+            Font,
+            ESlateDrawEffect::None,
+            FLinearColor(1.0f, 1.0f, 1.0f, Opacity));
+
+        DrawnLabelCount++;
+    }
+
+    return LayerId + 1;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Fonts/SlateFontInfo.h"
+#include "Widgets/SLeafWidget.h"
+
+/*
+ * One viewport-wide widget that draws every element label. Labels are projected with a single
+ * view-projection matrix per paint, faded out between FadeStartCm and MaxDistanceCm, and decluttered
+ * nearest-first against a coarse screen occupancy grid so overlapping labels are skipped instead of
+ * drawn on top of each other.
+ */
+class SLayoutLensLabelLayer : public SLeafWidget
+{
+public:
+    SLATE_BEGIN_ARGS(SLayoutLensLabelLayer)
+        : _FadeStartCm(1500.0f)
+        , _MaxDistanceCm(2500.0f)
+        , _MaxVisibleLabels(200)
+        {}
+        SLATE_ARGUMENT(TWeakObjectPtr<UWorld>, World)
+        SLATE_ARGUMENT(float, FadeStartCm)
+        SLATE_ARGUMENT(float, MaxDistanceCm)
+        SLATE_ARGUMENT(int32, MaxVisibleLabels)
+    SLATE_END_ARGS()
+
+    void Construct(const FArguments& InArgs);
+
+    void SetLabel(const FString& Id, const FVector& WorldLocation, const FString& Text);
+    void RemoveLabel(const FString& Id);
+    void ClearLabels();
+
+    int32 GetLabelCount() const { return Labels.Num(); }
+    int32 GetDrawnLabelCount() const { return DrawnLabelCount; }
+
+    virtual int32 OnPaint(
+        const FPaintArgs& Args,
+        const FGeometry& AllottedGeometry,
+        const FSlateRect& MyCullingRect,
+        FSlateWindowElementList& OutDrawElements,
+        int32 LayerId,
+        const FWidgetStyle& InWidgetStyle,
+        bool bParentEnabled) const override;
+
+    virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+    struct FLabel
+    {
+        FString Id;
+        FString Text;
+        FVector WorldLocation = FVector::ZeroVector;
+        FVector2D SizeSlate = FVector2D::ZeroVector;
+    };
+
+    struct FCandidate
+    {
+        int32 LabelIndex = INDEX_NONE;
+        float DistanceSquared = 0.0f;
+        FVector2D ScreenPixel = FVector2D::ZeroVector;
+    };
+
+private:
+    TWeakObjectPtr<UWorld> World;
+    float FadeStartCm = 1500.0f;
+    float MaxDistanceCm = 2500.0f;
+    int32 MaxVisibleLabels = 200;
+
+    FSlateFontInfo Font;
+
+    TArray<FLabel> Labels;
+    TMap<FString, int32> LabelIndexById;
+
+    mutable TArray<FCandidate> Candidates;
+    mutable TBitArray<> OccupiedCells;
+    mutable int32 DrawnLabelCount = 0;
+};
@@ -2,16 +2,122 @@
 
 
 #include "SSLayoutLensOverlayWidget.h"
+#include "LayoutLensRoomPlanCache.h"
+#include "LayoutLensVisualizerActor.h"
 #include "SlateOptMacros.h"
+#include "Styling/CoreStyle.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SEditableTextBox.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
 
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 void SLayoutLensOverlayWidget::Construct(const FArguments& InArgs)
 {
-	/*
+	VisualizerActor = InArgs._VisualizerActor;
+
+	if (VisualizerActor.IsValid())
+	{
+		CurrentPathText = FText::FromString(VisualizerActor->GetRoomPlanFilePath());
+	}
+
 	ChildSlot
+	.HAlign(HAlign_Left)
+	.VAlign(VAlign_Top)
+	.Padding(16.0f)
 	[
-		// Populate the widget
+		SNew(SBorder)
+		.BorderImage(FCoreStyle::Get().GetBrush("ToolPanel.GroupBorder"))
+		.Padding(8.0f)
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.0f)
+				[
+					SNew(SEditableTextBox)
+					.Text(CurrentPathText)
+					.MinDesiredWidth(360.0f)
+					.OnTextChanged(this, &SLayoutLensOverlayWidget::OnPathTextChanged)
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(4.0f, 0.0f, 0.0f, 0.0f)
+				[
+					SNew(SButton)
+					.Text(FText::FromString(TEXT("Reload")))
+					.OnClicked(this, &SLayoutLensOverlayWidget::OnReloadClicked)
+				]
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+			[
+				SAssignNew(StatusText, STextBlock)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+			[
+				SNew(STextBlock)
+				.Text(this, &SLayoutLensOverlayWidget::GetParseCacheText)
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(0.0f, 4.0f, 0.0f, 0.0f)
+			[
+				SNew(STextBlock)
+				.Text(this, &SLayoutLensOverlayWidget::GetPickText)
+			]
+		]
 	];
-	*/
 }
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
+
+FReply SLayoutLensOverlayWidget::OnReloadClicked()
+{
+	ALayoutLensVisualizerActor* Visualizer = VisualizerActor.Get();
+	if (Visualizer == nullptr)
+	{
+		return FReply::Handled();
+	}
+
+	Visualizer->SetRoomPlanFilePath(CurrentPathText.ToString());
+	const bool bLoaded = Visualizer->ReloadLayout();
+
+	if (StatusText.IsValid())
+	{
+		StatusText->SetText(FText::FromString(bLoaded ? TEXT("Loaded.") : TEXT("Load failed, see Output Log.")));
+	}
+
+	return FReply::Handled();
+}
+
+void SLayoutLensOverlayWidget::OnPathTextChanged(const FText& NewText)
+{
+	CurrentPathText = NewText;
+}
+
+FText SLayoutLensOverlayWidget::GetParseCacheText() const
+{
+	const FLayoutLensRoomPlanCacheStats Stats = FLayoutLensRoomPlanCache::Get().GetStats();
+
+	return FText::FromString(FString::Printf(
+		TEXT("Parse cache: %.0f%% hit (%lld/%lld), %d plans, %.1f / %.0f MB"),
+		Stats.GetHitRate() * 100.0f,
+		Stats.Hits,
+		Stats.Hits + Stats.Misses,
+		Stats.EntryCount,
+		Stats.UsedBytes / (1024.0 * 1024.0),
+		Stats.CapacityBytes / (1024.0 * 1024.0)));
+}
+
+FText SLayoutLensOverlayWidget::GetPickText() const
+{
+	const ALayoutLensVisualizerActor* Visualizer = VisualizerActor.Get();
+	return Visualizer != nullptr ? FText::FromString(Visualizer->GetPickSummary()) : FText::GetEmpty();
+}
@@ -17,6 +17,8 @@ public:
 private:
     FReply OnReloadClicked();
     void OnPathTextChanged(const FText& NewText);
+    FText GetParseCacheText() const;
+    FText GetPickText() const;
 
     TWeakObjectPtr<ALayoutLensVisualizerActor> VisualizerActor;
     FText CurrentPathText;
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "LayoutLensBuildingPlan.h"
+#include "LayoutLensVisualizerActor.h"
+#include "LayoutLensBuildingActor.generated.h"
+
+/*
+ * Places every room of a building file as its own ALayoutLensVisualizerActor.
+ *
+ * BuildRoomActors (editor) saves one spatially loaded room actor per room into the level; in a World Partition
+ * map they land in the streaming cells covering each room, so only nearby rooms are loaded and built.
+ * Without built room actors (or outside World Partition) the building spawns and destroys room actors itself
+ * by distance to the viewer at runtime.
+ */
+UCLASS()
+class LAYOUTLENSIMPORTER_API ALayoutLensBuildingActor : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    ALayoutLensBuildingActor();
+
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    UFUNCTION(CallInEditor, Category = "LayoutLens")
+    void BuildRoomActors();
+
+    UFUNCTION(CallInEditor, Category = "LayoutLens")
+    void ClearRoomActors();
+
+    UFUNCTION(BlueprintCallable)
+    bool LoadBuildingPlan();
+
+    int32 GetRoomCount() const;
+    int32 GetLoadedRoomCount() const;
+
+private:
+    // Rooms the building file gives no bounds for are measured from their plans on the thread pool; until then
+    // they stream as a point at their origin.
+    void MeasureRoomBounds();
+    void OnRoomBoundsMeasured(uint32 MeasureGeneration, TArray<int32> RoomIndices, TArray<FBox2D> LocalBoundsCm);
+
+    void UpdateStreaming();
+    void SpawnRuntimeRoom(int32 RoomIndex);
+    void DestroyRuntimeRoom(int32 RoomIndex);
+    void DestroyRuntimeRooms();
+
+    FTransform GetRoomTransform(const FLayoutLensBuildingRoom& Room) const;
+    float GetDistanceToRoomCm(const FLayoutLensBuildingRoom& Room, const FVector& ViewerLocation) const;
+    bool GetViewerLocation(FVector& OutLocation) const;
+
+    FString GetAbsoluteFilePath(const FString& AnyPath) const;
+
+private:
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    FString BuildingFilePath;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    ELayoutLensRepresentation RoomRepresentation = ELayoutLensRepresentation::Instanced;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Streaming", meta = (ClampMin = "0.0"))
+    float StreamInDistanceMeters = 40.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Streaming", meta = (ClampMin = "0.0"))
+    float StreamOutDistanceMeters = 60.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Streaming", meta = (ClampMin = "0.05"))
+    float StreamUpdateIntervalSeconds = 0.25f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Streaming", meta = (ClampMin = "1"))
+    int32 MaxRoomSpawnsPerUpdate = 2;
+
+    UPROPERTY()
+    TObjectPtr<USceneComponent> Root;
+
+    // Room actors saved into the level by BuildRoomActors. Soft, so World Partition can keep them unloaded.
+    UPROPERTY()
+    TArray<TSoftObjectPtr<ALayoutLensVisualizerActor>> BuiltRoomActors;
+
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<ALayoutLensVisualizerActor>> RuntimeRoomActors;
+
+    FLayoutLensBuildingPlan BuildingPlan;
+    uint32 Generation = 0;
+    FTimerHandle StreamingTimerHandle;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * A building is a list of room plans with placement offsets:
+ *
+ * {
+ *   "rooms": [
+ *     {
+ *       "name": "101",
+ *       "path": "rooms/101/room_plan.json",                      // relative to the building file
+ *       "offset": { "x": 12.0, "y": 4.5 },                        // metres
+ *       "yaw_deg": 90.0,                                          // optional
+ *       "bounds": { "min": { "x": 0, "y": 0 }, "max": { "x": 5, "y": 4 } }  // optional, room-local metres
+ *     }
+ *   ]
+ * }
+ *
+ * Bounds let the building decide which rooms are near the viewer without opening their plans. Rooms that
+ * omit them are parsed once when the building loads and take the bounds of their plan.
+ */
+struct FLayoutLensBuildingRoom
+{
+    FString Name;
+    FString FilePath;
+    FVector2D OffsetMeters = FVector2D::ZeroVector;
+    float YawDegrees = 0.0f;
+    FBox2D LocalBoundsMeters = FBox2D(ForceInit);
+
+    FTransform GetPlacementTransform() const;
+};
+
+struct FLayoutLensBuildingPlan
+{
+    TArray<FLayoutLensBuildingRoom> Rooms;
+};
+
+struct FLayoutLensBuildingPlanJson
+{
+    static bool ParseBuildingPlan(const FString& JsonText, const FString& BaseDirectory, FLayoutLensBuildingPlan& OutPlan, FString& OutError);
+};
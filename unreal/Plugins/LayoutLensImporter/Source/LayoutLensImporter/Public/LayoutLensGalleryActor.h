@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "LayoutLensInstancePool.h"
+#include "LayoutLensGalleryActor.generated.h"
+
+struct FLayoutLensGalleryRoom
+{
+    FString FilePath;
+    FBox2D LocalBoundsCm = FBox2D(ForceInit);
+    FVector2D OffsetCm = FVector2D::ZeroVector;
+
+    bool bLoaded = false;
+    bool bLoading = false;
+
+    TArray<int32> ElementSlots;
+    TArray<int32> WallSlots;
+};
+
+UCLASS()
+class LAYOUTLENSIMPORTER_API ALayoutLensGalleryActor : public AActor
+{
+    GENERATED_BODY()
+
+public:
+    ALayoutLensGalleryActor();
+
+    virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+    UFUNCTION(BlueprintCallable)
+    void ScanOutputDirectory();
+
+    int32 GetRoomCount() const;
+    int32 GetLoadedRoomCount() const;
+
+private:
+    void OnScanComplete(uint32 ScanGeneration, TArray<FString> FilePaths, TArray<FBox2D> LocalBoundsCm);
+    void LayoutGrid();
+
+    void UpdateStreaming();
+    void RequestRoomLoad(int32 RoomIndex);
+    // A failed load leaves the room unloaded, so the next streaming update can request it again.
+    void OnRoomLoaded(uint32 ScanGeneration, int32 RoomIndex, bool bSucceeded, const FString& ErrorText, TArray<FTransform> ElementTransforms, TArray<FTransform> WallTransforms);
+    void UnloadRoom(int32 RoomIndex);
+    void ClearRooms();
+
+    bool GetViewerLocation(FVector& OutLocation) const;
+    float GetDistanceToRoomCm(const FLayoutLensGalleryRoom& Room, const FVector& ViewerLocation) const;
+
+    FString GetAbsoluteDirectoryPath() const;
+
+private:
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    FString OutputDirectoryPath;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    FString RoomPlanFileName;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    bool AutoScanOnBeginPlay = true;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens", meta = (ClampMin = "0"))
+    int32 GridColumns = 0;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens", meta = (ClampMin = "0.0"))
+    float CellPaddingMeters = 2.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    float WallThicknessCm = 10.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Streaming", meta = (ClampMin = "0.0"))
+    float StreamInDistanceMeters = 60.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Streaming", meta = (ClampMin = "0.0"))
+    float StreamOutDistanceMeters = 80.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Streaming", meta = (ClampMin = "0.05"))
+    float StreamUpdateIntervalSeconds = 0.25f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Streaming", meta = (ClampMin = "1"))
+    int32 MaxConcurrentLoads = 4;
+
+    UPROPERTY()
+    TObjectPtr<USceneComponent> Root;
+
+    UPROPERTY()
+    TObjectPtr<class UInstancedStaticMeshComponent> ElementInstances;
+
+    UPROPERTY()
+    TObjectPtr<class UInstancedStaticMeshComponent> WallInstances;
+
+    TArray<FLayoutLensGalleryRoom> Rooms;
+    FLayoutLensInstancePool ElementPool;
+    FLayoutLensInstancePool WallPool;
+
+    FTimerHandle StreamingTimerHandle;
+    uint32 Generation = 0;
+    int32 LoadsInFlight = 0;
+};
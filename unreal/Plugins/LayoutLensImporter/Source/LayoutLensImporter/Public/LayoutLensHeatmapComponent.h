@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/StaticMeshComponent.h"
+#include "LayoutLensHeatmapComponent.generated.h"
+
+/*
+ * Flat translucent plane that shows one colour per grid cell, drawn from a transient nearest-filtered texture.
+ * Colours are row-major with row 0 at the grid origin; alpha 0 leaves a cell clear.
+ */
+UCLASS(ClassGroup = (LayoutLens))
+class LAYOUTLENSIMPORTER_API ULayoutLensHeatmapComponent : public UStaticMeshComponent
+{
+    GENERATED_BODY()
+
+public:
+    ULayoutLensHeatmapComponent();
+
+    void SetCells(
+        int32 Width,
+        int32 Height,
+        const FVector2D& OriginCm,
+        float CellSizeCm,
+        const TArray<FColor>& Colors,
+        const FTransform& PlanToWorld);
+
+    void ClearCells();
+
+private:
+    UPROPERTY(Transient)
+    TObjectPtr<class UTexture2D> CellTexture;
+
+    UPROPERTY(Transient)
+    TObjectPtr<class UMaterialInstanceDynamic> CellMaterial;
+
+    UPROPERTY()
+    TObjectPtr<class UMaterialInterface> BaseMaterial;
+};
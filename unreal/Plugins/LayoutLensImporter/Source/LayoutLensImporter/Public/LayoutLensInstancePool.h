@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UInstancedStaticMeshComponent;
+
+// Hands out instance slots of one ISM and recycles released slots instead of removing them,
+// so slot indices held by other rooms never shift and the instance count stays at its high-water mark.
+class FLayoutLensInstancePool
+{
+public:
+    // World-space transforms are moved into the component's space on write, so they stay right whether the
+    // component uses absolute transforms or follows its actor.
+    void Initialize(UInstancedStaticMeshComponent* InComponent, bool bInWorldSpaceTransforms = false);
+    void Reset();
+
+    void Acquire(const TArray<FTransform>& Transforms, TArray<int32>& OutSlots);
+    void Release(TArray<int32>& InOutSlots);
+    void Update(int32 Slot, const FTransform& Transform);
+
+    int32 GetUsedCount() const;
+    int32 GetCapacity() const;
+
+private:
+    TWeakObjectPtr<UInstancedStaticMeshComponent> Component;
+    TArray<int32> FreeSlots;
+    bool bWorldSpaceTransforms = false;
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "LayoutLensMeshCatalog.generated.h"
+
+class UStaticMesh;
+
+UENUM()
+enum class ELayoutLensMeshFit : uint8
+{
+    // Scale each axis so the mesh bounds match the element box.
+    Stretch,
+    // Largest uniform scale that keeps the mesh inside the element box.
+    Uniform,
+    // Keep the mesh's own size.
+    None
+};
+
+USTRUCT(BlueprintType)
+struct FLayoutLensMeshCatalogEntry
+{
+    GENERATED_BODY()
+
+    // Element labels this mesh stands in for, matched case-insensitively ("bed", "double bed").
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    TArray<FString> Labels;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    TSoftObjectPtr<UStaticMesh> Mesh;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    ELayoutLensMeshFit Fit = ELayoutLensMeshFit::Stretch;
+
+    // Turns the mesh so its front faces the element's +X; multiples of 90 keep Stretch exact.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    float YawOffsetDeg = 0.0f;
+};
+
+/*
+ * Maps element labels to static meshes that replace the placeholder cubes. Meshes are soft references and
+ * are streamed in when a plan first uses them.
+ */
+UCLASS(BlueprintType)
+class LAYOUTLENSIMPORTER_API ULayoutLensMeshCatalog : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    const FLayoutLensMeshCatalogEntry* FindEntry(const FString& Label) const;
+
+    // Box-relative transform that centres the mesh bounds on the box and stands them on its bottom face.
+    static FTransform FitMeshToBox(const FLayoutLensMeshCatalogEntry& Entry, const UStaticMesh& Mesh, const FVector& BoxSizeCm);
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+public:
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    TArray<FLayoutLensMeshCatalogEntry> Entries;
+
+private:
+    // Lower-case label to entry index, built on first lookup.
+    mutable TMap<FString, int32> EntryIndexByLabel;
+    mutable bool bEntryIndexBuilt = false;
+};
@@ -12,8 +12,11 @@ class LAYOUTLENSIMPORTER_API ALayoutLensPlaceholderActor : public AActor
 public:
     ALayoutLensPlaceholderActor();
 
+    // Also puts the cube back if a catalogue mesh was showing.
     void SetBoxSizeCm(const FVector& BoxSizeCm);
-    void SetLabelText(const FString& Text);
+
+    // Shows Mesh at a box-relative transform in place of the cube.
+    void SetDisplayMesh(class UStaticMesh* Mesh, const FTransform& RelativeTransform);
 
 private:
     UPROPERTY()
@@ -23,5 +26,5 @@ private:
     TObjectPtr<class UStaticMeshComponent> BoxMesh;
 
     UPROPERTY()
-    TObjectPtr<class UTextRenderComponent> Label;
+    TObjectPtr<class UStaticMesh> CubeMesh;
 };
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "LayoutLensRoomPlanTypes.h"
+#include "LayoutLensPlanAsset.generated.h"
+
+// Derived from the plan alone, cached in the DDC by source hash and carried by cooked packages.
+struct FLayoutLensPlanDerivedData
+{
+    // Floor and ceiling triangulation, as indices into the plan boundary; empty when it has no area.
+    TArray<int32> BoundaryTriangles;
+    bool bBuilt = false;
+};
+
+UCLASS(BlueprintType)
+class LAYOUTLENSIMPORTER_API ULayoutLensPlanAsset : public UObject
+{
+    GENERATED_BODY()
+
+public:
+    bool InitializeFromJson(const FString& JsonText, FString& OutError);
+
+    const FLayoutLensRoomPlan& GetPlan() const { return *Plan; }
+
+    // Never changed in place; reimporting swaps in a new plan, so holders can keep this one without copying.
+    TSharedRef<const FLayoutLensRoomPlan> GetSharedPlan() const { return Plan; }
+    uint64 GetSourceHash() const { return SourceHash; }
+
+    // The cached slab triangulation when Boundary matches this asset's boundary (a patched plan may have
+    // replaced it), else nullptr. Fetched from the DDC or built on first use.
+    const TArray<int32>* FindBoundaryTriangles(const TArray<FLayoutLensPoint2D>& Boundary);
+
+    virtual void Serialize(FArchive& Ar) override;
+    virtual void PostLoad() override;
+
+#if WITH_EDITORONLY_DATA
+    UPROPERTY(VisibleAnywhere, Category = "LayoutLens")
+    FString SourceFilePath;
+#endif
+
+private:
+    void BuildDerivedData(FLayoutLensPlanDerivedData& OutDerivedData) const;
+    void CacheDerivedData();
+
+#if WITH_EDITOR
+    FString GetDerivedDataKey() const;
+#endif
+
+private:
+    UPROPERTY(VisibleAnywhere, Category = "LayoutLens")
+    int32 ElementCount = 0;
+
+    TSharedRef<const FLayoutLensRoomPlan> Plan = MakeShared<FLayoutLensRoomPlan>();
+    uint64 SourceHash = 0;
+
+    FLayoutLensPlanDerivedData DerivedData;
+};
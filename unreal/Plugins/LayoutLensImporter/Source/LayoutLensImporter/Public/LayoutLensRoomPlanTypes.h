@@ -62,4 +62,9 @@ struct FLayoutLensRoomPlan
     TArray<FLayoutLensPoint2D> Boundary;
     TArray<FLayoutLensOpening> Openings;
     TArray<FLayoutLensElement> Elements;
-};
\ No newline at end of file
+};
+
+LAYOUTLENSIMPORTER_API FArchive& operator<<(FArchive& Ar, FLayoutLensPoint2D& Point);
+LAYOUTLENSIMPORTER_API FArchive& operator<<(FArchive& Ar, FLayoutLensOpening& Opening);
+LAYOUTLENSIMPORTER_API FArchive& operator<<(FArchive& Ar, FLayoutLensElement& Element);
+LAYOUTLENSIMPORTER_API FArchive& operator<<(FArchive& Ar, FLayoutLensRoomPlan& Plan);
@@ -2,9 +2,98 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "LayoutLensInstancePool.h"
 #include "LayoutLensRoomPlanTypes.h"
 #include "LayoutLensVisualizerActor.generated.h"
 
+struct FLayoutLensBox;
+
+UENUM()
+enum class ELayoutLensRepresentation : uint8
+{
+    // One placeholder actor per element and wall.
+    Actors,
+    // Two instanced mesh components owned by the visualizer; per-element data lives in a side table.
+    Instanced,
+    // One Mass entity per element with distance LOD into the element instances; for 100k+ element plans. No labels.
+    Mass
+};
+
+UENUM()
+enum class ELayoutLensAnalysisOverlay : uint8
+{
+    None,
+    // Free and occupied floor cells.
+    Occupancy,
+    // Walking distance from the nearest door; cells no door reaches are magenta.
+    Egress,
+    // Distance from the nearest wall or element.
+    Clearance
+};
+
+enum class ELayoutLensRoomLod : uint8
+{
+    // Element and wall boxes plus labels.
+    Full,
+    // Walls and elements merged into one proxy mesh; no labels.
+    Proxy,
+    // Boundary and opening outlines only.
+    Outline
+};
+
+// Parts of the editor preview a property change invalidates; Plan rebuilds everything.
+enum class ELayoutLensPreviewStage : uint16
+{
+    None = 0,
+    Plan = 1 << 0,
+    Walls = 1 << 1,
+    Elements = 1 << 2,
+    Lines = 1 << 3,
+    // Also updates navigation obstacles and walkthrough collision.
+    Analysis = 1 << 4,
+    Heatmap = 1 << 5,
+    Material = 1 << 6,
+    Slabs = 1 << 7,
+    // Re-places only "wall" elements against the current wall thickness.
+    WallElements = 1 << 8,
+    // Navigation obstacles and walkthrough collision without the rest of the analysis.
+    Obstacles = 1 << 9,
+    All = 0xFFFF
+};
+ENUM_CLASS_FLAGS(ELayoutLensPreviewStage);
+
+struct FLayoutLensInstanceMetadata
+{
+    FString Id;
+    FString Label;
+};
+
+USTRUCT(BlueprintType)
+struct FLayoutLensPickResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "LayoutLens")
+    FString Id;
+
+    UPROPERTY(BlueprintReadOnly, Category = "LayoutLens")
+    FString Label;
+
+    UPROPERTY(BlueprintReadOnly, Category = "LayoutLens")
+    FString Placement;
+
+    // Width, depth and height.
+    UPROPERTY(BlueprintReadOnly, Category = "LayoutLens")
+    FVector SizeMeters = FVector::ZeroVector;
+
+    UPROPERTY(BlueprintReadOnly, Category = "LayoutLens")
+    FVector HitLocation = FVector::ZeroVector;
+
+    // Validation problems from the last RefreshAnalysis (unreachable, too little clearance); empty when none.
+    UPROPERTY(BlueprintReadOnly, Category = "LayoutLens")
+    TArray<FString> Issues;
+};
+
 UCLASS()
 class LAYOUTLENSIMPORTER_API ALayoutLensVisualizerActor : public AActor
 {
@@ -15,41 +104,320 @@ public:
 
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void Serialize(FArchive& Ar) override;
+    virtual void OnConstruction(const FTransform& Transform) override;
+    virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+    virtual void PostEditMove(bool bFinished) override;
+#endif
 
     UFUNCTION(BlueprintCallable)
     bool ReloadLayout();
 
+    // Swaps back to the layout before the last reload (KeepPreviousLayoutForUndo); calling it again redoes.
+    UFUNCTION(BlueprintCallable)
+    bool UndoReload();
+
+    // Saves the current plan into the level as instances, a merged mesh and a binary copy of the plan.
+    UFUNCTION(CallInEditor, Category = "LayoutLens|Bake")
+    void BakeLayout();
+
+    UFUNCTION(CallInEditor, Category = "LayoutLens|Bake")
+    void ClearBakedLayout();
+
+    // Pushes overlapping floor elements of the current plan, patches included, apart and back inside the room, writes the
+    // result to <plan>.resolved.json next to RoomPlanFilePath and points RoomPlanFilePath at it.
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "LayoutLens|Analysis")
+    void ResolveOverlaps();
+
+    UFUNCTION(BlueprintCallable)
+    bool BeginStreamingLayout();
+
+    UFUNCTION(BlueprintCallable)
+    void StopStreamingLayout();
+
+    UFUNCTION(BlueprintCallable)
+    bool ApplyPlanPatch(const FString& PatchJsonText);
+
+    UFUNCTION(BlueprintCallable)
+    bool ApplyPlanPatchFile(const FString& PatchFilePath);
+
     FString GetRoomPlanFilePath() const;
     void SetRoomPlanFilePath(const FString& NewPath);
 
+    // Used by ALayoutLensBuildingActor before the room actor begins play.
+    void InitializeAsBuildingRoom(const FString& PlanFilePath, ELayoutLensRepresentation InRepresentation);
+
+    // Instanced mode only: maps an ElementInstances index (e.g. from a hit result) back to its element.
+    const FLayoutLensInstanceMetadata* FindElementByInstance(int32 InstanceIndex) const;
+
+    // Rasterizes the current plan into the occupancy grid, rebuilds the picking tree and redraws the heatmap when it is shown.
+    UFUNCTION(BlueprintCallable, Category = "LayoutLens|Analysis")
+    void RefreshAnalysis();
+
+    // Patches and overlap resolves only mark the analysis stale; it is refreshed once on the next tick.
+    void MarkAnalysisDirty();
+    void RefreshAnalysisIfDirty();
+
+    // Occupied share of the room floor from the last RefreshAnalysis, 0..1.
+    UFUNCTION(BlueprintCallable, Category = "LayoutLens|Analysis")
+    float GetOccupancyCoverage() const;
+
+    // Floor elements no door can reach with EgressClearanceMeters of clearance, from the last RefreshAnalysis.
+    UFUNCTION(BlueprintCallable, Category = "LayoutLens|Analysis")
+    TArray<FString> GetUnreachableElementIds() const;
+
+    // Free gap in metres from the element's footprint to the nearest wall, and to the nearest wall or other element.
+    UFUNCTION(BlueprintCallable, Category = "LayoutLens|Analysis")
+    bool GetElementClearance(const FString& ElementId, float& OutWallDistanceMeters, float& OutClearanceMeters) const;
+
+    // Nearest element box hit by the world-space ray; no collision is involved.
+    UFUNCTION(BlueprintCallable, Category = "LayoutLens|Picking")
+    bool PickElement(const FVector& RayOrigin, const FVector& RayDirection, FLayoutLensPickResult& OutResult) const;
+
+    UFUNCTION(BlueprintCallable, Category = "LayoutLens|Picking")
+    bool PickElementUnderCursor(FLayoutLensPickResult& OutResult) const;
+
+    UFUNCTION(BlueprintCallable, Category = "LayoutLens|Picking")
+    bool GetHoveredElement(FLayoutLensPickResult& OutResult) const;
+
+    // Last element clicked with the left mouse button.
+    UFUNCTION(BlueprintCallable, Category = "LayoutLens|Picking")
+    bool GetSelectedElement(FLayoutLensPickResult& OutResult) const;
+
+    // Navmesh path between two plan points in metres, for walkthroughs; needs EnableNavigation and a navmesh
+    // around the room. False when no complete path exists.
+    UFUNCTION(BlueprintCallable, Category = "LayoutLens|Navigation")
+    bool FindWalkthroughPath(const FVector2D& FromPlanMeters, const FVector2D& ToPlanMeters, TArray<FVector>& OutPathPoints) const;
+
+    // One line per hovered and selected element for the overlay.
+    FString GetPickSummary() const;
+
 private:
-    bool LoadJsonTextFromFile(FString& OutJsonText, FString& OutError) const;
-    bool ParseRoomPlanJson(const FString& JsonText, FLayoutLensRoomPlan& OutPlan, FString& OutError) const;
+    // Shares the plan asset's or parse cache's plan; nothing is copied until EditCurrentPlan.
+    bool LoadPlan(TSharedPtr<const FLayoutLensRoomPlan>& OutPlan, uint64& OutPlanVersion) const;
+    void RestoreBakedLayout();
+    FLayoutLensRoomPlan& EditCurrentPlan();
+
+    FTransform GetPlanToWorld() const;
+    FVector ToWorldPoint(const FVector& PlanPointCm) const;
+    FLayoutLensBox ToWorldBox(const FLayoutLensBox& PlanBox) const;
 
+    void SpawnCurrentPlan();
+
+    // Editor worlds draw the plan with the instance components whatever the Representation.
+    bool IsEditorPreview() const;
+    void UpdateEditorPreview();
+    // With UseActorTransform the plan components follow the actor, so moving it moves them without a rebuild.
+    void UpdateComponentSpace();
     void ClearSpawnedActors();
+    void ClearWallActors();
+
+    class ALayoutLensPlaceholderActor* AcquirePlaceholder(const FLayoutLensBox& Box);
+    void RetirePlaceholder(AActor* Actor);
+    void DrainRetiredPlaceholders();
+    void RedrawDebugLines(const FLayoutLensRoomPlan& Plan);
     void SpawnRoomOutline(const FLayoutLensRoomPlan& Plan);
     void SpawnOpenings(const FLayoutLensRoomPlan& Plan);
     void SpawnFloorElements(const FLayoutLensRoomPlan& Plan);
     void SpawnWallMeshes(const FLayoutLensRoomPlan& Plan);
+    void UpdateSlabs();
+
+    void SpawnOrUpdateElementActor(const FLayoutLensElement& Element);
+    void SpawnOrUpdateElementInstance(const FLayoutLensElement& Element, const FLayoutLensBox& Box);
+    void SetElementInstanceMetadata(int32 InstanceIndex, const FLayoutLensElement& Element);
+    void WriteElementCustomData(int32 InstanceIndex, const FLayoutLensElement& Element, int32 Severity);
+    float GetSelectionCustomData(const FString& ElementId) const;
+    void UpdateInstanceCustomData();
+    void UpdateSelectionCustomData(const FString& ElementId);
+    void UpdateElementLabel(const FLayoutLensElement& Element, const FLayoutLensBox& Box);
+
+    // The cube transform, or a hidden one when the element's catalogue mesh took its place.
+    FTransform MakeElementInstanceTransform(const FLayoutLensElement& Element, const FLayoutLensBox& Box);
+    void InitializeMeshSubstitution();
+    class UInstancedStaticMeshComponent* CreateCatalogMeshInstances(class UStaticMesh* Mesh, bool bGenerated);
+    void HandleCatalogMeshReady(const FString& ElementId);
+
+    void RebuildPlacementIndex();
+    // Moves the given elements' footprints in the placement index and re-places the other "on" elements standing on
+    // them; the caller places the given elements themselves.
+    void UpdatePlacement(const TArray<FString>& ChangedIds, const TArray<FString>& RemovedIds);
+    FLayoutLensBox MakeElementBox(const FLayoutLensElement& Element) const;
+    // Re-places "on" and "wall" elements after their supports or walls changed.
+    void UpdateAttachedElements();
+    void UpdateWallElements();
+    // Only "on" elements whose centre lies in one of the bounds, except SkippedIds, which the caller places itself.
+    void UpdateAttachedElements(const TArray<FBox2D>& ChangedSupportBounds, const TSet<FString>& SkippedIds);
+    void UpdateMassLod();
+
+    void MarkRoomLodDirty();
+    void UpdateRoomLod();
+    void ApplyRoomLod();
+    void RebuildProxyMesh();
+    void UpdateHeatmap();
+    void RebuildPicker();
+    // Re-registers only the navigation cells whose wall and element boxes changed since the last call.
+    void UpdateNavObstacles();
+    void ClearNavObstacles();
+    // Rebuilds the room's single collision body on a worker and swaps it in when it differs from the current one.
+    void UpdateWalkthroughCollision();
+    void ClearWalkthroughCollision();
+    FLayoutLensPickResult MakePickResult(int32 ElementIndex, const FVector& HitLocation) const;
+    // Severity 0 (none), 1 (below the pipeline's margins) or 2 (touching, crossing a wall, unreachable).
+    int32 CollectElementIssues(int32 ElementIndex, bool bUnreachable, TArray<FString>* OutIssues) const;
+    void UpdateHoveredElement();
+    void DestroyElementActor(const FString& ElementId);
+
+    void PollStreamingFile();
+    void ResetStreamingState();
+    // False when the bytes already consumed no longer match the file, i.e. it was rewritten for a new run.
+    bool IsStreamedPrefixUnchanged(class IFileHandle& FileHandle) const;
 
     FString GetAbsoluteFilePath(const FString& AnyPath) const;
 
     void ReloadLayoutHotkey();
+    void SelectElementHotkey();
     void BindReloadHotkey();
 
 private:
+    UPROPERTY()
+    TObjectPtr<USceneComponent> Root;
+
+    UPROPERTY()
+    TObjectPtr<class UInstancedStaticMeshComponent> ElementInstances;
+
+    UPROPERTY()
+    TObjectPtr<class UInstancedStaticMeshComponent> WallInstances;
+
+    UPROPERTY()
+    TObjectPtr<class ULineBatchComponent> PlanLines;
+
+    UPROPERTY()
+    TObjectPtr<class UStaticMeshComponent> ProxyMesh;
+
+    UPROPERTY()
+    TObjectPtr<class ULayoutLensHeatmapComponent> Heatmap;
+
+    UPROPERTY()
+    TObjectPtr<class UStaticMeshComponent> Slabs;
+
+    UPROPERTY()
+    TObjectPtr<class ULayoutLensCollisionComponent> WalkthroughCollision;
+
+    // Kept across clears so a reload with the same boundary shows it again without triangulating.
+    UPROPERTY(Transient)
+    TObjectPtr<class UStaticMesh> SlabMesh;
+    uint64 SlabMeshKey = 0;
+
+    // One per catalogue or generated mesh in use, created on demand.
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<class UInstancedStaticMeshComponent>> CatalogMeshInstances;
+
+    // The Mass representation's own instances; ElementPool and ElementInstances stay with the instanced path.
+    UPROPERTY(Transient)
+    TObjectPtr<class UInstancedStaticMeshComponent> MassInstances;
+
+    // Kept across reloads so the new plan is diffed against the old one cell by cell.
+    UPROPERTY(Transient)
+    TMap<FIntPoint, TObjectPtr<class ULayoutLensNavObstacleComponent>> NavObstacleCells;
+
     UPROPERTY(EditAnywhere, Category = "LayoutLens")
     FString RoomPlanFilePath;
 
+    // Place the plan relative to this actor instead of at the world origin (yaw and translation only).
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    bool UseActorTransform = false;
+
+    // When set, the plan comes from this asset and RoomPlanFilePath is ignored.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    TObjectPtr<class ULayoutLensPlanAsset> PlanAsset;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    ELayoutLensRepresentation Representation = ELayoutLensRepresentation::Actors;
+
+    // Instanced only: one shared material for every element box. It can read PerInstanceCustomData
+    // 0 placement (0 floor, 1 on, 2 wall), 1 footprint (0 rect, 1 poly), 2 issue severity (0 none, 1 warning, 2 error)
+    // and 3 selection (0 none, 1 hovered, 2 selected).
+    UPROPERTY(EditAnywhere, Category = "LayoutLens", meta = (EditCondition = "Representation == ELayoutLensRepresentation::Instanced"))
+    TObjectPtr<class UMaterialInterface> ElementMaterial;
+
+    // Real meshes for element labels, streamed in on first use; elements keep their box until theirs arrives.
+    // Actors and Instanced only, Mass keeps boxes.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    TObjectPtr<class ULayoutLensMeshCatalog> MeshCatalog;
+
+    // Labels without a catalogue mesh that read as a table, desk, shelf, rack, bed or seat get a generated mesh
+    // (legs, boards, headboard). One mesh is built per kind and size rounded to FurnitureMeshStepCm and shared
+    // by instancing; ElementMaterial applies to it.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    bool GenerateFurnitureMeshes = true;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens", meta = (ClampMin = "1.0", EditCondition = "GenerateFurnitureMeshes"))
+    float FurnitureMeshStepCm = 10.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Mass", meta = (ClampMin = "0.0", EditCondition = "Representation == ELayoutLensRepresentation::Mass"))
+    float MassFullDetailDistanceMeters = 30.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Mass", meta = (ClampMin = "0.0", EditCondition = "Representation == ELayoutLensRepresentation::Mass"))
+    float MassCullDistanceMeters = 150.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Mass", meta = (ClampMin = "0.01", EditCondition = "Representation == ELayoutLensRepresentation::Mass"))
+    float MassLodUpdateIntervalSeconds = 0.1f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Mass", meta = (ClampMin = "1", EditCondition = "Representation == ELayoutLensRepresentation::Mass"))
+    int32 MassMaxLodChangesPerUpdate = 20000;
+
     UPROPERTY(EditAnywhere, Category = "LayoutLens")
     bool SpawnWalls = true;
 
     UPROPERTY(EditAnywhere, Category = "LayoutLens")
     float WallThicknessCm = 10.0f;
 
+    // Floor and ceiling triangulated from the boundary, with UVs in metres. They are rebuilt only when the
+    // boundary or room height changes.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    bool SpawnFloor = true;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    bool SpawnCeiling = true;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens", meta = (EditCondition = "SpawnFloor"))
+    TObjectPtr<class UMaterialInterface> FloorMaterial;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens", meta = (EditCondition = "SpawnCeiling"))
+    TObjectPtr<class UMaterialInterface> CeilingMaterial;
+
     UPROPERTY(EditAnywhere, Category = "LayoutLens")
     bool AutoLoadOnBeginPlay = true;
 
+    // Draw the plan in the editor viewport. Property edits rebuild only what they affect; analysis waits for a slider to be released.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Editor")
+    bool PreviewInEditor = true;
+
+    // Game thread time per frame spent destroying placeholder actors of cleared layouts; they are hidden at once
+    // and reused by the next layout first.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Teardown", meta = (ClampMin = "0.1"))
+    float TeardownBudgetMs = 2.0f;
+
+    // Keep the previous plan and enough hidden placeholders to rebuild it, so UndoReload spawns nothing.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Teardown")
+    bool KeepPreviousLayoutForUndo = false;
+
+    UPROPERTY(VisibleAnywhere, Category = "LayoutLens|Bake")
+    bool LayoutBaked = false;
+
+    // Start from the baked instances instead of loading and spawning the plan.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Bake", meta = (EditCondition = "LayoutBaked"))
+    bool SkipRuntimeLoadWhenBaked = true;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens")
+    bool StreamRoomPlanFile = false;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens", meta = (ClampMin = "0.01", EditCondition = "StreamRoomPlanFile"))
+    float StreamPollIntervalSeconds = 0.1f;
+
     UPROPERTY(EditAnywhere, Category = "LayoutLens")
     bool ShowOverlay = true;
 
@@ -62,9 +430,151 @@ private:
     UPROPERTY(EditAnywhere, Category = "LayoutLens")
     bool SpawnLabels = true;
 
+    UPROPERTY(EditAnywhere, Category = "LayoutLens", meta = (ClampMin = "0.0", EditCondition = "SpawnLabels"))
+    float LabelFadeStartMeters = 15.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens", meta = (ClampMin = "0.0", EditCondition = "SpawnLabels"))
+    float LabelMaxDistanceMeters = 25.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens", meta = (ClampMin = "0", EditCondition = "SpawnLabels"))
+    int32 MaxVisibleLabels = 200;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|LOD")
+    bool EnableLod = true;
+
+    // Beyond this distance from the room bounds, boxes collapse into one merged proxy mesh.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|LOD", meta = (ClampMin = "0.0", EditCondition = "EnableLod"))
+    float ProxyDistanceMeters = 40.0f;
+
+    // Beyond this distance only the boundary and opening outlines are drawn.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|LOD", meta = (ClampMin = "0.0", EditCondition = "EnableLod"))
+    float OutlineOnlyDistanceMeters = 120.0f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|LOD", meta = (ClampMin = "0.05", EditCondition = "EnableLod"))
+    float LodUpdateIntervalSeconds = 0.25f;
+
+    // Colour overlay drawn over the floor after every load and patch.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Analysis")
+    ELayoutLensAnalysisOverlay AnalysisOverlay = ELayoutLensAnalysisOverlay::None;
+
+    // Cell size of the occupancy grid; 0.25 m matches the Python ROOM_GRID_SIZE.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Analysis", meta = (ClampMin = "0.02"))
+    float OccupancyCellSizeMeters = 0.25f;
+
+    // Minimum distance a walker's centre keeps from walls and elements (half the passage width).
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Analysis", meta = (ClampMin = "0.0"))
+    float EgressClearanceMeters = 0.3f;
+
+    // Hover and left-click picking against the element boxes; needs the mouse cursor shown.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Picking")
+    bool EnablePicking = true;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Picking", meta = (ClampMin = "0.01", EditCondition = "EnablePicking"))
+    float HoverPickIntervalSeconds = 0.05f;
+
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Picking", meta = (ClampMin = "0.0", EditCondition = "EnablePicking"))
+    float PickMaxDistanceMeters = 200.0f;
+
+    // Register walls (with door gaps) and floor element footprints as navmesh obstacles. Pair it with a navmesh
+    // whose Runtime Generation is Dynamic or Dynamic Modifiers Only; reloads and patches then rebuild just the
+    // tiles under the cells that changed.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Navigation")
+    bool EnableNavigation = false;
+
+    // Obstacles are grouped into cells of this size; a multiple of the navmesh tile size (10 m by default) keeps
+    // a change in one cell from dirtying tiles under its neighbours.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Navigation", meta = (ClampMin = "1.0", EditCondition = "EnableNavigation"))
+    float NavObstacleCellMeters = 10.0f;
+
+    // Block the player against walls (open at doors) and floor elements with one collision body for the room,
+    // independent of Representation. Placeholders and instances keep NoCollision.
+    UPROPERTY(EditAnywhere, Category = "LayoutLens|Collision")
+    bool EnableWalkthroughCollision = false;
+
     UPROPERTY()
     TArray<TObjectPtr<AActor>> SpawnedActors;
 
+    UPROPERTY()
+    TMap<FString, TObjectPtr<class ALayoutLensPlaceholderActor>> ElementActorsById;
+
+    // Hidden placeholders waiting to be reused or destroyed under TeardownBudgetMs.
+    UPROPERTY()
+    TArray<TObjectPtr<class ALayoutLensPlaceholderActor>> RetiredPlaceholders;
+
+    // Retired placeholders kept back from destruction for UndoReload.
+    int32 ColdPlaceholderCount = 0;
+    FTimerHandle TeardownTimerHandle;
+
+    FLayoutLensInstancePool ElementPool;
+    FLayoutLensInstancePool WallPool;
+    TMap<FString, int32> ElementInstanceById;
+    TArray<FLayoutLensInstanceMetadata> ElementMetadataByInstance;
+    TArray<int32> WallInstanceSlots;
+
+    TSharedPtr<class FLayoutLensMeshSubstitution> MeshSubstitution;
+
+    TSharedPtr<class FLayoutLensMassRepresentation> MassRepresentation;
+    FTimerHandle MassLodTimerHandle;
+
+    ELayoutLensRoomLod CurrentRoomLod = ELayoutLensRoomLod::Full;
+    FBox2D RoomBoundsCm = FBox2D(ForceInit);
+    bool bRoomBoundsDirty = true;
+    bool bProxyMeshDirty = true;
+    FTimerHandle LodTimerHandle;
+
+    TSharedPtr<class FLayoutLensPlacementIndex> PlacementIndex;
+
+    TSharedPtr<class FLayoutLensOccupancyGrid> OccupancyGrid;
+    TSharedPtr<class FLayoutLensWalkabilityField> WalkabilityField;
+    TSharedPtr<class FLayoutLensDistanceField> DistanceField;
+
+    TSharedPtr<class FLayoutLensElementPicker> Picker;
+
+    // Set between a patch and the next-tick refresh; element indices in the fields above may be stale.
+    bool bAnalysisDirty = false;
+    FTimerHandle AnalysisTimerHandle;
+
+    // Bumped per request so a slower, older worker build never replaces a newer body.
+    uint32 WalkthroughCollisionGeneration = 0;
+    uint64 WalkthroughCollisionKey = 0;
+    FTimerHandle HoverTimerHandle;
+    FLayoutLensPickResult HoveredElement;
+    FLayoutLensPickResult SelectedElement;
+
+    TSharedRef<const FLayoutLensRoomPlan> BakedPlan = MakeShared<FLayoutLensRoomPlan>();
+    uint64 BakedPlanVersion = 0;
+    // Element id of each baked ElementInstances instance, in instance order.
+    TArray<FString> BakedElementIds;
+
+    ELayoutLensPreviewStage PendingPreviewStages = ELayoutLensPreviewStage::All;
+    bool bPreviewInteractive = false;
+    FTransform LastPreviewTransform;
+
+    TSharedRef<const FLayoutLensRoomPlan> PreviousPlan = MakeShared<FLayoutLensRoomPlan>();
+    uint64 PreviousPlanVersion = 0;
+    bool bHasPreviousPlan = false;
+
+    // Shared with the parse cache, the plan asset, the bake and the undo slot; patches copy it on first write.
+    TSharedRef<const FLayoutLensRoomPlan> CurrentPlan = MakeShared<FLayoutLensRoomPlan>();
+    TMap<FString, int32> ElementIndexById;
+    uint64 CurrentPlanVersion = 0;
+    int64 LastPatchSequence = 0;
+    bool bHasCurrentPlan = false;
+
+    TSharedPtr<class FLayoutLensStreamingRoomPlanParser> StreamingParser;
+    FTimerHandle StreamingTimerHandle;
+    int64 StreamingReadOffset = 0;
+    uint64 StreamingHash = 0;
+    TArray<uint8> StreamingPendingBytes;
+    // First and last few KB consumed, and the file's timestamp at the last read, to spot a rewrite that keeps or grows the size.
+    TArray<uint8> StreamingHeadBytes;
+    TArray<uint8> StreamingTailBytes;
+    FDateTime StreamingFileTimestamp;
+    bool bStreamingSpaceBuilt = false;
+
     TSharedPtr<class SWidget> OverlayWidget;
     TSharedPtr<class SWeakWidget> OverlayContainer;
+
+    TSharedPtr<class SLayoutLensLabelLayer> LabelLayer;
+    TSharedPtr<class SWeakWidget> LabelLayerContainer;
 };
\ No newline at end of file
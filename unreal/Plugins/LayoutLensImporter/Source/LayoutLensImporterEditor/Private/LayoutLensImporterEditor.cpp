@@ -0,0 +1,17 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "LayoutLensImporterEditor.h"
+
+#define LOCTEXT_NAMESPACE "FLayoutLensImporterEditorModule"
+
+void FLayoutLensImporterEditorModule::StartupModule()
+{
+}
+
+void FLayoutLensImporterEditorModule::ShutdownModule()
+{
+}
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FLayoutLensImporterEditorModule, LayoutLensImporterEditor)
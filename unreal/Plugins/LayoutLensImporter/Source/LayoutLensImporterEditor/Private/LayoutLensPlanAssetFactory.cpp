@@ -0,0 +1,107 @@
+#include "LayoutLensPlanAssetFactory.h"
+
+#include "LayoutLensPlanAsset.h"
+
+#include "Editor.h"
+#include "Misc/FileHelper.h"
+#include "Subsystems/ImportSubsystem.h"
+
+ULayoutLensPlanAssetFactory::ULayoutLensPlanAssetFactory()
+{
+    SupportedClass = ULayoutLensPlanAsset::StaticClass();
+    bCreateNew = false;
+    bEditorImport = true;
+    bText = true;
+
+    Formats.Add(TEXT("json;LayoutLens Room Plan"));
+}
+
+bool ULayoutLensPlanAssetFactory::FactoryCanImport(const FString& Filename)
+{
+    // Plenty of unrelated .json files exist in a project; only claim the ones shaped like a room plan.
+    FString JsonText;
+    if (!FFileHelper::LoadFileToString(JsonText, *Filename))
+    {
+        return false;
+    }
+
+    return JsonText.Contains(TEXT("\"space\"")) && JsonText.Contains(TEXT("\"elements\""));
+}
+
+UObject* ULayoutLensPlanAssetFactory::FactoryCreateText(
+    UClass* InClass,
+    UObject* InParent,
+    FName InName,
+    EObjectFlags Flags,
+    UObject* Context,
+    const TCHAR* Type,
+    const TCHAR*& Buffer,
+    const TCHAR* BufferEnd,
+    FFeedbackContext* Warn)
+{
+    GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPreImport(this, InClass, InParent, InName, Type);
+
+    const FString JsonText(UE_PTRDIFF_TO_INT32(BufferEnd - Buffer), Buffer);
+
+    ULayoutLensPlanAsset* PlanAsset = NewObject<ULayoutLensPlanAsset>(InParent, InClass, InName, Flags);
+
+    FString ErrorText;
+    if (!PlanAsset->InitializeFromJson(JsonText, ErrorText))
+    {
+        Warn->Logf(ELogVerbosity::Error, TEXT("LayoutLens: Failed to import %s. %s"), *GetCurrentFilename(), *ErrorText);
+        GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, nullptr);
+        return nullptr;
+    }
+
+    PlanAsset->SourceFilePath = GetCurrentFilename();
+
+    GEditor->GetEditorSubsystem<UImportSubsystem>()->BroadcastAssetPostImport(this, PlanAsset);
+    return PlanAsset;
+}
+
+bool ULayoutLensPlanAssetFactory::CanReimport(UObject* Obj, TArray<FString>& OutFilenames)
+{
+    const ULayoutLensPlanAsset* PlanAsset = Cast<ULayoutLensPlanAsset>(Obj);
+    if (PlanAsset == nullptr)
+    {
+        return false;
+    }
+
+    OutFilenames.Add(PlanAsset->SourceFilePath);
+    return true;
+}
+
+void ULayoutLensPlanAssetFactory::SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths)
+{
+    ULayoutLensPlanAsset* PlanAsset = Cast<ULayoutLensPlanAsset>(Obj);
+    if (PlanAsset != nullptr && NewReimportPaths.Num() == 1)
+    {
+        PlanAsset->SourceFilePath = NewReimportPaths[0];
+    }
+}
+
+EReimportResult::Type ULayoutLensPlanAssetFactory::Reimport(UObject* Obj)
+{
+    ULayoutLensPlanAsset* PlanAsset = Cast<ULayoutLensPlanAsset>(Obj);
+    if (PlanAsset == nullptr)
+    {
+        return EReimportResult::Failed;
+    }
+
+    FString JsonText;
+    if (!FFileHelper::LoadFileToString(JsonText, *PlanAsset->SourceFilePath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to reimport, file not found: %s"), *PlanAsset->SourceFilePath);
+        return EReimportResult::Failed;
+    }
+
+    FString ErrorText;
+    if (!PlanAsset->InitializeFromJson(JsonText, ErrorText))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LayoutLens: Failed to reimport %s. %s"), *PlanAsset->SourceFilePath, *ErrorText);
+        return EReimportResult::Failed;
+    }
+
+    PlanAsset->MarkPackageDirty();
+    return EReimportResult::Succeeded;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EditorReimportHandler.h"
+#include "Factories/Factory.h"
+#include "LayoutLensPlanAssetFactory.generated.h"
+
+UCLASS()
+class ULayoutLensPlanAssetFactory : public UFactory, public FReimportHandler
+{
+    GENERATED_BODY()
+
+public:
+    ULayoutLensPlanAssetFactory();
+
+    virtual bool FactoryCanImport(const FString& Filename) override;
+    virtual UObject* FactoryCreateText(
+        UClass* InClass,
+        UObject* InParent,
+        FName InName,
+        EObjectFlags Flags,
+        UObject* Context,
+        const TCHAR* Type,
+        const TCHAR*& Buffer,
+        const TCHAR* BufferEnd,
+        FFeedbackContext* Warn) override;
+
+    virtual bool CanReimport(UObject* Obj, TArray<FString>& OutFilenames) override;
+    virtual void SetReimportPaths(UObject* Obj, const TArray<FString>& NewReimportPaths) override;
+    virtual EReimportResult::Type Reimport(UObject* Obj) override;
+};